@@ -26,6 +26,7 @@ class PrimitiveArray;
 class Script;
 
 namespace internal {
+class BackgroundCompileBatch;
 class BackgroundDeserializeTask;
 struct ScriptStreamingData;
 }  // namespace internal
@@ -553,6 +554,36 @@ class V8_EXPORT ScriptCompiler {
     std::unique_ptr<internal::BackgroundDeserializeTask> impl_;
   };
 
+  /**
+   * A batch of ES modules which V8 streams and compiles in parallel on the
+   * platform's worker threads. Returned by
+   * ScriptCompiler::StartStreamingModules.
+   */
+  class V8_EXPORT ModuleStreamingBatch final {
+   public:
+    /**
+     * Cancels the streaming of the modules which did not start yet. These
+     * modules must not be compiled afterwards.
+     */
+    ~ModuleStreamingBatch();
+
+    /**
+     * Streams the modules which no worker thread picked up yet on the calling
+     * thread, and waits for the others. Afterwards, each module can be
+     * compiled with ScriptCompiler::CompileModule. Must be called on the
+     * thread on which the Isolate is entered.
+     */
+    void Join();
+
+   private:
+    friend class ScriptCompiler;
+
+    explicit ModuleStreamingBatch(
+        std::unique_ptr<internal::BackgroundCompileBatch> impl);
+
+    std::unique_ptr<internal::BackgroundCompileBatch> impl_;
+  };
+
   enum CompileOptions {
     kNoCompileOptions = 0,
     kConsumeCodeCache,
@@ -631,6 +662,20 @@ class V8_EXPORT ScriptCompiler {
       ScriptType type = ScriptType::kClassic,
       CompileOptions options = kNoCompileOptions);
 
+  /**
+   * Starts streaming all of the given ES module sources, e.g. the modules of
+   * a module graph whose imports the embedder already resolved, instead of
+   * one ScriptStreamingTask per module. Each source is parsed and compiled by
+   * its own task, and V8 runs these tasks in parallel on the platform's
+   * worker threads. The embedder is responsible for deleting the returned
+   * batch, and has to keep the StreamedSources alive until then. Since worker
+   * threads run the tasks, the sources' ExternalSourceStreams should not
+   * block for a long time. Returns NULL if the modules cannot be streamed.
+   */
+  static ModuleStreamingBatch* StartStreamingModules(
+      Isolate* isolate, const std::vector<StreamedSource*>& sources,
+      CompileOptions options = kNoCompileOptions);
+
   static ConsumeCodeCacheTask* StartConsumingCodeCache(
       Isolate* isolate, std::unique_ptr<CachedData> source);
 
@@ -47,6 +47,15 @@ class V8_EXPORT CompiledWasmModule {
    */
   OwnedBuffer Serialize();
 
+  /**
+   * Serialize the tiering decisions and call target feedback collected so far
+   * for this module. Passing the result to
+   * WasmModuleObject::ImportTieringFeedback in a later run lets the functions
+   * which were hot in this run get optimized right away. The buffer is empty
+   * if no function got hot yet.
+   */
+  OwnedBuffer SerializeTieringFeedback();
+
   /**
    * Get the (wasm-encoded) wire bytes that were used to compile this module.
    */
@@ -110,6 +119,16 @@ class V8_EXPORT WasmModuleObject : public Object {
   static MaybeLocal<WasmModuleObject> Compile(
       Isolate* isolate, MemorySpan<const uint8_t> wire_bytes);
 
+  /**
+   * Import tiering feedback created by
+   * CompiledWasmModule::SerializeTieringFeedback. Modules with the same wire
+   * bytes which are compiled afterwards use it. Streaming compilation does not
+   * use imported feedback. Returns false if the feedback is invalid, or was
+   * created by a different V8 version or with different flags.
+   */
+  static bool ImportTieringFeedback(Isolate* isolate,
+                                    MemorySpan<const uint8_t> feedback);
+
   V8_INLINE static WasmModuleObject* Cast(Value* value) {
 #ifdef V8_ENABLE_CHECKS
     CheckCast(value);
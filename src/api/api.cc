@@ -136,6 +136,7 @@
 #include "src/wasm/wasm-objects-inl.h"
 #include "src/wasm/wasm-result.h"
 #include "src/wasm/wasm-serialization.h"
+#include "src/wasm/wasm-tiering-feedback.h"
 #endif  // V8_ENABLE_WEBASSEMBLY
 
 #if V8_OS_LINUX || V8_OS_DARWIN || V8_OS_FREEBSD
@@ -2745,6 +2746,37 @@ ScriptCompiler::ScriptStreamingTask* ScriptCompiler::StartStreaming(
   return new ScriptCompiler::ScriptStreamingTask(data);
 }
 
+ScriptCompiler::ModuleStreamingBatch::ModuleStreamingBatch(
+    std::unique_ptr<i::BackgroundCompileBatch> impl)
+    : impl_(std::move(impl)) {}
+
+ScriptCompiler::ModuleStreamingBatch::~ModuleStreamingBatch() = default;
+
+void ScriptCompiler::ModuleStreamingBatch::Join() { impl_->Join(); }
+
+ScriptCompiler::ModuleStreamingBatch* ScriptCompiler::StartStreamingModules(
+    Isolate* v8_isolate, const std::vector<StreamedSource*>& sources,
+    CompileOptions options) {
+  Utils::ApiCheck(options == kNoCompileOptions || options == kEagerCompile,
+                  "v8::ScriptCompiler::StartStreamingModules",
+                  "Invalid CompileOptions");
+  if (!i::FLAG_script_streaming) return nullptr;
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(v8_isolate);
+  std::vector<i::ScriptStreamingData*> scripts;
+  scripts.reserve(sources.size());
+  for (StreamedSource* source : sources) {
+    i::ScriptStreamingData* data = source->impl();
+    // Each source can only be streamed once.
+    CHECK(!data->task);
+    data->task = std::make_unique<i::BackgroundCompileTask>(
+        data, i_isolate, ScriptType::kModule, options);
+    scripts.push_back(data);
+  }
+  return new ScriptCompiler::ModuleStreamingBatch(
+      std::make_unique<i::BackgroundCompileBatch>(i_isolate,
+                                                  std::move(scripts)));
+}
+
 ScriptCompiler::ConsumeCodeCacheTask::ConsumeCodeCacheTask(
     std::unique_ptr<i::BackgroundDeserializeTask> impl)
     : impl_(std::move(impl)) {}
@@ -7824,6 +7856,18 @@ OwnedBuffer CompiledWasmModule::Serialize() {
 #endif  // V8_ENABLE_WEBASSEMBLY
 }
 
+OwnedBuffer CompiledWasmModule::SerializeTieringFeedback() {
+#if V8_ENABLE_WEBASSEMBLY
+  TRACE_EVENT0("v8.wasm", "wasm.SerializeTieringFeedback");
+  base::OwnedVector<uint8_t> feedback =
+      i::wasm::WasmTieringFeedback::Export(native_module_.get());
+  size_t size = feedback.size();
+  return {feedback.ReleaseData(), size};
+#else
+  UNREACHABLE();
+#endif  // V8_ENABLE_WEBASSEMBLY
+}
+
 MemorySpan<const uint8_t> CompiledWasmModule::GetWireBytesRef() {
 #if V8_ENABLE_WEBASSEMBLY
   base::Vector<const uint8_t> bytes_vec = native_module_->wire_bytes();
@@ -7904,6 +7948,18 @@ MaybeLocal<WasmModuleObject> WasmModuleObject::Compile(
 #endif  // V8_ENABLE_WEBASSEMBLY
 }
 
+bool WasmModuleObject::ImportTieringFeedback(
+    Isolate* v8_isolate, MemorySpan<const uint8_t> feedback) {
+#if V8_ENABLE_WEBASSEMBLY
+  return i::wasm::GetWasmEngine()->ImportTieringFeedback(
+      {feedback.data(), feedback.size()});
+#else
+  Utils::ApiCheck(false, "WasmModuleObject::ImportTieringFeedback",
+                  "WebAssembly support is not enabled.");
+  UNREACHABLE();
+#endif  // V8_ENABLE_WEBASSEMBLY
+}
+
 void* v8::ArrayBuffer::Allocator::Reallocate(void* data, size_t old_length,
                                              size_t new_length) {
   if (old_length == new_length) return data;
@@ -8921,6 +8977,7 @@ void Isolate::GetHeapStatistics(HeapStatistics* heap_statistics) {
   // now we just add the values, thereby over-approximating the peak slightly.
   heap_statistics->malloced_memory_ =
       i_isolate->allocator()->GetCurrentMemoryUsage() +
+      i_isolate->allocator()->GetPooledMemoryUsage() +
       i_isolate->string_table()->GetCurrentMemoryUsage();
   // On 32-bit systems backing_store_bytes() might overflow size_t temporarily
   // due to concurrent array buffer sweeping.
@@ -34,6 +34,25 @@
 namespace v8 {
 namespace internal {
 
+// These nodes are allocated in large numbers for big scripts. Their fields are
+// packed without padding; keep it that way.
+static_assert(sizeof(ForOfStatement) == sizeof(ForInStatement));
+static_assert(sizeof(TryCatchStatement) ==
+              sizeof(TryStatement) + 2 * kSystemPointerSize);
+static_assert(sizeof(CallRuntime) == sizeof(Expression) + kSystemPointerSize +
+                                         sizeof(ZonePtrList<Expression>));
+static_assert(sizeof(ObjectLiteralBoilerplateBuilder) ==
+              2 * kInt32Size + 2 * kSystemPointerSize);
+static_assert(sizeof(ArrayLiteralBoilerplateBuilder) ==
+              2 * kInt32Size + 2 * kSystemPointerSize);
+static_assert(sizeof(ObjectLiteral) ==
+              sizeof(AggregateLiteral) +
+                  sizeof(ZoneList<ObjectLiteral::Property*>) +
+                  kSystemPointerSize + sizeof(ObjectLiteralBoilerplateBuilder));
+static_assert(sizeof(ArrayLiteral) ==
+              sizeof(AggregateLiteral) + sizeof(ZonePtrList<Expression>) +
+                  sizeof(ArrayLiteralBoilerplateBuilder));
+
 // ----------------------------------------------------------------------------
 // Implementation of other node functionality.
 
@@ -557,16 +557,18 @@ class ForInStatement final : public ForEachStatement {
 enum class IteratorType { kNormal, kAsync };
 class ForOfStatement final : public ForEachStatement {
  public:
-  IteratorType type() const { return type_; }
+  IteratorType type() const { return TypeField::decode(bit_field_); }
 
  private:
   friend class AstNodeFactory;
   friend Zone;
 
   ForOfStatement(int pos, IteratorType type)
-      : ForEachStatement(pos, kForOfStatement), type_(type) {}
+      : ForEachStatement(pos, kForOfStatement) {
+    bit_field_ |= TypeField::encode(type);
+  }
 
-  IteratorType type_;
+  using TypeField = ForEachStatement::NextBitField<IteratorType, 1>;
 };
 
 class ExpressionStatement final : public Statement {
@@ -792,10 +794,10 @@ class TryCatchStatement final : public TryStatement {
   // ---------------------------------------------------------------------------
   inline HandlerTable::CatchPrediction GetCatchPrediction(
       HandlerTable::CatchPrediction outer_catch_prediction) const {
-    if (catch_prediction_ == HandlerTable::UNCAUGHT) {
+    if (catch_prediction() == HandlerTable::UNCAUGHT) {
       return outer_catch_prediction;
     }
-    return catch_prediction_;
+    return catch_prediction();
   }
 
   // Indicates whether or not code should be generated to clear the pending
@@ -822,17 +824,17 @@ class TryCatchStatement final : public TryStatement {
   // the exception so it can be re-used later by the inspector.
   inline bool ShouldClearPendingException(
       HandlerTable::CatchPrediction outer_catch_prediction) const {
-    if (catch_prediction_ == HandlerTable::UNCAUGHT_ASYNC_AWAIT) {
+    if (catch_prediction() == HandlerTable::UNCAUGHT_ASYNC_AWAIT) {
       DCHECK_EQ(outer_catch_prediction, HandlerTable::UNCAUGHT);
       return false;
     }
 
-    return catch_prediction_ != HandlerTable::UNCAUGHT ||
+    return catch_prediction() != HandlerTable::UNCAUGHT ||
            outer_catch_prediction != HandlerTable::UNCAUGHT;
   }
 
   bool is_try_catch_for_async() {
-    return catch_prediction_ == HandlerTable::ASYNC_AWAIT;
+    return catch_prediction() == HandlerTable::ASYNC_AWAIT;
   }
 
  private:
@@ -843,12 +845,19 @@ class TryCatchStatement final : public TryStatement {
                     HandlerTable::CatchPrediction catch_prediction, int pos)
       : TryStatement(try_block, pos, kTryCatchStatement),
         scope_(scope),
-        catch_block_(catch_block),
-        catch_prediction_(catch_prediction) {}
+        catch_block_(catch_block) {
+    bit_field_ |= CatchPredictionField::encode(catch_prediction);
+  }
+
+  HandlerTable::CatchPrediction catch_prediction() const {
+    return CatchPredictionField::decode(bit_field_);
+  }
 
   Scope* scope_;
   Block* catch_block_;
-  HandlerTable::CatchPrediction catch_prediction_;
+
+  using CatchPredictionField =
+      TryStatement::NextBitField<HandlerTable::CatchPrediction, 3>;
 };
 
 
@@ -1266,8 +1275,8 @@ class ObjectLiteralBoilerplateBuilder final : public LiteralBoilerplateBuilder {
   ObjectLiteralBoilerplateBuilder(ZoneList<Property*>* properties,
                                   uint32_t boilerplate_properties,
                                   bool has_rest_property)
-      : properties_(properties),
-        boilerplate_properties_(boilerplate_properties) {
+      : boilerplate_properties_(boilerplate_properties),
+        properties_(properties) {
     bit_field_ |= HasElementsField::encode(false) |
                   HasRestPropertyField::encode(has_rest_property) |
                   FastElementsField::encode(false) |
@@ -1334,8 +1343,9 @@ class ObjectLiteralBoilerplateBuilder final : public LiteralBoilerplateBuilder {
   void set_has_null_protoype(bool has_null_prototype) {
     bit_field_ = HasNullPrototypeField::update(bit_field_, has_null_prototype);
   }
-  ZoneList<Property*>* properties_;
+  // Declared first to fill the space after the base class's bit field.
   uint32_t boilerplate_properties_;
+  ZoneList<Property*>* properties_;
   Handle<ObjectBoilerplateDescription> boilerplate_description_;
 
   using HasElementsField = LiteralBoilerplateBuilder::NextBitField<bool, 1>;
@@ -1394,7 +1404,7 @@ class ArrayLiteralBoilerplateBuilder final : public LiteralBoilerplateBuilder {
  public:
   ArrayLiteralBoilerplateBuilder(const ZonePtrList<Expression>* values,
                                  int first_spread_index)
-      : values_(values), first_spread_index_(first_spread_index) {}
+      : first_spread_index_(first_spread_index), values_(values) {}
   Handle<ArrayBoilerplateDescription> boilerplate_description() const {
     return boilerplate_description_;
   }
@@ -1426,8 +1436,9 @@ class ArrayLiteralBoilerplateBuilder final : public LiteralBoilerplateBuilder {
   template <typename IsolateT>
   void BuildBoilerplateDescription(IsolateT* isolate);
 
-  const ZonePtrList<Expression>* values_;
+  // Declared first to fill the space after the base class's bit field.
   int first_spread_index_;
+  const ZonePtrList<Expression>* values_;
   Handle<ArrayBoilerplateDescription> boilerplate_description_;
 };
 
@@ -1795,7 +1806,7 @@ class CallNew final : public CallBase {
 class CallRuntime final : public Expression {
  public:
   const ZonePtrList<Expression>* arguments() const { return &arguments_; }
-  bool is_jsruntime() const { return function_ == nullptr; }
+  bool is_jsruntime() const { return IsJsRuntimeField::decode(bit_field_); }
 
   int context_index() const {
     DCHECK(is_jsruntime());
@@ -1816,16 +1827,25 @@ class CallRuntime final : public Expression {
               const ScopedPtrList<Expression>& arguments, int pos)
       : Expression(pos, kCallRuntime),
         function_(function),
-        arguments_(arguments.ToConstVector(), zone) {}
+        arguments_(arguments.ToConstVector(), zone) {
+    DCHECK_NOT_NULL(function);
+    bit_field_ |= IsJsRuntimeField::encode(false);
+  }
   CallRuntime(Zone* zone, int context_index,
               const ScopedPtrList<Expression>& arguments, int pos)
       : Expression(pos, kCallRuntime),
         context_index_(context_index),
-        function_(nullptr),
-        arguments_(arguments.ToConstVector(), zone) {}
+        arguments_(arguments.ToConstVector(), zone) {
+    bit_field_ |= IsJsRuntimeField::encode(true);
+  }
+
+  using IsJsRuntimeField = Expression::NextBitField<bool, 1>;
 
-  int context_index_;
-  const Runtime::Function* function_;
+  // Only one of them is used, depending on {is_jsruntime}.
+  union {
+    int context_index_;
+    const Runtime::Function* function_;
+  };
   ZonePtrList<Expression> arguments_;
 };
 
@@ -11,6 +11,9 @@
 
 #include <algorithm>
 
+#include "src/base/platform/condition-variable.h"
+#include "src/base/platform/mutex.h"
+#include "src/base/platform/time.h"
 #include "src/baseline/baseline-compiler.h"
 #include "src/codegen/compiler.h"
 #include "src/execution/isolate.h"
@@ -102,11 +105,13 @@ class BaselineCompilerTask {
 
 class BaselineBatchCompilerJob {
  public:
+  // Takes the functions in the range [start, end) of |task_queue|.
   BaselineBatchCompilerJob(Isolate* isolate, Handle<WeakFixedArray> task_queue,
-                           int batch_size) {
+                           int start, int end)
+      : enqueue_time_(base::TimeTicks::Now()) {
     handles_ = isolate->NewPersistentHandles();
-    tasks_.reserve(batch_size);
-    for (int i = 0; i < batch_size; i++) {
+    tasks_.reserve(end - start);
+    for (int i = start; i < end; i++) {
       MaybeObject maybe_sfi = task_queue->Get(i);
       // TODO(victorgomes): Do I need to clear the value?
       task_queue->Set(i, HeapObjectReference::ClearedValue(isolate));
@@ -141,11 +146,21 @@ class BaselineBatchCompilerJob {
     for (auto& task : tasks_) {
       task.Install(isolate);
     }
+    if (FLAG_trace_baseline_concurrent_compilation) {
+      CodeTracer::Scope scope(isolate->GetCodeTracer());
+      PrintF(scope.file(),
+             "[Concurrent Sparkplug] installed %zu functions %.3f ms after "
+             "enqueueing\n",
+             tasks_.size(),
+             (base::TimeTicks::Now() - enqueue_time_).InMillisecondsF());
+    }
   }
 
  private:
   std::vector<BaselineCompilerTask> tasks_;
   std::unique_ptr<PersistentHandles> handles_;
+  // Used to trace the time from enqueueing a function to installing its code.
+  base::TimeTicks enqueue_time_;
 };
 
 class ConcurrentBaselineCompiler {
@@ -153,10 +168,11 @@ class ConcurrentBaselineCompiler {
   class JobDispatcher : public v8::JobTask {
    public:
     JobDispatcher(
-        Isolate* isolate,
+        Isolate* isolate, ConcurrentBaselineCompiler* compiler,
         LockedQueue<std::unique_ptr<BaselineBatchCompilerJob>>* incoming_queue,
         LockedQueue<std::unique_ptr<BaselineBatchCompilerJob>>* outcoming_queue)
         : isolate_(isolate),
+          compiler_(compiler),
           incoming_queue_(incoming_queue),
           outgoing_queue_(outcoming_queue) {}
 
@@ -175,20 +191,27 @@ class ConcurrentBaselineCompiler {
         DCHECK_NOT_NULL(job);
         job->Compile(&local_isolate);
         outgoing_queue_->Enqueue(std::move(job));
+        compiler_->JobCompiled();
+        // Install every job as soon as it is done instead of waiting for the
+        // whole queue to drain, since other workers are compiling the rest.
+        isolate_->stack_guard()->RequestInstallBaselineCode();
       }
-      isolate_->stack_guard()->RequestInstallBaselineCode();
     }
 
     size_t GetMaxConcurrency(size_t worker_count) const override {
+      // Workers that are still running count towards the limit, in addition
+      // to one worker per queued job.
+      size_t num_tasks = incoming_queue_->size() + worker_count;
       size_t max_threads = FLAG_concurrent_sparkplug_max_threads;
       if (max_threads > 0) {
-        return std::min(max_threads, incoming_queue_->size());
+        return std::min(max_threads, num_tasks);
       }
-      return incoming_queue_->size();
+      return num_tasks;
     }
 
    private:
     Isolate* isolate_;
+    ConcurrentBaselineCompiler* compiler_;
     LockedQueue<std::unique_ptr<BaselineBatchCompilerJob>>* incoming_queue_;
     LockedQueue<std::unique_ptr<BaselineBatchCompilerJob>>* outgoing_queue_;
   };
@@ -199,8 +222,8 @@ class ConcurrentBaselineCompiler {
                                   ? TaskPriority::kUserBlocking
                                   : TaskPriority::kUserVisible;
       job_handle_ = V8::GetCurrentPlatform()->PostJob(
-          priority, std::make_unique<JobDispatcher>(isolate_, &incoming_queue_,
-                                                    &outgoing_queue_));
+          priority, std::make_unique<JobDispatcher>(
+                        isolate_, this, &incoming_queue_, &outgoing_queue_));
     }
   }
 
@@ -215,8 +238,21 @@ class ConcurrentBaselineCompiler {
   void CompileBatch(Handle<WeakFixedArray> task_queue, int batch_size) {
     DCHECK(FLAG_concurrent_sparkplug);
     RCS_SCOPE(isolate_, RuntimeCallCounterId::kCompileBaseline);
-    incoming_queue_.Enqueue(std::make_unique<BaselineBatchCompilerJob>(
-        isolate_, task_queue, batch_size));
+    // Split the batch into several jobs, so that it is compiled by several
+    // workers in parallel.
+    int job_size =
+        FLAG_concurrent_sparkplug_functions_per_job > 0
+            ? static_cast<int>(FLAG_concurrent_sparkplug_functions_per_job)
+            : batch_size;
+    for (int start = 0; start < batch_size; start += job_size) {
+      int end = std::min(start + job_size, batch_size);
+      {
+        base::MutexGuard lock_guard(&pending_jobs_mutex_);
+        ++pending_jobs_;
+      }
+      incoming_queue_.Enqueue(std::make_unique<BaselineBatchCompilerJob>(
+          isolate_, task_queue, start, end));
+    }
     job_handle_->NotifyConcurrencyIncrease();
   }
 
@@ -228,11 +264,27 @@ class ConcurrentBaselineCompiler {
     }
   }
 
+  // Blocks until all enqueued jobs are compiled.
+  void AwaitCompileTasks() {
+    base::MutexGuard lock_guard(&pending_jobs_mutex_);
+    while (pending_jobs_ > 0) pending_jobs_zero_.Wait(&pending_jobs_mutex_);
+  }
+
  private:
+  void JobCompiled() {
+    base::MutexGuard lock_guard(&pending_jobs_mutex_);
+    DCHECK_LT(0, pending_jobs_);
+    if (--pending_jobs_ == 0) pending_jobs_zero_.NotifyAll();
+  }
+
   Isolate* isolate_;
   std::unique_ptr<JobHandle> job_handle_ = nullptr;
   LockedQueue<std::unique_ptr<BaselineBatchCompilerJob>> incoming_queue_;
   LockedQueue<std::unique_ptr<BaselineBatchCompilerJob>> outgoing_queue_;
+  // The number of jobs that are enqueued or compiling.
+  int pending_jobs_ = 0;
+  base::Mutex pending_jobs_mutex_;
+  base::ConditionVariable pending_jobs_zero_;
 };
 
 BaselineBatchCompiler::BaselineBatchCompiler(Isolate* isolate)
@@ -319,6 +371,12 @@ void BaselineBatchCompiler::InstallBatch() {
   concurrent_compiler_->InstallBatch();
 }
 
+void BaselineBatchCompiler::AwaitCompileTasksForTesting() {
+  if (!FLAG_concurrent_sparkplug) return;
+  concurrent_compiler_->AwaitCompileTasks();
+  concurrent_compiler_->InstallBatch();
+}
+
 void BaselineBatchCompiler::EnsureQueueCapacity() {
   if (compilation_queue_.is_null()) {
     compilation_queue_ = isolate_->global_handles()->Create(
@@ -403,6 +461,8 @@ BaselineBatchCompiler::~BaselineBatchCompiler() {
 
 void BaselineBatchCompiler::InstallBatch() { UNREACHABLE(); }
 
+void BaselineBatchCompiler::AwaitCompileTasksForTesting() {}
+
 void BaselineBatchCompiler::EnqueueFunction(Handle<JSFunction> function) {
   UNREACHABLE();
 }
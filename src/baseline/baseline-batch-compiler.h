@@ -31,6 +31,10 @@ class BaselineBatchCompiler {
 
   void InstallBatch();
 
+  // Waits for the batches that are compiled concurrently, and installs their
+  // code.
+  void AwaitCompileTasksForTesting();
+
  private:
   // Ensure there is enough space in the compilation queue to enqueue another
   // function, growing the queue if necessary.
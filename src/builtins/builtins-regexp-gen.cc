@@ -430,6 +430,73 @@ void RegExpBuiltinsAssembler::GetStringPointers(
   *var_string_end = ReinterpretCast<RawPtrT>(IntPtrAdd(string_data, to_offset));
 }
 
+TNode<IntPtrT> RegExpBuiltinsAssembler::SkipToPrefilterCandidate(
+    TNode<FixedArray> data, TNode<RawPtrT> string_data, TNode<IntPtrT> offset,
+    TNode<IntPtrT> last_index, TNode<IntPtrT> string_length,
+    String::Encoding encoding, Label* if_no_match) {
+  TVARIABLE(IntPtrT, var_start_index, last_index);
+  Label out(this), search(this);
+
+  TNode<Object> prefilter =
+      UnsafeLoadFixedArrayElement(data, JSRegExp::kIrregexpPrefilterIndex);
+  Branch(TaggedIsSmi(prefilter), &out, &search);
+
+  BIND(&search);
+  {
+    TNode<String> literal = CAST(prefilter);
+    CSA_DCHECK(this,
+               IsSeqOneByteStringInstanceType(LoadInstanceType(literal)));
+    TNode<IntPtrT> literal_length = LoadStringLengthAsWord(literal);
+    TNode<IntPtrT> literal_offset = SmiUntag(CAST(UnsafeLoadFixedArrayElement(
+        data, JSRegExp::kIrregexpPrefilterOffsetIndex)));
+    static_assert(JSRegExp::kNoPrefilterOffset < 0);
+    TNode<IntPtrT> search_start =
+        IntPtrAdd(last_index, IntPtrMax(literal_offset, IntPtrConstant(0)));
+    GotoIf(IntPtrGreaterThan(IntPtrAdd(search_start, literal_length),
+                             string_length),
+           if_no_match);
+
+    const ElementsKind kind = (encoding == String::ONE_BYTE_ENCODING)
+                                  ? UINT8_ELEMENTS
+                                  : UINT16_ELEMENTS;
+    TNode<RawPtrT> subject_ptr = ReinterpretCast<RawPtrT>(
+        IntPtrAdd(string_data, ElementOffsetFromIndex(offset, kind)));
+    TNode<RawPtrT> literal_ptr = RawPtrAdd(
+        ReinterpretCast<RawPtrT>(BitcastTaggedToWord(literal)),
+        IntPtrConstant(SeqOneByteString::kHeaderSize - kHeapObjectTag));
+
+    // The literal is one-byte, the subject can be either.
+    TNode<ExternalReference> search_function = ExternalConstant(
+        encoding == String::ONE_BYTE_ENCODING
+            ? ExternalReference::search_string_raw_one_one()
+            : ExternalReference::search_string_raw_two_one());
+    TNode<ExternalReference> isolate_address =
+        ExternalConstant(ExternalReference::isolate_address(isolate()));
+
+    MachineType type_ptr = MachineType::Pointer();
+    MachineType type_intptr = MachineType::IntPtr();
+    TNode<IntPtrT> found = UncheckedCast<IntPtrT>(CallCFunction(
+        search_function, type_intptr, std::make_pair(type_ptr, isolate_address),
+        std::make_pair(type_ptr, subject_ptr),
+        std::make_pair(type_intptr, string_length),
+        std::make_pair(type_ptr, literal_ptr),
+        std::make_pair(type_intptr, literal_length),
+        std::make_pair(type_intptr, search_start)));
+    GotoIf(IntPtrLessThan(found, IntPtrConstant(0)), if_no_match);
+
+    // If the literal is at a fixed distance from the start of the match, no
+    // match starts before that distance to the literal.
+    GotoIf(IntPtrEqual(literal_offset,
+                       IntPtrConstant(JSRegExp::kNoPrefilterOffset)),
+           &out);
+    var_start_index = IntPtrSub(found, literal_offset);
+    Goto(&out);
+  }
+
+  BIND(&out);
+  return var_start_index.value();
+}
+
 TNode<HeapObject> RegExpBuiltinsAssembler::RegExpExecInternal(
     TNode<Context> context, TNode<JSRegExp> regexp, TNode<String> string,
     TNode<Number> last_index, TNode<RegExpMatchInfo> match_info,
@@ -505,6 +572,7 @@ TNode<HeapObject> RegExpBuiltinsAssembler::RegExpExecInternal(
   // Load the irregexp code or bytecode object and offsets into the subject
   // string. Both depend on whether the string is one- or two-byte.
 
+  TVARIABLE(IntPtrT, var_start_index);
   TVARIABLE(RawPtrT, var_string_start);
   TVARIABLE(RawPtrT, var_string_end);
   TVARIABLE(Object, var_code);
@@ -519,9 +587,13 @@ TNode<HeapObject> RegExpBuiltinsAssembler::RegExpExecInternal(
 
     BIND(&if_isonebyte);
     {
-      GetStringPointers(direct_string_data, to_direct.offset(), int_last_index,
-                        int_string_length, String::ONE_BYTE_ENCODING,
-                        &var_string_start, &var_string_end);
+      var_start_index = SkipToPrefilterCandidate(
+          data, direct_string_data, to_direct.offset(), int_last_index,
+          int_string_length, String::ONE_BYTE_ENCODING, &if_failure);
+      GetStringPointers(direct_string_data, to_direct.offset(),
+                        var_start_index.value(), int_string_length,
+                        String::ONE_BYTE_ENCODING, &var_string_start,
+                        &var_string_end);
       var_code =
           UnsafeLoadFixedArrayElement(data, JSRegExp::kIrregexpLatin1CodeIndex);
       var_bytecode = UnsafeLoadFixedArrayElement(
@@ -531,9 +603,13 @@ TNode<HeapObject> RegExpBuiltinsAssembler::RegExpExecInternal(
 
     BIND(&if_istwobyte);
     {
-      GetStringPointers(direct_string_data, to_direct.offset(), int_last_index,
-                        int_string_length, String::TWO_BYTE_ENCODING,
-                        &var_string_start, &var_string_end);
+      var_start_index = SkipToPrefilterCandidate(
+          data, direct_string_data, to_direct.offset(), int_last_index,
+          int_string_length, String::TWO_BYTE_ENCODING, &if_failure);
+      GetStringPointers(direct_string_data, to_direct.offset(),
+                        var_start_index.value(), int_string_length,
+                        String::TWO_BYTE_ENCODING, &var_string_start,
+                        &var_string_end);
       var_code =
           UnsafeLoadFixedArrayElement(data, JSRegExp::kIrregexpUC16CodeIndex);
       var_bytecode = UnsafeLoadFixedArrayElement(
@@ -580,7 +656,7 @@ TNode<HeapObject> RegExpBuiltinsAssembler::RegExpExecInternal(
 
     // Argument 1: Previous index.
     MachineType arg1_type = type_int32;
-    TNode<Int32T> arg1 = TruncateIntPtrToInt32(int_last_index);
+    TNode<Int32T> arg1 = TruncateIntPtrToInt32(var_start_index.value());
 
     // Argument 2: Start of string data. This argument is ignored in the
     // interpreter.
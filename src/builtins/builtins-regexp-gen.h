@@ -51,6 +51,17 @@ class RegExpBuiltinsAssembler : public CodeStubAssembler {
                          TVariable<RawPtrT>* var_string_start,
                          TVariable<RawPtrT>* var_string_end);
 
+  // Searches the given {string_data} for the prefilter literal of the regexp
+  // with the given {data}, if there is one. Returns the index to start
+  // matching at, or jumps to {if_no_match} if the literal doesn't occur.
+  TNode<IntPtrT> SkipToPrefilterCandidate(TNode<FixedArray> data,
+                                          TNode<RawPtrT> string_data,
+                                          TNode<IntPtrT> offset,
+                                          TNode<IntPtrT> last_index,
+                                          TNode<IntPtrT> string_length,
+                                          String::Encoding encoding,
+                                          Label* if_no_match);
+
   // Low level logic around the actual call into pattern matching code.
   TNode<HeapObject> RegExpExecInternal(
       TNode<Context> context, TNode<JSRegExp> regexp, TNode<String> string,
@@ -6,7 +6,9 @@
 
 #include <algorithm>
 #include <memory>
+#include <unordered_map>
 
+#include "include/v8-platform.h"
 #include "src/api/api-inl.h"
 #include "src/asmjs/asm-js.h"
 #include "src/ast/prettyprinter.h"
@@ -20,6 +22,7 @@
 #include "src/codegen/optimized-compilation-info.h"
 #include "src/codegen/pending-optimization-table.h"
 #include "src/codegen/script-details.h"
+#include "src/codegen/shared-compilation-cache.h"
 #include "src/codegen/unoptimized-compilation-info.h"
 #include "src/common/assert-scope.h"
 #include "src/common/globals.h"
@@ -44,6 +47,7 @@
 #include "src/heap/local-heap.h"
 #include "src/heap/parked-scope.h"
 #include "src/init/bootstrapper.h"
+#include "src/init/v8.h"
 #include "src/interpreter/interpreter.h"
 #include "src/logging/counters-scopes.h"
 #include "src/logging/log-inl.h"
@@ -1540,7 +1544,15 @@ BackgroundCompileTask::BackgroundCompileTask(
       timer_(isolate->counters()->compile_script_on_background()),
       start_position_(0),
       end_position_(0),
-      function_literal_id_(kFunctionLiteralIdTopLevel) {}
+      function_literal_id_(kFunctionLiteralIdTopLevel) {
+  // Streamed scripts are parsed on a single background thread. Move the full
+  // parse and compile of their eager top-level functions (e.g. the IIFEs of
+  // bundles) to tasks of their own, so that they run in parallel to the parse
+  // of the rest of the script.
+  if (FLAG_parallel_compile_tasks_for_streaming) {
+    flags_.set_post_parallel_compile_tasks_for_eager_toplevel(true);
+  }
+}
 
 BackgroundCompileTask::BackgroundCompileTask(
     Isolate* isolate, Handle<SharedFunctionInfo> shared_info,
@@ -1838,6 +1850,223 @@ void BackgroundCompileTask::ReportStatistics(Isolate* isolate) {
   }
 }
 
+namespace {
+
+// Redirects references to SharedFunctionInfos in bytecode constant pools,
+// based on their function literal id.
+class ConstantPoolPointerForwarder {
+ public:
+  ConstantPoolPointerForwarder(PtrComprCageBase cage_base,
+                               LocalHeap* local_heap)
+      : cage_base_(cage_base), local_heap_(local_heap) {}
+
+  void AddBytecodeArray(BytecodeArray bytecode_array) {
+    bytecode_arrays_to_update_.push_back(handle(bytecode_array, local_heap_));
+  }
+
+  void Forward(SharedFunctionInfo from, SharedFunctionInfo to) {
+    forwarding_table_[from.function_literal_id()] = handle(to, local_heap_);
+  }
+
+  bool HasAnythingToForward() const { return !forwarding_table_.empty(); }
+
+  void IterateAndForwardPointers() {
+    DCHECK(HasAnythingToForward());
+    for (Handle<BytecodeArray> bytecode_array : bytecode_arrays_to_update_) {
+      local_heap_->Safepoint();
+      DisallowGarbageCollection no_gc;
+      IterateConstantPool(bytecode_array->constant_pool());
+    }
+  }
+
+ private:
+  void IterateConstantPool(FixedArray constant_pool) {
+    for (int i = 0, length = constant_pool.length(); i < length; ++i) {
+      Object obj = constant_pool.get(i);
+      if (obj.IsSmi()) continue;
+      HeapObject heap_obj = HeapObject::cast(obj);
+      if (heap_obj.IsFixedArray(cage_base_)) {
+        // Constant pools can contain nested FixedArrays, e.g. for global
+        // declarations, but never more than a few levels deep.
+        IterateConstantPool(FixedArray::cast(heap_obj));
+      } else if (heap_obj.IsSharedFunctionInfo(cage_base_)) {
+        auto it = forwarding_table_.find(
+            SharedFunctionInfo::cast(heap_obj).function_literal_id());
+        if (it != forwarding_table_.end()) {
+          constant_pool.set(i, *it->second);
+        }
+      }
+    }
+  }
+
+  PtrComprCageBase cage_base_;
+  LocalHeap* local_heap_;
+  std::vector<Handle<BytecodeArray>> bytecode_arrays_to_update_;
+  std::unordered_map<int, Handle<SharedFunctionInfo>> forwarding_table_;
+};
+
+}  // namespace
+
+BackgroundMergeTask::BackgroundMergeTask() = default;
+BackgroundMergeTask::~BackgroundMergeTask() = default;
+
+void BackgroundMergeTask::SetUpOnMainThread(Isolate* isolate,
+                                            Handle<String> source_text,
+                                            const ScriptDetails& script_details,
+                                            LanguageMode language_mode) {
+  DCHECK_EQ(state_, kNotStarted);
+  HandleScope handle_scope(isolate);
+
+  CompilationCacheScript::LookupResult lookup_result =
+      isolate->compilation_cache()->LookupScript(source_text, script_details,
+                                                 language_mode);
+  Handle<Script> script;
+  if (!lookup_result.script().ToHandle(&script)) return;
+  // With a compiled top-level SharedFunctionInfo in the cache, the
+  // deserialized objects are dropped anyway.
+  if (!lookup_result.toplevel_sfi().is_null()) return;
+
+  // Everything passed to the background thread has to be a persistent handle.
+  persistent_handles_ = std::make_unique<PersistentHandles>(isolate);
+  cached_script_ = persistent_handles_->NewHandle(*script);
+  state_ = kPendingBackgroundWork;
+}
+
+void BackgroundMergeTask::BeginMergeInBackground(LocalIsolate* isolate,
+                                                 Handle<Script> new_script) {
+  DCHECK_EQ(state_, kPendingBackgroundWork);
+
+  LocalHeap* local_heap = isolate->heap();
+  local_heap->AttachPersistentHandles(std::move(persistent_handles_));
+  LocalHandleScope handle_scope(local_heap);
+  ConstantPoolPointerForwarder forwarder(isolate, local_heap);
+  Handle<Script> old_script = cached_script_.ToHandleChecked();
+
+  {
+    DisallowGarbageCollection no_gc;
+    WeakFixedArray old_infos = old_script->shared_function_infos();
+    WeakFixedArray new_infos = new_script->shared_function_infos();
+    if (old_infos.length() != new_infos.length()) {
+      // The code cache belongs to a different source of the same length,
+      // which finishing the deserialization rejects.
+      persistent_handles_ = local_heap->DetachPersistentHandles();
+      state_ = kDone;
+      return;
+    }
+
+    for (int i = 0; i < new_infos.length(); ++i) {
+      HeapObject new_object;
+      if (!new_infos.Get(i)->GetHeapObjectIfWeak(&new_object)) continue;
+      SharedFunctionInfo new_sfi = SharedFunctionInfo::cast(new_object);
+      HeapObject old_object;
+      if (old_infos.Get(i)->GetHeapObjectIfWeak(&old_object)) {
+        // Keep the existing SharedFunctionInfo, which may already have
+        // feedback and optimized code attached to its closures.
+        SharedFunctionInfo old_sfi = SharedFunctionInfo::cast(old_object);
+        forwarder.Forward(new_sfi, old_sfi);
+        if (new_sfi.HasBytecodeArray() && !old_sfi.is_compiled()) {
+          new_compiled_data_for_cached_sfis_.emplace_back(
+              local_heap->NewPersistentHandle(old_sfi),
+              local_heap->NewPersistentHandle(new_sfi));
+          forwarder.AddBytecodeArray(new_sfi.GetBytecodeArray(isolate));
+        }
+      } else {
+        DCHECK_EQ(i, new_sfi.function_literal_id());
+        used_new_sfis_.push_back(local_heap->NewPersistentHandle(new_sfi));
+        if (new_sfi.HasBytecodeArray()) {
+          forwarder.AddBytecodeArray(new_sfi.GetBytecodeArray(isolate));
+        }
+      }
+    }
+  }
+
+  // The deserialized bytecode refers to the deserialized SharedFunctionInfos,
+  // which have to be replaced by the existing ones.
+  if (forwarder.HasAnythingToForward()) {
+    forwarder.IterateAndForwardPointers();
+  }
+
+  persistent_handles_ = local_heap->DetachPersistentHandles();
+  state_ = kPendingForegroundWork;
+}
+
+Handle<SharedFunctionInfo> BackgroundMergeTask::CompleteMergeInForeground(
+    Isolate* isolate, Handle<Script> new_script) {
+  DCHECK_EQ(state_, kPendingForegroundWork);
+
+  HandleScope handle_scope(isolate);
+  ConstantPoolPointerForwarder forwarder(isolate,
+                                         isolate->main_thread_local_heap());
+  Handle<Script> old_script = cached_script_.ToHandleChecked();
+  DCHECK_EQ(old_script->shared_function_infos().length(),
+            new_script->shared_function_infos().length());
+  LazyCompileDispatcher* dispatcher = isolate->lazy_compile_dispatcher();
+
+  for (const auto& new_compiled_data : new_compiled_data_for_cached_sfis_) {
+    Handle<SharedFunctionInfo> cached_sfi = new_compiled_data.first;
+    Handle<SharedFunctionInfo> new_sfi = new_compiled_data.second;
+    // The function may have been compiled on the main thread meanwhile. Also
+    // leave it alone if a DebugInfo or a pending lazy compile job refers to
+    // its uncompiled data.
+    if (cached_sfi->is_compiled() || !new_sfi->is_compiled() ||
+        cached_sfi->HasDebugInfo() ||
+        (dispatcher && dispatcher->IsEnqueued(cached_sfi))) {
+      continue;
+    }
+    // Copy all fields but the script, by giving the new SharedFunctionInfo
+    // the script of the cached one first.
+    new_sfi->set_script_or_debug_info(
+        cached_sfi->script_or_debug_info(kAcquireLoad), kReleaseStore);
+    cached_sfi->CopyFrom(*new_sfi);
+  }
+
+  for (Handle<SharedFunctionInfo> new_sfi : used_new_sfis_) {
+    int function_literal_id = new_sfi->function_literal_id();
+    HeapObject existing;
+    if (old_script->shared_function_infos()
+            .Get(function_literal_id)
+            ->GetHeapObjectIfWeak(&existing)) {
+      // The cached Script created a SharedFunctionInfo for this function
+      // after the background merge, so references to the new one have to be
+      // forwarded again.
+      forwarder.Forward(*new_sfi, SharedFunctionInfo::cast(existing));
+    } else {
+      new_sfi->set_script(*old_script);
+      old_script->shared_function_infos().Set(
+          function_literal_id, HeapObjectReference::Weak(*new_sfi));
+    }
+  }
+
+  if (forwarder.HasAnythingToForward()) {
+    for (Handle<SharedFunctionInfo> new_sfi : used_new_sfis_) {
+      if (new_sfi->script() == *old_script && new_sfi->HasBytecodeArray()) {
+        forwarder.AddBytecodeArray(new_sfi->GetBytecodeArray(isolate));
+      }
+    }
+    for (const auto& new_compiled_data : new_compiled_data_for_cached_sfis_) {
+      if (new_compiled_data.first->HasBytecodeArray()) {
+        forwarder.AddBytecodeArray(
+            new_compiled_data.first->GetBytecodeArray(isolate));
+      }
+    }
+    forwarder.IterateAndForwardPointers();
+  }
+
+  HeapObject toplevel;
+  CHECK(old_script->shared_function_infos()
+            .Get(kFunctionLiteralIdTopLevel)
+            ->GetHeapObjectIfWeak(&toplevel));
+  Handle<SharedFunctionInfo> result =
+      handle(SharedFunctionInfo::cast(toplevel), isolate);
+
+  used_new_sfis_.clear();
+  new_compiled_data_for_cached_sfis_.clear();
+  cached_script_ = {};
+  persistent_handles_.reset();
+  state_ = kDone;
+  return handle_scope.CloseAndEscape(result);
+}
+
 BackgroundDeserializeTask::BackgroundDeserializeTask(
     Isolate* isolate, std::unique_ptr<ScriptCompiler::CachedData> cached_data)
     : isolate_for_local_isolate_(isolate),
@@ -1865,18 +2094,29 @@ void BackgroundDeserializeTask::SourceTextAvailable(
     Isolate* isolate, Handle<String> source_text,
     const ScriptDetails& script_details) {
   DCHECK_EQ(isolate, isolate_for_local_isolate_);
-  // TODO(v8:12808): Implement this.
+  if (!FLAG_merge_background_deserialized_script_with_compilation_cache) {
+    return;
+  }
+  LanguageMode language_mode = construct_language_mode(FLAG_use_strict);
+  background_merge_task_.SetUpOnMainThread(isolate, source_text, script_details,
+                                           language_mode);
 }
 
 bool BackgroundDeserializeTask::ShouldMergeWithExistingScript() const {
   DCHECK(FLAG_merge_background_deserialized_script_with_compilation_cache);
-  // TODO(v8:12808): Implement this.
-  return true;
+  return background_merge_task_.HasPendingBackgroundWork() &&
+         off_thread_data_.HasResult();
 }
 
 void BackgroundDeserializeTask::MergeWithExistingScript() {
-  DCHECK(FLAG_merge_background_deserialized_script_with_compilation_cache);
-  // TODO(v8:12808): Implement this.
+  DCHECK(ShouldMergeWithExistingScript());
+
+  LocalIsolate isolate(isolate_for_local_isolate_, ThreadKind::kBackground);
+  UnparkedScope unparked_scope(&isolate);
+  LocalHandleScope handle_scope(isolate.heap());
+
+  background_merge_task_.BeginMergeInBackground(
+      &isolate, off_thread_data_.GetOnlyScript(isolate.heap()));
 }
 
 MaybeHandle<SharedFunctionInfo> BackgroundDeserializeTask::Finish(
@@ -1884,7 +2124,7 @@ MaybeHandle<SharedFunctionInfo> BackgroundDeserializeTask::Finish(
     ScriptOriginOptions origin_options) {
   return CodeSerializer::FinishOffThreadDeserialize(
       isolate, std::move(off_thread_data_), &cached_data_, source,
-      origin_options);
+      origin_options, &background_merge_task_);
 }
 
 // ----------------------------------------------------------------------------
@@ -3071,6 +3311,21 @@ MaybeHandle<SharedFunctionInfo> GetSharedFunctionInfoForScriptImpl(
         compile_timer.set_consuming_code_cache_failed();
       }
     }
+
+    // Then check the cache shared by all isolates of the process.
+    if (maybe_result.is_null() && FLAG_shared_compilation_cache &&
+        natives == NOT_NATIVES_CODE) {
+      Handle<SharedFunctionInfo> result;
+      if (SharedCompilationCache::Get()
+              ->Lookup(isolate, source, script_details)
+              .ToHandle(&result)) {
+        is_compiled_scope = result->is_compiled_scope(isolate);
+        if (is_compiled_scope.is_compiled()) {
+          compilation_cache->PutScript(source, language_mode, result);
+          maybe_result = result;
+        }
+      }
+    }
   }
 
   if (maybe_result.is_null()) {
@@ -3103,6 +3358,10 @@ MaybeHandle<SharedFunctionInfo> GetSharedFunctionInfoForScriptImpl(
     if (use_compilation_cache && maybe_result.ToHandle(&result)) {
       DCHECK(is_compiled_scope.is_compiled());
       compilation_cache->PutScript(source, language_mode, result);
+      if (FLAG_shared_compilation_cache && natives == NOT_NATIVES_CODE) {
+        SharedCompilationCache::Get()->Put(isolate, source, script_details,
+                                           result);
+      }
     } else if (maybe_result.is_null() && natives != EXTENSION_CODE) {
       isolate->ReportPendingMessages();
     }
@@ -3294,6 +3553,18 @@ Compiler::GetSharedFunctionInfoForStreamedScript(
                    "V8.StreamingFinalization.AddToCache");
       compilation_cache->PutScript(source, task->flags().outer_language_mode(),
                                    result);
+
+      // Install the functions of this script whose parallel compile tasks
+      // already finished now, rather than at idle time or on their first
+      // call.
+      LazyCompileDispatcher* dispatcher = isolate->lazy_compile_dispatcher();
+      if (dispatcher &&
+          task->flags().post_parallel_compile_tasks_for_eager_toplevel()) {
+        TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.compile"),
+                     "V8.StreamingFinalization.FinalizeParallelTasks");
+        dispatcher->FinalizeFinishedJobs(handle(
+            Script::cast(result->script()), isolate));
+      }
     }
   }
 
@@ -3571,5 +3842,67 @@ ScriptStreamingData::~ScriptStreamingData() = default;
 
 void ScriptStreamingData::Release() { task.reset(); }
 
+class BackgroundCompileBatch::JobTask : public v8::JobTask {
+ public:
+  explicit JobTask(BackgroundCompileBatch* batch) : batch_(batch) {}
+
+  void Run(JobDelegate* delegate) final {
+    while (!delegate->ShouldYield()) {
+      BackgroundCompileTask* task = batch_->NextTask();
+      if (task == nullptr) return;
+      task->Run();
+    }
+  }
+
+  size_t GetMaxConcurrency(size_t worker_count) const final {
+    // Workers that are still compiling a script count towards the limit, in
+    // addition to one worker per script that was not picked up yet. There is
+    // never work for more workers than the batch has scripts.
+    return std::min(batch_->NumPendingTasks() + worker_count,
+                    batch_->scripts_.size());
+  }
+
+ private:
+  BackgroundCompileBatch* const batch_;
+};
+
+BackgroundCompileBatch::BackgroundCompileBatch(
+    Isolate* isolate, std::vector<ScriptStreamingData*> scripts)
+    : isolate_(isolate), scripts_(std::move(scripts)) {
+  job_handle_ = V8::GetCurrentPlatform()->PostJob(
+      TaskPriority::kUserVisible, std::make_unique<JobTask>(this));
+}
+
+BackgroundCompileBatch::~BackgroundCompileBatch() {
+  if (!job_handle_->IsValid()) return;
+  DCHECK_EQ(ThreadId::Current(), isolate_->thread_id());
+  // Cancelling waits for the running workers, which may need a safepoint
+  // meanwhile.
+  ParkedScope parked_scope(isolate_->main_thread_local_isolate());
+  job_handle_->Cancel();
+}
+
+BackgroundCompileTask* BackgroundCompileBatch::NextTask() {
+  size_t index = next_script_.fetch_add(1, std::memory_order_relaxed);
+  if (index >= scripts_.size()) return nullptr;
+  return scripts_[index]->task.get();
+}
+
+size_t BackgroundCompileBatch::NumPendingTasks() const {
+  size_t next = next_script_.load(std::memory_order_relaxed);
+  return next < scripts_.size() ? scripts_.size() - next : 0;
+}
+
+void BackgroundCompileBatch::Join() {
+  DCHECK_EQ(ThreadId::Current(), isolate_->thread_id());
+  while (BackgroundCompileTask* task = NextTask()) {
+    task->RunOnMainThread(isolate_);
+  }
+  // No task is left for the joining thread, it only waits for the workers,
+  // which may need a safepoint meanwhile.
+  ParkedScope parked_scope(isolate_->main_thread_local_isolate());
+  job_handle_->Join();
+}
+
 }  // namespace internal
 }  // namespace v8
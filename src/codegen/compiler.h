@@ -5,8 +5,10 @@
 #ifndef V8_CODEGEN_COMPILER_H_
 #define V8_CODEGEN_COMPILER_H_
 
+#include <atomic>
 #include <forward_list>
 #include <memory>
+#include <vector>
 
 #include "src/ast/ast-value-factory.h"
 #include "src/base/platform/elapsed-timer.h"
@@ -26,6 +28,9 @@
 #include "src/zone/zone.h"
 
 namespace v8 {
+
+class JobHandle;
+
 namespace internal {
 
 // Forward declarations.
@@ -599,6 +604,102 @@ struct ScriptStreamingData {
   std::unique_ptr<BackgroundCompileTask> task;
 };
 
+// Runs the BackgroundCompileTasks of several streamed scripts, e.g. the
+// modules of a module graph, in parallel as a job on the platform's worker
+// threads. Implementation of v8::ScriptCompiler::ModuleStreamingBatch.
+class V8_EXPORT_PRIVATE BackgroundCompileBatch {
+ public:
+  // Does not take ownership of the {scripts}, whose tasks must be set.
+  BackgroundCompileBatch(Isolate* isolate,
+                         std::vector<ScriptStreamingData*> scripts);
+  BackgroundCompileBatch(const BackgroundCompileBatch&) = delete;
+  BackgroundCompileBatch& operator=(const BackgroundCompileBatch&) = delete;
+  // Cancels the tasks that did not start yet.
+  ~BackgroundCompileBatch();
+
+  // Runs the tasks that no worker picked up yet on the main thread, and waits
+  // for the others. Afterwards, all scripts can be finalized.
+  void Join();
+
+ private:
+  class JobTask;
+
+  // Claims the next task which did not start yet, or returns nullptr.
+  BackgroundCompileTask* NextTask();
+  size_t NumPendingTasks() const;
+
+  Isolate* const isolate_;
+  const std::vector<ScriptStreamingData*> scripts_;
+  std::atomic<size_t> next_script_{0};
+  std::unique_ptr<JobHandle> job_handle_;
+};
+
+// Merges the objects deserialized from a code cache on a background thread into
+// a Script with the same source which is still alive in the isolate, e.g.
+// after a reload. SharedFunctionInfos are matched by function literal id:
+// existing ones are kept together with their bytecode and feedback, and only
+// pick up bytecode from the deserialized ones if they are not compiled. Most
+// of the matching happens on the background thread; the main thread only
+// publishes the result.
+class V8_EXPORT_PRIVATE BackgroundMergeTask {
+ public:
+  BackgroundMergeTask();
+  ~BackgroundMergeTask();
+  BackgroundMergeTask(const BackgroundMergeTask&) = delete;
+  BackgroundMergeTask& operator=(const BackgroundMergeTask&) = delete;
+
+  // Looks up a Script with the given source in the Isolate compilation cache.
+  // If there is one without a compiled top-level SharedFunctionInfo, a merge
+  // is needed and HasPendingBackgroundWork becomes true.
+  void SetUpOnMainThread(Isolate* isolate, Handle<String> source_text,
+                         const ScriptDetails& script_details,
+                         LanguageMode language_mode);
+
+  bool HasPendingBackgroundWork() const {
+    return state_ == kPendingBackgroundWork;
+  }
+
+  // Matches the SharedFunctionInfos of {new_script} with the ones of the
+  // cached Script, and redirects the references to them from the
+  // deserialized bytecode. Only modifies deserialized objects, which are not
+  // yet visible to the main thread. May be called from any thread, only once.
+  void BeginMergeInBackground(LocalIsolate* isolate, Handle<Script> new_script);
+
+  bool HasPendingForegroundWork() const {
+    return state_ == kPendingForegroundWork;
+  }
+
+  // Publishes the merge result in the cached Script and returns its top-level
+  // SharedFunctionInfo, which callers have to use instead of the deserialized
+  // one.
+  Handle<SharedFunctionInfo> CompleteMergeInForeground(
+      Isolate* isolate, Handle<Script> new_script);
+
+ private:
+  enum State {
+    kNotStarted,
+    kPendingBackgroundWork,
+    kPendingForegroundWork,
+    kDone,
+  };
+
+  // Holds all handles below while they are passed between threads.
+  std::unique_ptr<PersistentHandles> persistent_handles_;
+
+  MaybeHandle<Script> cached_script_;
+
+  // Deserialized SharedFunctionInfos without a counterpart in the cached
+  // Script, which move to the cached Script.
+  std::vector<Handle<SharedFunctionInfo>> used_new_sfis_;
+
+  // Pairs of an uncompiled SharedFunctionInfo of the cached Script and its
+  // compiled counterpart from the code cache.
+  std::vector<std::pair<Handle<SharedFunctionInfo>, Handle<SharedFunctionInfo>>>
+      new_compiled_data_for_cached_sfis_;
+
+  State state_ = kNotStarted;
+};
+
 class V8_EXPORT_PRIVATE BackgroundDeserializeTask {
  public:
   BackgroundDeserializeTask(Isolate* isolate,
@@ -635,6 +736,7 @@ class V8_EXPORT_PRIVATE BackgroundDeserializeTask {
   Isolate* isolate_for_local_isolate_;
   AlignedCachedData cached_data_;
   CodeSerializer::OffThreadDeserializeData off_thread_data_;
+  BackgroundMergeTask background_merge_task_;
 };
 
 }  // namespace internal
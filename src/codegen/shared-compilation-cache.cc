@@ -0,0 +1,221 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/codegen/shared-compilation-cache.h"
+
+#include <algorithm>
+
+#include "src/base/functional.h"
+#include "src/base/lazy-instance.h"
+#include "src/codegen/script-details.h"
+#include "src/execution/isolate.h"
+#include "src/flags/flags.h"
+#include "src/handles/global-handles.h"
+#include "src/init/v8.h"
+#include "src/objects/objects-inl.h"
+#include "src/objects/string-inl.h"
+#include "src/snapshot/code-serializer.h"
+#include "src/tasks/cancelable-task.h"
+#include "src/tasks/task-utils.h"
+#include "src/tracing/trace-event.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+// Returns the characters of the flat {source} as bytes, without copying them.
+base::Vector<const uint8_t> SourceBytes(
+    String source, bool* one_byte, const DisallowGarbageCollection& no_gc) {
+  String::FlatContent content = source.GetFlatContent(no_gc);
+  *one_byte = content.IsOneByte();
+  if (content.IsOneByte()) return content.ToOneByteVector();
+  return base::Vector<const uint8_t>::cast(content.ToUC16Vector());
+}
+
+}  // namespace
+
+// static
+DEFINE_LAZY_LEAKY_OBJECT_GETTER(SharedCompilationCache,
+                                SharedCompilationCache::Get,
+                                FLAG_shared_compilation_cache_max_size_mb * MB)
+
+SharedCompilationCache::SharedCompilationCache(size_t max_size)
+    : max_size_(max_size) {}
+
+SharedCompilationCache::~SharedCompilationCache() = default;
+
+// static
+bool SharedCompilationCache::CanCache(const ScriptDetails& script_details) {
+  Handle<Object> options;
+  if (!script_details.host_defined_options.ToHandle(&options)) return true;
+  return options->IsFixedArray() && FixedArray::cast(*options).length() == 0;
+}
+
+// static
+SharedCompilationCache::Entry SharedCompilationCache::MakeOrigin(
+    const ScriptDetails& script_details) {
+  Entry entry;
+  Handle<Object> name;
+  if (script_details.name_obj.ToHandle(&name) && name->IsString()) {
+    entry.name = String::cast(*name).ToCString().get();
+  }
+  entry.line_offset = script_details.line_offset;
+  entry.column_offset = script_details.column_offset;
+  entry.origin_flags = script_details.origin_options.Flags();
+  return entry;
+}
+
+// static
+SharedCompilationCache::Key SharedCompilationCache::MakeKey(
+    const Entry& origin, base::Vector<const uint8_t> source) {
+  size_t hash = base::hash_combine(
+      base::hash_range(source.begin(), source.end()),
+      base::hash_range(origin.name.begin(), origin.name.end()),
+      origin.one_byte, origin.line_offset, origin.column_offset,
+      origin.origin_flags);
+  return {hash, source.size()};
+}
+
+MaybeHandle<SharedFunctionInfo> SharedCompilationCache::Lookup(
+    Isolate* isolate, Handle<String> source,
+    const ScriptDetails& script_details) {
+  if (!CanCache(script_details)) return {};
+  Entry origin = MakeOrigin(script_details);
+  source = String::Flatten(isolate, source);
+  Key key;
+  std::shared_ptr<const std::vector<uint8_t>> data;
+  {
+    DisallowGarbageCollection no_gc;
+    base::Vector<const uint8_t> bytes =
+        SourceBytes(*source, &origin.one_byte, no_gc);
+    key = MakeKey(origin, bytes);
+    base::MutexGuard guard(&mutex_);
+    auto range = entries_.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+      Entry& entry = it->second;
+      if (!entry.MatchesOrigin(origin)) continue;
+      // Same length, as part of the key.
+      if (!std::equal(bytes.begin(), bytes.end(), entry.source.begin())) {
+        continue;
+      }
+      entry.last_use = ++use_counter_;
+      data = entry.data;
+      break;
+    }
+  }
+  if (!data) return {};
+
+  AlignedCachedData cached_data(data->data(), static_cast<int>(data->size()));
+  MaybeHandle<SharedFunctionInfo> result = CodeSerializer::Deserialize(
+      isolate, &cached_data, source, script_details.origin_options);
+  if (cached_data.rejected()) {
+    // The entry was created with different flags. Drop it, such that the
+    // isolate puts its own result instead.
+    base::MutexGuard guard(&mutex_);
+    auto range = entries_.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second.data != data) continue;
+      total_size_ -= it->second.size();
+      entries_.erase(it);
+      break;
+    }
+  }
+  return result;
+}
+
+void SharedCompilationCache::Put(Isolate* isolate, Handle<String> source,
+                                 const ScriptDetails& script_details,
+                                 Handle<SharedFunctionInfo> toplevel) {
+  if (!CanCache(script_details)) return;
+  Entry origin = MakeOrigin(script_details);
+  // The global handles are destroyed by the task. If the task gets canceled
+  // because the isolate is torn down, they go away with the isolate.
+  GlobalHandles* global_handles = isolate->global_handles();
+  Handle<String> global_source = global_handles->Create(*source);
+  Handle<SharedFunctionInfo> global_toplevel =
+      global_handles->Create(*toplevel);
+  V8::GetCurrentPlatform()
+      ->GetForegroundTaskRunner(reinterpret_cast<v8::Isolate*>(isolate))
+      ->PostTask(MakeCancelableTask(isolate, [this, isolate, global_source,
+                                             origin, global_toplevel] {
+        Serialize(isolate, global_source, origin, global_toplevel);
+        GlobalHandles::Destroy(global_source.location());
+        GlobalHandles::Destroy(global_toplevel.location());
+      }));
+}
+
+void SharedCompilationCache::Serialize(Isolate* isolate, Handle<String> source,
+                                       Entry entry,
+                                       Handle<SharedFunctionInfo> toplevel) {
+  TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.compile"),
+               "V8.SharedCompilationCacheSerialize");
+  HandleScope scope(isolate);
+  std::unique_ptr<ScriptCompiler::CachedData> cached_data(
+      CodeSerializer::Serialize(toplevel));
+  if (!cached_data) return;
+  entry.data = std::make_shared<const std::vector<uint8_t>>(
+      cached_data->data, cached_data->data + cached_data->length);
+
+  source = String::Flatten(isolate, source);
+  Key key;
+  {
+    DisallowGarbageCollection no_gc;
+    base::Vector<const uint8_t> bytes =
+        SourceBytes(*source, &entry.one_byte, no_gc);
+    key = MakeKey(entry, bytes);
+    entry.source.assign(bytes.begin(), bytes.end());
+  }
+  if (entry.size() > max_size_) return;
+  Insert(key, std::move(entry));
+}
+
+void SharedCompilationCache::Insert(Key key, Entry entry) {
+  base::MutexGuard guard(&mutex_);
+  auto range = entries_.equal_range(key);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (!it->second.MatchesOrigin(entry) || it->second.source != entry.source) {
+      continue;
+    }
+    total_size_ -= it->second.size();
+    entries_.erase(it);
+    break;
+  }
+  entry.last_use = ++use_counter_;
+  total_size_ += entry.size();
+  entries_.emplace(key, std::move(entry));
+  EvictLocked();
+}
+
+void SharedCompilationCache::Clear() {
+  base::MutexGuard guard(&mutex_);
+  entries_.clear();
+  total_size_ = 0;
+}
+
+size_t SharedCompilationCache::size() const {
+  base::MutexGuard guard(&mutex_);
+  return total_size_;
+}
+
+size_t SharedCompilationCache::entry_count() const {
+  base::MutexGuard guard(&mutex_);
+  return entries_.size();
+}
+
+void SharedCompilationCache::EvictLocked() {
+  while (total_size_ > max_size_) {
+    DCHECK(!entries_.empty());
+    auto least_recently_used = std::min_element(
+        entries_.begin(), entries_.end(),
+        [](const EntryMap::value_type& a, const EntryMap::value_type& b) {
+          return a.second.last_use < b.second.last_use;
+        });
+    total_size_ -= least_recently_used->second.size();
+    entries_.erase(least_recently_used);
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
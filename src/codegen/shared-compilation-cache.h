@@ -0,0 +1,122 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_CODEGEN_SHARED_COMPILATION_CACHE_H_
+#define V8_CODEGEN_SHARED_COMPILATION_CACHE_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "src/base/platform/mutex.h"
+#include "src/base/vector.h"
+#include "src/handles/maybe-handles.h"
+
+namespace v8 {
+namespace internal {
+
+class Isolate;
+class SharedFunctionInfo;
+class String;
+struct ScriptDetails;
+
+// A process-wide cache of compiled top-level scripts, shared by all isolates.
+// The per-isolate CompilationCache falls back to it on a miss. Entries hold
+// the script in the code cache format, such that other isolates deserialize
+// the bytecode and SharedFunctionInfos instead of parsing and compiling the
+// same source again. The least recently used entries are evicted once the
+// cache grows beyond --shared-compilation-cache-max-size-mb.
+//
+// Scripts with host-defined options are not cached, since the serialized
+// script does not include them.
+class V8_EXPORT_PRIVATE SharedCompilationCache {
+ public:
+  // Returns the process-wide instance.
+  static SharedCompilationCache* Get();
+
+  explicit SharedCompilationCache(size_t max_size);
+  ~SharedCompilationCache();
+  SharedCompilationCache(const SharedCompilationCache&) = delete;
+  SharedCompilationCache& operator=(const SharedCompilationCache&) = delete;
+
+  // Materializes the cached script with the given source and origin in
+  // {isolate}, or returns an empty handle if there is none.
+  MaybeHandle<SharedFunctionInfo> Lookup(Isolate* isolate,
+                                         Handle<String> source,
+                                         const ScriptDetails& script_details);
+
+  // Makes {toplevel} available to all isolates. It is serialized in a task
+  // posted to {isolate}'s foreground task runner, not on the compile path.
+  void Put(Isolate* isolate, Handle<String> source,
+           const ScriptDetails& script_details,
+           Handle<SharedFunctionInfo> toplevel);
+
+  // Evicts all entries.
+  void Clear();
+
+  // The total size of all entries, in bytes.
+  size_t size() const;
+  size_t entry_count() const;
+
+ private:
+  // An entry holds the parts of the origin that the serialized Script
+  // records, and a copy of the source to tell scripts with the same key
+  // apart.
+  struct Entry {
+    bool one_byte = true;
+    std::vector<uint8_t> source;
+    std::string name;
+    int line_offset = 0;
+    int column_offset = 0;
+    int origin_flags = 0;
+    std::shared_ptr<const std::vector<uint8_t>> data;
+    uint64_t last_use = 0;
+
+    bool MatchesOrigin(const Entry& other) const {
+      return one_byte == other.one_byte && line_offset == other.line_offset &&
+             column_offset == other.column_offset &&
+             origin_flags == other.origin_flags && name == other.name;
+    }
+
+    size_t size() const {
+      return source.size() + name.size() + (data ? data->size() : 0);
+    }
+  };
+  // Entries are found by the hash and the length of their source and origin.
+  // Only entries with the same key compare the full source.
+  struct Key {
+    size_t hash;
+    size_t source_length;
+    bool operator==(const Key& other) const {
+      return hash == other.hash && source_length == other.source_length;
+    }
+  };
+  struct KeyHash {
+    size_t operator()(const Key& key) const { return key.hash; }
+  };
+  using EntryMap = std::unordered_multimap<Key, Entry, KeyHash>;
+
+  static bool CanCache(const ScriptDetails& script_details);
+  // Returns an entry with the origin of the script, but no source or data.
+  static Entry MakeOrigin(const ScriptDetails& script_details);
+  static Key MakeKey(const Entry& origin, base::Vector<const uint8_t> source);
+  void Serialize(Isolate* isolate, Handle<String> source, Entry entry,
+                 Handle<SharedFunctionInfo> toplevel);
+  void Insert(Key key, Entry entry);
+  void EvictLocked();
+
+  const size_t max_size_;
+
+  mutable base::Mutex mutex_;
+  EntryMap entries_;
+  size_t total_size_ = 0;
+  // Incremented on every use of an entry, to find the least recently used.
+  uint64_t use_counter_ = 0;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_CODEGEN_SHARED_COMPILATION_CACHE_H_
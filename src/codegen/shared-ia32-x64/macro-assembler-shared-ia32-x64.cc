@@ -704,6 +704,54 @@ void SharedTurboAssembler::I16x8Q15MulRSatS(XMMRegister dst, XMMRegister src1,
   Pxor(dst, scratch);
 }
 
+void SharedTurboAssembler::I16x8DotI8x16I7x16S(XMMRegister dst,
+                                               XMMRegister src1,
+                                               XMMRegister src2) {
+  ASM_CODE_COMMENT(this);
+  // pmaddubsw treats the first operand as unsigned. The lanes of src2 are in
+  // the 7-bit range, so they are the same whether read signed or unsigned.
+  if (CpuFeatures::IsSupported(AVX)) {
+    CpuFeatureScope avx_scope(this, AVX);
+    vpmaddubsw(dst, src2, src1);
+  } else {
+    DCHECK(dst != src1 || dst == src2);
+    CpuFeatureScope sse_scope(this, SSSE3);
+    if (dst != src2) {
+      movaps(dst, src2);
+    }
+    pmaddubsw(dst, src1);
+  }
+}
+
+void SharedTurboAssembler::I32x4DotI8x16I7x16AddS(
+    XMMRegister dst, XMMRegister src1, XMMRegister src2, XMMRegister src3,
+    XMMRegister scratch, XMMRegister splat_reg) {
+  ASM_CODE_COMMENT(this);
+  DCHECK_NE(scratch, splat_reg);
+  DCHECK_NE(scratch, src1);
+  DCHECK_NE(scratch, src3);
+  // k = i16x8.splat(1)
+  Pcmpeqd(splat_reg, splat_reg);
+  Psrlw(splat_reg, splat_reg, byte{15});
+
+  // scratch = |a*b + c*d| ... (i16x8), then add adjacent pairs (i32x4).
+  if (CpuFeatures::IsSupported(AVX)) {
+    CpuFeatureScope avx_scope(this, AVX);
+    vpmaddubsw(scratch, src2, src1);
+  } else {
+    CpuFeatureScope sse_scope(this, SSSE3);
+    movaps(scratch, src2);
+    pmaddubsw(scratch, src1);
+  }
+  Pmaddwd(scratch, splat_reg);
+
+  if (!CpuFeatures::IsSupported(AVX) && (dst != src3)) {
+    movaps(dst, src3);
+    src3 = dst;
+  }
+  Paddd(dst, src3, scratch);
+}
+
 void SharedTurboAssembler::I32x4ExtAddPairwiseI16x8U(XMMRegister dst,
                                                      XMMRegister src,
                                                      XMMRegister tmp) {
@@ -4,7 +4,9 @@
 
 #include "src/compiler-dispatcher/lazy-compile-dispatcher.h"
 
+#include <algorithm>
 #include <atomic>
+#include <unordered_map>
 
 #include "include/v8-platform.h"
 #include "src/ast/ast.h"
@@ -23,6 +25,7 @@
 #include "src/objects/objects-inl.h"
 #include "src/parsing/parse-info.h"
 #include "src/parsing/parser.h"
+#include "src/parsing/scanner-character-streams.h"
 #include "src/roots/roots.h"
 #include "src/sandbox/external-pointer.h"
 #include "src/tasks/cancelable-task.h"
@@ -57,8 +60,11 @@ class LazyCompileDispatcher::JobTask : public v8::JobTask {
   LazyCompileDispatcher* lazy_compile_dispatcher_;
 };
 
-LazyCompileDispatcher::Job::Job(std::unique_ptr<BackgroundCompileTask> task)
-    : task(std::move(task)), state(Job::State::kPending) {}
+LazyCompileDispatcher::Job::Job(std::unique_ptr<BackgroundCompileTask> task,
+                                int script_id)
+    : task(std::move(task)),
+      state(Job::State::kPending),
+      script_id(script_id) {}
 
 LazyCompileDispatcher::Job::~Job() = default;
 
@@ -157,9 +163,11 @@ void LazyCompileDispatcher::Enqueue(
   RCS_SCOPE(isolate, RuntimeCallCounterId::kCompileEnqueueOnDispatcher);
 
   Job* job = new Job(std::make_unique<BackgroundCompileTask>(
-      isolate_, shared_info, std::move(character_stream),
-      worker_thread_runtime_call_stats_, background_compile_timer_,
-      static_cast<int>(max_stack_size_)));
+                         isolate_, shared_info, std::move(character_stream),
+                         worker_thread_runtime_call_stats_,
+                         background_compile_timer_,
+                         static_cast<int>(max_stack_size_)),
+                     Script::cast(shared_info->script()).id());
 
   SetUncompiledDataJobPointer(isolate, shared_info,
                               reinterpret_cast<Address>(job));
@@ -481,6 +489,12 @@ LazyCompileDispatcher::Job* LazyCompileDispatcher::PopSingleFinalizeJob() {
 
   Job* job = finalizable_jobs_.back();
   finalizable_jobs_.pop_back();
+  StartFinalizingJob(job, lock);
+  return job;
+}
+
+void LazyCompileDispatcher::StartFinalizingJob(Job* job,
+                                               const base::MutexGuard&) {
   DCHECK(job->state == Job::State::kReadyToFinalize ||
          job->state == Job::State::kAborted);
   if (job->state == Job::State::kReadyToFinalize) {
@@ -489,7 +503,6 @@ LazyCompileDispatcher::Job* LazyCompileDispatcher::PopSingleFinalizeJob() {
     DCHECK_EQ(job->state, Job::State::kAborted);
     job->state = Job::State::kAbortingNow;
   }
-  return job;
 }
 
 bool LazyCompileDispatcher::FinalizeSingleJob() {
@@ -499,7 +512,11 @@ bool LazyCompileDispatcher::FinalizeSingleJob() {
   if (trace_compiler_dispatcher_) {
     PrintF("LazyCompileDispatcher: idle finalizing job\n");
   }
+  FinalizeJob(job);
+  return true;
+}
 
+void LazyCompileDispatcher::FinalizeJob(Job* job) {
   if (job->state == Job::State::kFinalizingNow) {
     HandleScope scope(isolate_);
     Compiler::FinalizeBackgroundCompileTask(job->task.get(), isolate_,
@@ -510,7 +527,77 @@ bool LazyCompileDispatcher::FinalizeSingleJob() {
   }
   job->state = Job::State::kFinalized;
   DeleteJob(job);
-  return true;
+}
+
+void LazyCompileDispatcher::FinalizeFinishedJobs(Handle<Script> script) {
+  TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.compile"),
+               "V8.LazyCompilerDispatcherFinalizeFinishedJobs");
+  const int script_id = script->id();
+  std::vector<Job*> jobs;
+  {
+    base::MutexGuard lock(&mutex_);
+    auto script_jobs = std::stable_partition(
+        finalizable_jobs_.begin(), finalizable_jobs_.end(),
+        [=](Job* job) { return job->script_id != script_id; });
+    jobs.assign(script_jobs, finalizable_jobs_.end());
+    finalizable_jobs_.erase(script_jobs, finalizable_jobs_.end());
+    for (Job* job : jobs) StartFinalizingJob(job, lock);
+  }
+
+  if (trace_compiler_dispatcher_ && !jobs.empty()) {
+    PrintF("LazyCompileDispatcher: finalizing %zu jobs of script %d\n",
+           jobs.size(), script_id);
+  }
+  for (Job* job : jobs) FinalizeJob(job);
+}
+
+namespace {
+
+// The position of a function as reported by the block coverage, i.e. the
+// position of the function token if there is one.
+int HintPosition(SharedFunctionInfo info) {
+  int position = info.function_token_position();
+  if (position == kNoSourcePosition) position = info.StartPosition();
+  return position;
+}
+
+}  // namespace
+
+void LazyCompileDispatcher::AddHotFunctionHints(
+    Handle<Script> script, const std::vector<int>& positions) {
+  DCHECK_EQ(ThreadId::Current(), isolate_->thread_id());
+  if (positions.empty()) return;
+  TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.compile"),
+               "V8.LazyCompilerDispatcherAddHotFunctionHints");
+  HandleScope scope(isolate_);
+
+  // The background tasks can only read the source if it is not on the heap.
+  Handle<String> source(String::cast(script->source()), isolate_);
+  if (!source->IsExternalString()) return;
+
+  // Map the positions of the uncompiled functions to their
+  // SharedFunctionInfos in a single walk over the script.
+  std::unordered_map<int, Handle<SharedFunctionInfo>> uncompiled_functions;
+  SharedFunctionInfo::ScriptIterator iterator(isolate_, *script);
+  for (SharedFunctionInfo info = iterator.Next(); !info.is_null();
+       info = iterator.Next()) {
+    if (info.is_toplevel() || !info.HasUncompiledData()) continue;
+    uncompiled_functions.emplace(HintPosition(info), handle(info, isolate_));
+  }
+
+  LocalIsolate* local_isolate = isolate_->main_thread_local_isolate();
+  for (int position : positions) {
+    auto it = uncompiled_functions.find(position);
+    if (it == uncompiled_functions.end()) continue;
+    Handle<SharedFunctionInfo> shared = it->second;
+    // Duplicate hints map to the same function.
+    uncompiled_functions.erase(it);
+    if (IsEnqueued(shared)) continue;
+    std::unique_ptr<Utf16CharacterStream> stream(
+        ScannerStream::For(isolate_, source));
+    DCHECK(!stream->can_access_heap());
+    Enqueue(local_isolate, shared, std::move(stream));
+  }
 }
 
 void LazyCompileDispatcher::DoIdleWork(double deadline_in_seconds) {
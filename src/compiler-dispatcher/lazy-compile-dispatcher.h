@@ -9,6 +9,7 @@
 #include <memory>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "src/base/atomic-utils.h"
 #include "src/base/macros.h"
@@ -39,6 +40,7 @@ class FunctionLiteral;
 class Isolate;
 class ParseInfo;
 class ProducedPreparseData;
+class Script;
 class SharedFunctionInfo;
 class TimedHistogram;
 class Utf16CharacterStream;
@@ -100,10 +102,24 @@ class V8_EXPORT_PRIVATE LazyCompileDispatcher {
   // Aborts all jobs, blocking until all jobs are aborted.
   void AbortAll();
 
+  // Finalizes the jobs for functions of {script} that finished on a
+  // background thread, without waiting for the jobs that are still pending or
+  // running. Jobs of other scripts are left to idle time.
+  void FinalizeFinishedJobs(Handle<Script> script);
+
+  // Enqueues the functions of {script} at the given start positions which are
+  // not compiled yet, e.g. because they ran in a previous session. The hints
+  // are resolved right away and not kept: positions of functions that do not
+  // have a SharedFunctionInfo yet, such as functions nested in lazy functions,
+  // are ignored.
+  void AddHotFunctionHints(Handle<Script> script,
+                           const std::vector<int>& positions);
+
  private:
   FRIEND_TEST(LazyCompileDispatcherTest, IdleTaskNoIdleTime);
   FRIEND_TEST(LazyCompileDispatcherTest, IdleTaskSmallIdleTime);
   FRIEND_TEST(LazyCompileDispatcherTest, FinishNowWithWorkerTask);
+  FRIEND_TEST(LazyCompileDispatcherTest, FinalizeFinishedJobs);
   FRIEND_TEST(LazyCompileDispatcherTest, AbortJobNotStarted);
   FRIEND_TEST(LazyCompileDispatcherTest, AbortJobAlreadyStarted);
   FRIEND_TEST(LazyCompileDispatcherTest, AsyncAbortAllPendingWorkerTask);
@@ -140,7 +156,7 @@ class V8_EXPORT_PRIVATE LazyCompileDispatcher {
       kFinalized,
     };
 
-    explicit Job(std::unique_ptr<BackgroundCompileTask> task);
+    Job(std::unique_ptr<BackgroundCompileTask> task, int script_id);
     ~Job();
 
     bool is_running_on_background() const {
@@ -149,6 +165,8 @@ class V8_EXPORT_PRIVATE LazyCompileDispatcher {
 
     std::unique_ptr<BackgroundCompileTask> task;
     State state = State::kPending;
+    // The id of the script of the function compiled by this job.
+    const int script_id;
   };
 
   using SharedToJobMap = IdentityMap<Job*, FreeStoreAllocationPolicy>;
@@ -157,6 +175,10 @@ class V8_EXPORT_PRIVATE LazyCompileDispatcher {
   Job* GetJobFor(Handle<SharedFunctionInfo> shared,
                  const base::MutexGuard&) const;
   Job* PopSingleFinalizeJob();
+  // Marks a job popped off the finalizable task queue as being finalized or
+  // aborted now.
+  void StartFinalizingJob(Job* job, const base::MutexGuard&);
+  void FinalizeJob(Job* job);
   void ScheduleIdleTaskFromAnyThread(const base::MutexGuard&);
   bool FinalizeSingleJob();
   void DoBackgroundWork(JobDelegate* delegate);
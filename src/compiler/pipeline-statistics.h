@@ -32,6 +32,9 @@ class PipelineStatistics : public Malloced {
   void BeginPhaseKind(const char* phase_kind_name);
   void EndPhaseKind();
 
+  // Records that {phase_name} was skipped because the graph is huge.
+  void RecordSkippedPhase(const char* phase_name);
+
   // We log detailed phase information about the pipeline
   // in both the v8.turbofan and the v8.wasm.turbofan categories.
   static constexpr char kTraceCategory[] =
@@ -81,8 +81,11 @@
 #include "src/compiler/turboshaft/graph-builder.h"
 #include "src/compiler/turboshaft/graph-visualizer.h"
 #include "src/compiler/turboshaft/graph.h"
+#include "src/compiler/turboshaft/load-elimination-assembler.h"
+#include "src/compiler/turboshaft/machine-optimization-assembler.h"
 #include "src/compiler/turboshaft/optimization-phase.h"
 #include "src/compiler/turboshaft/recreate-schedule.h"
+#include "src/compiler/turboshaft/value-numbering-assembler.h"
 #include "src/compiler/type-narrowing-reducer.h"
 #include "src/compiler/typed-optimization.h"
 #include "src/compiler/typer.h"
@@ -339,6 +342,9 @@ class PipelineData {
   bool verify_graph() const { return verify_graph_; }
   void set_verify_graph(bool value) { verify_graph_ = value; }
 
+  bool is_huge_graph() const { return is_huge_graph_; }
+  void set_is_huge_graph() { is_huge_graph_ = true; }
+
   MaybeHandle<Code> code() { return code_; }
   void set_code(MaybeHandle<Code> code) {
     DCHECK(code_.is_null());
@@ -626,6 +632,7 @@ class PipelineData {
   ZoneStats* const zone_stats_;
   PipelineStatistics* pipeline_statistics_ = nullptr;
   bool verify_graph_ = false;
+  bool is_huge_graph_ = false;
   int start_source_position_ = kNoSourcePosition;
   base::Optional<OsrHelper> osr_helper_;
   MaybeHandle<Code> code_;
@@ -726,6 +733,9 @@ class PipelineImpl final {
 
   void VerifyGeneratedCodeIsIdempotent();
   void RunPrintAndVerify(const char* phase, bool untyped = false);
+  // Returns true if the expensive phase {phase_name} should be skipped to
+  // bound compile time and memory for huge graphs.
+  bool SkipExpensivePhase(const char* phase_name);
   bool SelectInstructionsAndAssemble(CallDescriptor* call_descriptor);
   MaybeHandle<Code> GenerateCode(CallDescriptor* call_descriptor);
   void AllocateRegistersForTopTier(const RegisterConfiguration* config,
@@ -2043,7 +2053,10 @@ struct OptimizeTurboshaftPhase {
   void Run(PipelineData* data, Zone* temp_zone) {
     turboshaft::OptimizationPhase<
         turboshaft::LivenessAnalyzer,
-        turboshaft::Assembler>::Run(&data->turboshaft_graph(), temp_zone);
+        turboshaft::MachineOptimizationAssembler<
+            turboshaft::ValueNumberingAssembler<
+                turboshaft::LoadEliminationAssembler<turboshaft::Assembler>>>>::
+        Run(&data->turboshaft_graph(), temp_zone);
   }
 };
 
@@ -2247,11 +2260,10 @@ struct CsaOptimizationPhase {
 struct ComputeSchedulePhase {
   DECL_PIPELINE_PHASE_CONSTANTS(Scheduling)
 
-  void Run(PipelineData* data, Zone* temp_zone) {
+  void Run(PipelineData* data, Zone* temp_zone, bool splitting) {
     Schedule* schedule = Scheduler::ComputeSchedule(
         temp_zone, data->graph(),
-        data->info()->splitting() ? Scheduler::kSplitNodes
-                                  : Scheduler::kNoFlags,
+        splitting ? Scheduler::kSplitNodes : Scheduler::kNoFlags,
         &data->info()->tick_counter(), data->profile_data());
     data->set_schedule(schedule);
   }
@@ -2842,7 +2854,8 @@ bool PipelineImpl::OptimizeGraph(Linkage* linkage) {
   Run<TypedLoweringPhase>();
   RunPrintAndVerify(TypedLoweringPhase::phase_name());
 
-  if (data->info()->loop_peeling()) {
+  if (data->info()->loop_peeling() &&
+      !SkipExpensivePhase(LoopPeelingPhase::phase_name())) {
     Run<LoopPeelingPhase>();
     RunPrintAndVerify(LoopPeelingPhase::phase_name(), true);
   } else {
@@ -2856,7 +2869,8 @@ bool PipelineImpl::OptimizeGraph(Linkage* linkage) {
   }
   data->DeleteTyper();
 
-  if (FLAG_turbo_escape) {
+  if (FLAG_turbo_escape &&
+      !SkipExpensivePhase(EscapeAnalysisPhase::phase_name())) {
     Run<EscapeAnalysisPhase>();
     RunPrintAndVerify(EscapeAnalysisPhase::phase_name());
   }
@@ -2907,7 +2921,8 @@ bool PipelineImpl::OptimizeGraph(Linkage* linkage) {
   Run<EffectControlLinearizationPhase>();
   RunPrintAndVerify(EffectControlLinearizationPhase::phase_name(), true);
 
-  if (FLAG_turbo_store_elimination) {
+  if (FLAG_turbo_store_elimination &&
+      !SkipExpensivePhase(StoreStoreEliminationPhase::phase_name())) {
     Run<StoreStoreEliminationPhase>();
     RunPrintAndVerify(StoreStoreEliminationPhase::phase_name(), true);
   }
@@ -2927,9 +2942,11 @@ bool PipelineImpl::OptimizeGraph(Linkage* linkage) {
 
   // Run value numbering and machine operator reducer to optimize load/store
   // address computation (in particular, reuse the address computation whenever
-  // possible).
-  Run<MachineOperatorOptimizationPhase>();
-  RunPrintAndVerify(MachineOperatorOptimizationPhase::phase_name(), true);
+  // possible). With Turboshaft, this is done by OptimizeTurboshaftPhase below.
+  if (!FLAG_turboshaft) {
+    Run<MachineOperatorOptimizationPhase>();
+    RunPrintAndVerify(MachineOperatorOptimizationPhase::phase_name(), true);
+  }
 
   Run<DecompressionOptimizationPhase>();
   RunPrintAndVerify(DecompressionOptimizationPhase::phase_name(), true);
@@ -3544,13 +3561,48 @@ void Pipeline::AllocateRegistersForTesting(const RegisterConfiguration* config,
   }
 }
 
+bool PipelineImpl::SkipExpensivePhase(const char* phase_name) {
+  PipelineData* data = this->data_;
+  if (!FLAG_turbo_skip_expensive_phases_for_huge_graphs) return false;
+  // Builtins and stubs are compiled ahead of time or are small, and must not
+  // get slower code because a huge one was generated.
+  CodeKind kind = data->info()->code_kind();
+  if (kind != CodeKind::TURBOFAN && kind != CodeKind::WASM_FUNCTION) {
+    return false;
+  }
+  if (!data->is_huge_graph()) {
+    // Graphs only grow during optimization, so once a graph is considered
+    // huge, all remaining expensive phases are skipped as well.
+    size_t node_limit = static_cast<size_t>(FLAG_turbo_huge_graph_node_limit);
+    size_t zone_limit = FLAG_turbo_huge_graph_zone_limit_mb * MB;
+    if (data->graph()->NodeCount() <= node_limit &&
+        data->zone_stats()->GetCurrentAllocatedBytes() <= zone_limit) {
+      return false;
+    }
+    data->set_is_huge_graph();
+  }
+  if (FLAG_trace_turbo_huge_graphs) {
+    std::unique_ptr<char[]> debug_name = data->info()->GetDebugName();
+    PrintF("[huge graph: skipping %s for %s]\n", phase_name,
+           debug_name.get());
+  }
+  if (data->pipeline_statistics() != nullptr) {
+    data->pipeline_statistics()->RecordSkippedPhase(phase_name);
+  }
+  return true;
+}
+
 void PipelineImpl::ComputeScheduledGraph() {
   PipelineData* data = this->data_;
 
   // We should only schedule the graph if it is not scheduled yet.
   DCHECK_NULL(data->schedule());
 
-  Run<ComputeSchedulePhase>();
+  // Node splitting duplicates nodes into the blocks that use them, which
+  // needs repeated passes over the graph.
+  bool splitting = data->info()->splitting() &&
+                   !SkipExpensivePhase("V8.TFSchedulingNodeSplitting");
+  Run<ComputeSchedulePhase>(splitting);
   TraceScheduleAndVerify(data->info(), data, data->schedule(), "schedule");
 }
 
@@ -0,0 +1,146 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_TURBOSHAFT_LOAD_ELIMINATION_ASSEMBLER_H_
+#define V8_COMPILER_TURBOSHAFT_LOAD_ELIMINATION_ASSEMBLER_H_
+
+#include <algorithm>
+#include <type_traits>
+
+#include "src/base/logging.h"
+#include "src/codegen/machine-type.h"
+#include "src/compiler/turboshaft/graph.h"
+#include "src/compiler/turboshaft/operations.h"
+#include "src/zone/zone-containers.h"
+
+namespace v8::internal::compiler::turboshaft {
+
+// Late load elimination on the Turboshaft CFG, the counterpart of
+// `CsaLoadElimination`.
+//
+// We track the memory state along extended basic blocks, that is, a block
+// inherits the state of its predecessor if it is the only predecessor and the
+// block was bound right after it. Every other block starts with an empty
+// state. The state maps (base, kind, offset) to the value that is known to be
+// stored there. It is populated by loads and by stores of full-width values,
+// which allows to eliminate redundant loads and to forward stored values to
+// later loads. Stores kill all entries that may alias with the stored
+// location; any other operation that may write clears the whole state.
+template <class Base>
+class LoadEliminationAssembler : public Base {
+ public:
+  LoadEliminationAssembler(Graph* graph, Zone* phase_zone)
+      : Base(graph, phase_zone), state_(phase_zone) {}
+
+#define EMIT_OP(Name)                                         \
+  template <class... Args>                                    \
+  OpIndex Name(Args... args) {                                \
+    if constexpr (std::is_same_v<Name##Op, LoadOp>) {         \
+      return ReduceLoad(args...);                             \
+    } else if constexpr (std::is_same_v<Name##Op, StoreOp>) { \
+      return ReduceStore(args...);                            \
+    } else {                                                  \
+      if constexpr (Name##Op::properties.can_write) {         \
+        state_.clear();                                       \
+      }                                                       \
+      return Base::Name(args...);                             \
+    }                                                         \
+  }
+  TURBOSHAFT_OPERATION_LIST(EMIT_OP)
+#undef EMIT_OP
+
+  bool Bind(Block* block) {
+    if (!Base::Bind(block)) return false;
+    // Only a block that directly follows its unique predecessor can inherit
+    // its state. Loop headers always have a second predecessor: the backedge.
+    bool inherits_state = !block->IsLoop() &&
+                          block->LastPredecessor() == state_block_ &&
+                          block->LastPredecessor() != nullptr &&
+                          block->LastPredecessor()->NeighboringPredecessor() ==
+                              nullptr;
+    if (!inherits_state) state_.clear();
+    state_block_ = block;
+    return true;
+  }
+
+ private:
+  // The maximal number of tracked memory locations. This keeps the linear
+  // lookups cheap; locations are rarely reused further apart.
+  static constexpr size_t kMaxTrackedLocations = 32;
+
+  struct KnownValue {
+    OpIndex base;
+    LoadOp::Kind kind;
+    int32_t offset;
+    MachineRepresentation rep;
+    OpIndex value;
+  };
+
+  OpIndex ReduceLoad(OpIndex base, LoadOp::Kind kind, MachineType loaded_rep,
+                     int32_t offset) {
+    for (const KnownValue& known : state_) {
+      if (known.base == base && known.kind == kind && known.offset == offset &&
+          known.rep == loaded_rep.representation()) {
+        return known.value;
+      }
+    }
+    OpIndex result = Base::Load(base, kind, loaded_rep, offset);
+    if (IsForwardable(loaded_rep.representation())) {
+      Record({base, kind, offset, loaded_rep.representation(), result});
+    }
+    return result;
+  }
+
+  OpIndex ReduceStore(OpIndex base, OpIndex value, StoreOp::Kind kind,
+                      MachineRepresentation stored_rep,
+                      WriteBarrierKind write_barrier, int32_t offset) {
+    OpIndex result =
+        Base::Store(base, value, kind, stored_rep, write_barrier, offset);
+    int32_t size = ElementSizeInBytes(stored_rep);
+    auto may_alias = [&](const KnownValue& known) {
+      // Different base pointers can refer to the same object, so only
+      // accesses to disjoint ranges relative to the same base are known not to
+      // alias.
+      if (known.base != base || known.kind != kind) return true;
+      int32_t known_size = ElementSizeInBytes(known.rep);
+      return known.offset < offset + size && offset < known.offset + known_size;
+    };
+    state_.erase(std::remove_if(state_.begin(), state_.end(), may_alias),
+                 state_.end());
+    if (IsForwardable(stored_rep)) {
+      Record({base, kind, offset, stored_rep, value});
+    }
+    return result;
+  }
+
+  void Record(KnownValue known) {
+    if (state_.size() == kMaxTrackedLocations) state_.erase(state_.begin());
+    state_.push_back(known);
+  }
+
+  // Narrow loads sign- or zero-extend the loaded value, so a stored value can
+  // only be forwarded if it fills the whole memory location.
+  static bool IsForwardable(MachineRepresentation rep) {
+    switch (rep) {
+      case MachineRepresentation::kWord32:
+      case MachineRepresentation::kWord64:
+      case MachineRepresentation::kFloat32:
+      case MachineRepresentation::kFloat64:
+      case MachineRepresentation::kTaggedSigned:
+      case MachineRepresentation::kTaggedPointer:
+      case MachineRepresentation::kTagged:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  ZoneVector<KnownValue> state_;
+  // The block whose state is currently tracked in `state_`.
+  Block* state_block_ = nullptr;
+};
+
+}  // namespace v8::internal::compiler::turboshaft
+
+#endif  // V8_COMPILER_TURBOSHAFT_LOAD_ELIMINATION_ASSEMBLER_H_
@@ -0,0 +1,373 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_TURBOSHAFT_MACHINE_OPTIMIZATION_ASSEMBLER_H_
+#define V8_COMPILER_TURBOSHAFT_MACHINE_OPTIMIZATION_ASSEMBLER_H_
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+#include "src/base/bits.h"
+#include "src/base/logging.h"
+#include "src/base/optional.h"
+#include "src/codegen/machine-type.h"
+#include "src/compiler/turboshaft/assembler.h"
+#include "src/compiler/turboshaft/operations.h"
+
+namespace v8::internal::compiler::turboshaft {
+
+// Constant folding and simple algebraic simplifications of machine-level
+// operations. This covers the subset of `MachineOperatorReducer` that matters
+// for address computations and for the code produced by lowering, but works
+// directly on the Turboshaft graph while it is being copied.
+template <class Base>
+class MachineOptimizationAssembler
+    : public AssemblerInterface<MachineOptimizationAssembler<Base>, Base> {
+ public:
+  using Next = AssemblerInterface<MachineOptimizationAssembler<Base>, Base>;
+  using Next::Next;
+
+  OpIndex Binop(OpIndex left, OpIndex right, BinopOp::Kind kind,
+                MachineRepresentation rep) {
+    using Kind = BinopOp::Kind;
+    if (rep == MachineRepresentation::kWord32 ||
+        rep == MachineRepresentation::kWord64) {
+      // Canonicalize constants to the right.
+      if (BinopOp::IsCommutative(kind) && IsWordConstant(left, rep) &&
+          !IsWordConstant(right, rep)) {
+        std::swap(left, right);
+      }
+      uint64_t k1, k2;
+      if (MatchWordConstant(left, rep, &k1) &&
+          MatchWordConstant(right, rep, &k2)) {
+        if (rep == MachineRepresentation::kWord32) {
+          if (base::Optional<uint32_t> result =
+                  FoldWord32Binop(static_cast<uint32_t>(k1),
+                                  static_cast<uint32_t>(k2), kind)) {
+            return this->Word32Constant(*result);
+          }
+        } else {
+          if (base::Optional<uint64_t> result = FoldWord64Binop(k1, k2, kind)) {
+            return this->Word64Constant(*result);
+          }
+        }
+      }
+      uint64_t all_ones = rep == MachineRepresentation::kWord32
+                              ? uint64_t{std::numeric_limits<uint32_t>::max()}
+                              : std::numeric_limits<uint64_t>::max();
+      if (MatchWordConstant(right, rep, &k2)) {
+        switch (kind) {
+          case Kind::kAdd:
+          case Kind::kSub:
+          case Kind::kBitwiseOr:
+          case Kind::kBitwiseXor:
+            // x op 0 => x
+            if (k2 == 0) return left;
+            break;
+          case Kind::kMul:
+            // x * 0 => 0
+            if (k2 == 0) return right;
+            // x * 1 => x
+            if (k2 == 1) return left;
+            break;
+          case Kind::kBitwiseAnd:
+            // x & 0 => 0
+            if (k2 == 0) return right;
+            // x & -1 => x
+            if (k2 == all_ones) return left;
+            break;
+          default:
+            break;
+        }
+        // x | -1 => -1
+        if (kind == Kind::kBitwiseOr && k2 == all_ones) return right;
+      }
+      if (left == right) {
+        switch (kind) {
+          case Kind::kBitwiseAnd:
+          case Kind::kBitwiseOr:
+            // x & x => x, x | x => x
+            return left;
+          case Kind::kSub:
+          case Kind::kBitwiseXor:
+            // x - x => 0, x ^ x => 0
+            return this->IntegralConstant(0, rep);
+          default:
+            break;
+        }
+      }
+    } else if (rep == MachineRepresentation::kFloat64) {
+      double k1, k2;
+      if (MatchFloat64Constant(left, &k1) && MatchFloat64Constant(right, &k2)) {
+        switch (kind) {
+          case Kind::kAdd:
+            return this->Float64Constant(k1 + k2);
+          case Kind::kSub:
+            return this->Float64Constant(k1 - k2);
+          case Kind::kMul:
+            return this->Float64Constant(k1 * k2);
+          default:
+            break;
+        }
+      }
+    }
+    return Base::Binop(left, right, kind, rep);
+  }
+
+  OpIndex Shift(OpIndex left, OpIndex right, ShiftOp::Kind kind,
+                MachineRepresentation rep) {
+    using Kind = ShiftOp::Kind;
+    uint64_t k1, k2;
+    if (MatchShiftAmount(right, &k2)) {
+      if (rep == MachineRepresentation::kWord32) {
+        uint32_t shift = static_cast<uint32_t>(k2) & 0x1F;
+        // x op 0 => x
+        if (shift == 0) return left;
+        if (MatchWordConstant(left, rep, &k1)) {
+          uint32_t value = static_cast<uint32_t>(k1);
+          switch (kind) {
+            case Kind::kShiftLeft:
+              return this->Word32Constant(value << shift);
+            case Kind::kShiftRightLogical:
+              return this->Word32Constant(value >> shift);
+            case Kind::kShiftRightArithmetic:
+            case Kind::kShiftRightArithmeticShiftOutZeros:
+              return this->Word32Constant(
+                  static_cast<uint32_t>(static_cast<int32_t>(value) >> shift));
+            case Kind::kRotateRight:
+              return this->Word32Constant(
+                  base::bits::RotateRight32(value, shift));
+            case Kind::kRotateLeft:
+              return this->Word32Constant(
+                  base::bits::RotateLeft32(value, shift));
+          }
+        }
+      } else if (rep == MachineRepresentation::kWord64) {
+        uint64_t shift = k2 & 0x3F;
+        if (shift == 0) return left;
+        if (MatchWordConstant(left, rep, &k1)) {
+          switch (kind) {
+            case Kind::kShiftLeft:
+              return this->Word64Constant(k1 << shift);
+            case Kind::kShiftRightLogical:
+              return this->Word64Constant(k1 >> shift);
+            case Kind::kShiftRightArithmetic:
+            case Kind::kShiftRightArithmeticShiftOutZeros:
+              return this->Word64Constant(
+                  static_cast<uint64_t>(static_cast<int64_t>(k1) >> shift));
+            case Kind::kRotateRight:
+              return this->Word64Constant(base::bits::RotateRight64(k1, shift));
+            case Kind::kRotateLeft:
+              return this->Word64Constant(base::bits::RotateLeft64(k1, shift));
+          }
+        }
+      }
+    }
+    return Base::Shift(left, right, kind, rep);
+  }
+
+  OpIndex Equal(OpIndex left, OpIndex right, MachineRepresentation rep) {
+    if (rep == MachineRepresentation::kWord32 ||
+        rep == MachineRepresentation::kWord64) {
+      // x == x => true
+      if (left == right) return this->Word32Constant(1);
+      uint64_t k1, k2;
+      if (MatchWordConstant(left, rep, &k1) &&
+          MatchWordConstant(right, rep, &k2)) {
+        return this->Word32Constant(k1 == k2);
+      }
+    } else if (rep == MachineRepresentation::kFloat64) {
+      double k1, k2;
+      if (MatchFloat64Constant(left, &k1) && MatchFloat64Constant(right, &k2)) {
+        return this->Word32Constant(k1 == k2);
+      }
+    }
+    return Base::Equal(left, right, rep);
+  }
+
+  OpIndex Comparison(OpIndex left, OpIndex right, ComparisonOp::Kind kind,
+                     MachineRepresentation rep) {
+    using Kind = ComparisonOp::Kind;
+    if (rep == MachineRepresentation::kWord32 ||
+        rep == MachineRepresentation::kWord64) {
+      if (left == right) {
+        // x < x => false, x <= x => true
+        return this->Word32Constant(kind == Kind::kSignedLessThanOrEqual ||
+                                    kind == Kind::kUnsignedLessThanOrEqual);
+      }
+      uint64_t k1, k2;
+      if (MatchWordConstant(left, rep, &k1) &&
+          MatchWordConstant(right, rep, &k2)) {
+        int64_t s1, s2;
+        if (rep == MachineRepresentation::kWord32) {
+          s1 = static_cast<int32_t>(k1);
+          s2 = static_cast<int32_t>(k2);
+        } else {
+          s1 = static_cast<int64_t>(k1);
+          s2 = static_cast<int64_t>(k2);
+        }
+        switch (kind) {
+          case Kind::kSignedLessThan:
+            return this->Word32Constant(s1 < s2);
+          case Kind::kSignedLessThanOrEqual:
+            return this->Word32Constant(s1 <= s2);
+          case Kind::kUnsignedLessThan:
+            return this->Word32Constant(k1 < k2);
+          case Kind::kUnsignedLessThanOrEqual:
+            return this->Word32Constant(k1 <= k2);
+        }
+      }
+    }
+    return Base::Comparison(left, right, kind, rep);
+  }
+
+  OpIndex Change(OpIndex input, ChangeOp::Kind kind,
+                 MachineRepresentation from, MachineRepresentation to) {
+    using Kind = ChangeOp::Kind;
+    uint64_t k;
+    if (from == MachineRepresentation::kWord32 &&
+        MatchWordConstant(input, from, &k)) {
+      uint32_t value = static_cast<uint32_t>(k);
+      if (to == MachineRepresentation::kWord64) {
+        if (kind == Kind::kZeroExtend) {
+          return this->Word64Constant(uint64_t{value});
+        }
+        if (kind == Kind::kSignExtend) {
+          return this->Word64Constant(
+              static_cast<uint64_t>(int64_t{static_cast<int32_t>(value)}));
+        }
+      } else if (to == MachineRepresentation::kFloat64) {
+        if (kind == Kind::kSignedToFloat) {
+          return this->Float64Constant(
+              static_cast<double>(static_cast<int32_t>(value)));
+        }
+        if (kind == Kind::kUnsignedToFloat) {
+          return this->Float64Constant(static_cast<double>(value));
+        }
+      }
+    } else if (from == MachineRepresentation::kWord64 &&
+               to == MachineRepresentation::kWord32 &&
+               kind == Kind::kIntegerTruncate) {
+      if (MatchWordConstant(input, from, &k)) {
+        return this->Word32Constant(static_cast<uint32_t>(k));
+      }
+      // Truncating an extended value yields the original value.
+      const Operation& op = this->graph().Get(input);
+      if (const ChangeOp* change = op.TryCast<ChangeOp>()) {
+        if ((change->kind == Kind::kZeroExtend ||
+             change->kind == Kind::kSignExtend) &&
+            change->from == MachineRepresentation::kWord32 &&
+            change->to == MachineRepresentation::kWord64) {
+          return change->input();
+        }
+      }
+    }
+    return Base::Change(input, kind, from, to);
+  }
+
+ private:
+  bool IsWordConstant(OpIndex index, MachineRepresentation rep) {
+    uint64_t unused;
+    return MatchWordConstant(index, rep, &unused);
+  }
+
+  bool MatchWordConstant(OpIndex index, MachineRepresentation rep,
+                         uint64_t* value) {
+    const ConstantOp* constant =
+        this->graph().Get(index).template TryCast<ConstantOp>();
+    if (constant == nullptr) return false;
+    if (rep == MachineRepresentation::kWord32 &&
+        constant->kind == ConstantOp::Kind::kWord32) {
+      *value = constant->word32();
+      return true;
+    }
+    if (rep == MachineRepresentation::kWord64 &&
+        constant->kind == ConstantOp::Kind::kWord64) {
+      *value = constant->word64();
+      return true;
+    }
+    return false;
+  }
+
+  // Shift amounts are masked, so both 32- and 64-bit constants are accepted.
+  bool MatchShiftAmount(OpIndex index, uint64_t* value) {
+    return MatchWordConstant(index, MachineRepresentation::kWord32, value) ||
+           MatchWordConstant(index, MachineRepresentation::kWord64, value);
+  }
+
+  bool MatchFloat64Constant(OpIndex index, double* value) {
+    const ConstantOp* constant =
+        this->graph().Get(index).template TryCast<ConstantOp>();
+    if (constant == nullptr || constant->kind != ConstantOp::Kind::kFloat64) {
+      return false;
+    }
+    *value = constant->float64();
+    return true;
+  }
+
+  static base::Optional<uint32_t> FoldWord32Binop(uint32_t k1, uint32_t k2,
+                                                  BinopOp::Kind kind) {
+    using Kind = BinopOp::Kind;
+    switch (kind) {
+      case Kind::kAdd:
+        return k1 + k2;
+      case Kind::kSub:
+        return k1 - k2;
+      case Kind::kMul:
+        return k1 * k2;
+      case Kind::kBitwiseAnd:
+        return k1 & k2;
+      case Kind::kBitwiseOr:
+        return k1 | k2;
+      case Kind::kBitwiseXor:
+        return k1 ^ k2;
+      case Kind::kSignedDiv:
+        return static_cast<uint32_t>(base::bits::SignedDiv32(
+            static_cast<int32_t>(k1), static_cast<int32_t>(k2)));
+      case Kind::kUnsignedDiv:
+        return base::bits::UnsignedDiv32(k1, k2);
+      case Kind::kSignedMod:
+        return static_cast<uint32_t>(base::bits::SignedMod32(
+            static_cast<int32_t>(k1), static_cast<int32_t>(k2)));
+      case Kind::kUnsignedMod:
+        return base::bits::UnsignedMod32(k1, k2);
+      default:
+        return base::nullopt;
+    }
+  }
+
+  static base::Optional<uint64_t> FoldWord64Binop(uint64_t k1, uint64_t k2,
+                                                  BinopOp::Kind kind) {
+    using Kind = BinopOp::Kind;
+    switch (kind) {
+      case Kind::kAdd:
+        return k1 + k2;
+      case Kind::kSub:
+        return k1 - k2;
+      case Kind::kMul:
+        return k1 * k2;
+      case Kind::kBitwiseAnd:
+        return k1 & k2;
+      case Kind::kBitwiseOr:
+        return k1 | k2;
+      case Kind::kBitwiseXor:
+        return k1 ^ k2;
+      case Kind::kUnsignedDiv:
+        if (k2 == 0) return base::nullopt;
+        return k1 / k2;
+      case Kind::kUnsignedMod:
+        if (k2 == 0) return base::nullopt;
+        return k1 % k2;
+      default:
+        // Signed 64-bit division is left to the backend, which knows how to
+        // handle division by zero and overflow on the target.
+        return base::nullopt;
+    }
+  }
+};
+
+}  // namespace v8::internal::compiler::turboshaft
+
+#endif  // V8_COMPILER_TURBOSHAFT_MACHINE_OPTIMIZATION_ASSEMBLER_H_
@@ -0,0 +1,191 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_TURBOSHAFT_VALUE_NUMBERING_ASSEMBLER_H_
+#define V8_COMPILER_TURBOSHAFT_VALUE_NUMBERING_ASSEMBLER_H_
+
+#include <type_traits>
+
+#include "src/base/bits.h"
+#include "src/base/logging.h"
+#include "src/codegen/source-position.h"
+#include "src/compiler/turboshaft/graph.h"
+#include "src/compiler/turboshaft/operations.h"
+#include "src/zone/zone-containers.h"
+
+namespace v8::internal::compiler::turboshaft {
+
+// Global value numbering on the Turboshaft CFG.
+//
+// Every pure operation is emitted as usual and then looked up in a hash table
+// of equivalent operations that are available at the current position. If an
+// equivalent operation exists, the freshly emitted operation is removed again
+// and the existing one is returned instead.
+//
+// An operation is available if it was emitted in a block that dominates the
+// current block. Since blocks are bound in an order where dominators come
+// first, the dominator tree can be computed incrementally when a block is
+// bound. The hash table only ever contains entries of the blocks on the path
+// from the dominator tree root to the current block: When binding a block, we
+// pop all blocks from this path that do not dominate the new block and remove
+// their entries. Entries are inserted at the head of their bucket and removed
+// in reverse insertion order, so removal is always a constant-time unlink.
+template <class Base>
+class ValueNumberingAssembler : public Base {
+ public:
+  ValueNumberingAssembler(Graph* graph, Zone* phase_zone)
+      : Base(graph, phase_zone),
+        entries_(phase_zone),
+        buckets_(kInitialBucketCount, kNoEntry, phase_zone),
+        dominator_path_(phase_zone),
+        dominators_(phase_zone),
+        depths_(phase_zone) {}
+
+#define EMIT_OP(Name)                                          \
+  template <class... Args>                                     \
+  OpIndex Name(Args... args) {                                 \
+    OpIndex next_index = this->graph().next_operation_index(); \
+    OpIndex result = Base::Name(args...);                      \
+    if (result != next_index) return result;                   \
+    return AddOrFind<Name##Op>(result);                        \
+  }
+  TURBOSHAFT_OPERATION_LIST(EMIT_OP)
+#undef EMIT_OP
+
+  bool Bind(Block* block) {
+    if (!Base::Bind(block)) return false;
+    EnterBlock(block);
+    return true;
+  }
+
+ private:
+  static constexpr int32_t kNoEntry = -1;
+  static constexpr size_t kInitialBucketCount = 256;
+
+  struct Entry {
+    OpIndex value;
+    size_t hash;
+    int32_t next_in_bucket;
+  };
+
+  struct PathElement {
+    BlockIndex block;
+    size_t entries_count;
+  };
+
+  template <class Op>
+  static constexpr bool CanBeValueNumbered() {
+    // Phis are bound to the position of their block and pending loop phis are
+    // placeholders that are replaced later.
+    return Op::properties.is_pure && !std::is_same_v<Op, PhiOp> &&
+           !std::is_same_v<Op, PendingLoopPhiOp>;
+  }
+
+  template <class Op>
+  OpIndex AddOrFind(OpIndex op_idx) {
+    if constexpr (!CanBeValueNumbered<Op>()) {
+      return op_idx;
+    } else {
+      const Op& op = this->graph().Get(op_idx).template Cast<Op>();
+      size_t hash = op.hash_value();
+      size_t bucket = hash & (buckets_.size() - 1);
+      for (int32_t i = buckets_[bucket]; i != kNoEntry;
+           i = entries_[i].next_in_bucket) {
+        const Entry& entry = entries_[i];
+        if (entry.hash != hash) continue;
+        const Operation& candidate = this->graph().Get(entry.value);
+        if (candidate.Is<Op>() && candidate.Cast<Op>() == op) {
+          // The source position of the removed operation must not leak to the
+          // next operation emitted at the same index.
+          this->graph().source_positions()[op_idx] = SourcePosition::Unknown();
+          this->graph().RemoveLast();
+          return entry.value;
+        }
+      }
+      Insert(op_idx, hash);
+      return op_idx;
+    }
+  }
+
+  void Insert(OpIndex value, size_t hash) {
+    if (V8_UNLIKELY(entries_.size() >= buckets_.size())) {
+      Rehash(buckets_.size() * 2);
+    }
+    size_t bucket = hash & (buckets_.size() - 1);
+    entries_.push_back({value, hash, buckets_[bucket]});
+    buckets_[bucket] = static_cast<int32_t>(entries_.size() - 1);
+  }
+
+  void Rehash(size_t bucket_count) {
+    DCHECK(base::bits::IsPowerOfTwo(bucket_count));
+    buckets_.assign(bucket_count, kNoEntry);
+    // Re-inserting in insertion order preserves the invariant that the most
+    // recently inserted entry of a bucket is at its head.
+    for (size_t i = 0; i < entries_.size(); ++i) {
+      size_t bucket = entries_[i].hash & (bucket_count - 1);
+      entries_[i].next_in_bucket = buckets_[bucket];
+      buckets_[bucket] = static_cast<int32_t>(i);
+    }
+  }
+
+  void RemoveEntriesUntil(size_t entries_count) {
+    while (entries_.size() > entries_count) {
+      const Entry& entry = entries_.back();
+      size_t bucket = entry.hash & (buckets_.size() - 1);
+      DCHECK_EQ(buckets_[bucket], static_cast<int32_t>(entries_.size() - 1));
+      buckets_[bucket] = entry.next_in_bucket;
+      entries_.pop_back();
+    }
+  }
+
+  void EnterBlock(Block* block) {
+    size_t id = block->index().id();
+    DCHECK_EQ(id, dominators_.size());
+    BlockIndex dominator = BlockIndex::Invalid();
+    for (Block* pred = block->LastPredecessor(); pred != nullptr;
+         pred = pred->NeighboringPredecessor()) {
+      dominator = dominator.valid()
+                      ? CommonDominator(dominator, pred->index())
+                      : pred->index();
+    }
+    dominators_.push_back(dominator);
+    depths_.push_back(dominator.valid() ? depths_[dominator.id()] + 1 : 0);
+
+    while (!dominator_path_.empty() &&
+           !Dominates(dominator_path_.back().block, block->index())) {
+      RemoveEntriesUntil(dominator_path_.back().entries_count);
+      dominator_path_.pop_back();
+    }
+    dominator_path_.push_back({block->index(), entries_.size()});
+  }
+
+  bool Dominates(BlockIndex dominator, BlockIndex block) const {
+    while (depths_[block.id()] > depths_[dominator.id()]) {
+      block = dominators_[block.id()];
+    }
+    return block == dominator;
+  }
+
+  BlockIndex CommonDominator(BlockIndex a, BlockIndex b) const {
+    while (a != b) {
+      if (depths_[a.id()] < depths_[b.id()]) {
+        b = dominators_[b.id()];
+      } else {
+        a = dominators_[a.id()];
+      }
+    }
+    return a;
+  }
+
+  ZoneVector<Entry> entries_;
+  ZoneVector<int32_t> buckets_;
+  ZoneVector<PathElement> dominator_path_;
+  // Immediate dominator and dominator tree depth of every bound block.
+  ZoneVector<BlockIndex> dominators_;
+  ZoneVector<uint32_t> depths_;
+};
+
+}  // namespace v8::internal::compiler::turboshaft
+
+#endif  // V8_COMPILER_TURBOSHAFT_VALUE_NUMBERING_ASSEMBLER_H_
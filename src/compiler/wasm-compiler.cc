@@ -3103,9 +3103,33 @@ void WasmGraphBuilder::PrepareInstanceCacheForLoop(
 #undef INTRODUCE_PHI
 }
 
+namespace {
+// Only keeps the bounds checks which were performed on both paths.
+void MergeCheckedIndices(WasmInstanceCacheNodes* to,
+                         const WasmInstanceCacheNodes* from) {
+  if (to->checked_mem_size != from->checked_mem_size) {
+    to->num_checked_indices = 0;
+    return;
+  }
+  int num_kept = 0;
+  for (int i = 0; i < to->num_checked_indices; ++i) {
+    WasmInstanceCacheNodes::CheckedIndex checked = to->checked_indices[i];
+    for (int j = 0; j < from->num_checked_indices; ++j) {
+      if (from->checked_indices[j].index != checked.index) continue;
+      checked.end_offset =
+          std::min(checked.end_offset, from->checked_indices[j].end_offset);
+      to->checked_indices[num_kept++] = checked;
+      break;
+    }
+  }
+  to->num_checked_indices = num_kept;
+}
+}  // namespace
+
 void WasmGraphBuilder::NewInstanceCacheMerge(WasmInstanceCacheNodes* to,
                                              WasmInstanceCacheNodes* from,
                                              Node* merge) {
+  MergeCheckedIndices(to, from);
 #define INTRODUCE_PHI(field, rep)                                            \
   if (to->field != from->field) {                                            \
     Node* vals[] = {to->field, from->field, merge};                          \
@@ -3120,6 +3144,7 @@ void WasmGraphBuilder::NewInstanceCacheMerge(WasmInstanceCacheNodes* to,
 void WasmGraphBuilder::MergeInstanceCacheInto(WasmInstanceCacheNodes* to,
                                               WasmInstanceCacheNodes* from,
                                               Node* merge) {
+  MergeCheckedIndices(to, from);
   to->mem_size = CreateOrMergeIntoPhi(MachineType::PointerRepresentation(),
                                       merge, to->mem_size, from->mem_size);
   to->mem_start = CreateOrMergeIntoPhi(MachineType::PointerRepresentation(),
@@ -3382,6 +3407,9 @@ WasmGraphBuilder::BoundsCheckMem(uint8_t access_size, Node* index,
                                  wasm::WasmCodePosition position,
                                  EnforceBoundsCheck enforce_check) {
   DCHECK_LE(1, access_size);
+  // Remember the index as passed in, before it gets converted below, to
+  // identify repeated checks of the same index.
+  Node* const checked_index = index;
 
   // If the offset does not fit in a uintptr_t, this can never succeed on this
   // machine.
@@ -3437,6 +3465,13 @@ WasmGraphBuilder::BoundsCheckMem(uint8_t access_size, Node* index,
     return {index, kTrapHandler};
   }
 
+  // An earlier check of the same index with at least the same end offset,
+  // against the same memory size, already guarantees this access to be in
+  // bounds.
+  if (IsKnownInBounds(checked_index, end_offset)) {
+    return {index, kDynamicallyChecked};
+  }
+
   Node* mem_size = instance_cache_->mem_size;
   Node* end_offset_node = mcgraph_->UintPtrConstant(end_offset);
   if (end_offset > env_->min_memory_size) {
@@ -3452,9 +3487,55 @@ WasmGraphBuilder::BoundsCheckMem(uint8_t access_size, Node* index,
   // Introduce the actual bounds check.
   Node* cond = gasm_->UintLessThan(index, effective_size);
   TrapIfFalse(wasm::kTrapMemOutOfBounds, cond, position);
+  RecordBoundsCheck(checked_index, end_offset);
   return {index, kDynamicallyChecked};
 }
 
+bool WasmGraphBuilder::IsKnownInBounds(Node* index, uintptr_t end_offset) {
+  if (!FLAG_wasm_bounds_check_elimination || instance_cache_ == nullptr) {
+    return false;
+  }
+  // Facts about an older memory size are not valid for the current one, e.g.
+  // after a call, a memory.grow, or at a loop header.
+  if (instance_cache_->checked_mem_size != instance_cache_->mem_size) {
+    return false;
+  }
+  for (int i = 0; i < instance_cache_->num_checked_indices; ++i) {
+    const WasmInstanceCacheNodes::CheckedIndex& checked =
+        instance_cache_->checked_indices[i];
+    if (checked.index == index) return end_offset <= checked.end_offset;
+  }
+  return false;
+}
+
+void WasmGraphBuilder::RecordBoundsCheck(Node* index, uintptr_t end_offset) {
+  if (!FLAG_wasm_bounds_check_elimination || instance_cache_ == nullptr) {
+    return;
+  }
+  WasmInstanceCacheNodes* cache = instance_cache_;
+  if (cache->checked_mem_size != cache->mem_size) {
+    cache->checked_mem_size = cache->mem_size;
+    cache->num_checked_indices = 0;
+  }
+  for (int i = 0; i < cache->num_checked_indices; ++i) {
+    WasmInstanceCacheNodes::CheckedIndex& checked = cache->checked_indices[i];
+    if (checked.index != index) continue;
+    checked.end_offset = std::max(checked.end_offset, end_offset);
+    return;
+  }
+  // Once the table is full, the oldest entry is replaced.
+  int slot = cache->num_checked_indices;
+  if (slot == WasmInstanceCacheNodes::kMaxCheckedIndices) {
+    for (int i = 1; i < slot; ++i) {
+      cache->checked_indices[i - 1] = cache->checked_indices[i];
+    }
+    --slot;
+  } else {
+    ++cache->num_checked_indices;
+  }
+  cache->checked_indices[slot] = {index, end_offset};
+}
+
 const Operator* WasmGraphBuilder::GetSafeLoadOperator(int offset,
                                                       wasm::ValueType type) {
   int alignment = offset % type.value_kind_size();
@@ -189,8 +189,20 @@ class JSWasmCallData {
 // and manipulated in wasm-compiler.{h,cc} instead of inside the Wasm decoder.
 // (Note that currently, the globals base is immutable, so not cached here.)
 struct WasmInstanceCacheNodes {
-  Node* mem_start;
-  Node* mem_size;
+  Node* mem_start = nullptr;
+  Node* mem_size = nullptr;
+
+  // Indices that were already checked dynamically against {checked_mem_size},
+  // such that all bytes up to {index + end_offset} are known to be in bounds
+  // on all paths reaching the current position.
+  struct CheckedIndex {
+    Node* index;
+    uintptr_t end_offset;
+  };
+  static constexpr int kMaxCheckedIndices = 8;
+  Node* checked_mem_size = nullptr;
+  int num_checked_indices = 0;
+  CheckedIndex checked_indices[kMaxCheckedIndices] = {};
 };
 
 struct WasmLoopInfo {
@@ -618,6 +630,12 @@ class WasmGraphBuilder {
                                                      uint64_t offset,
                                                      wasm::WasmCodePosition,
                                                      EnforceBoundsCheck);
+  // Returns whether {index + end_offset} was already checked to be in bounds
+  // on all paths to the current position. Does not record anything.
+  bool IsKnownInBounds(Node* index, uintptr_t end_offset);
+  // Records that {index + end_offset} was checked to be in bounds against the
+  // current memory size.
+  void RecordBoundsCheck(Node* index, uintptr_t end_offset);
 
   std::pair<Node*, BoundsCheckResult> CheckBoundsAndAlignment(
       int8_t access_size, Node* index, uint64_t offset, wasm::WasmCodePosition,
@@ -9,6 +9,7 @@
 #include "src/base/utils/random-number-generator.h"
 #include "src/codegen/compiler.h"
 #include "src/codegen/script-details.h"
+#include "src/compiler-dispatcher/lazy-compile-dispatcher.h"
 #include "src/date/date.h"
 #include "src/debug/debug-coverage.h"
 #include "src/debug/debug-evaluate.h"
@@ -1281,6 +1282,19 @@ void Coverage::SelectMode(Isolate* isolate, CoverageMode mode) {
   i::Coverage::SelectMode(reinterpret_cast<i::Isolate*>(isolate), mode);
 }
 
+void CompileFunctionsInBackground(Isolate* v8_isolate,
+                                  Local<UnboundScript> script,
+                                  const std::vector<int>& function_positions) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(v8_isolate);
+  i::LazyCompileDispatcher* dispatcher = isolate->lazy_compile_dispatcher();
+  if (dispatcher == nullptr) return;
+  i::HandleScope scope(isolate);
+  i::Handle<i::SharedFunctionInfo> shared = Utils::OpenHandle(*script);
+  if (!shared->script().IsScript()) return;
+  i::Handle<i::Script> i_script(i::Script::cast(shared->script()), isolate);
+  dispatcher->AddHotFunctionHints(i_script, function_positions);
+}
+
 int TypeProfile::Entry::SourcePosition() const { return entry_->position; }
 
 std::vector<MaybeLocal<String>> TypeProfile::Entry::Types() const {
@@ -6,6 +6,7 @@
 #define V8_DEBUG_DEBUG_INTERFACE_H_
 
 #include <memory>
+#include <vector>
 
 #include "include/v8-callbacks.h"
 #include "include/v8-date.h"
@@ -424,6 +425,16 @@ class V8_EXPORT_PRIVATE Coverage {
   std::shared_ptr<i::Coverage> coverage_;
 };
 
+// Compiles the functions of {script} starting at the given positions on
+// background threads, e.g. the functions that a previous session reported as
+// covered via {Coverage::FunctionData::StartOffset}. Functions nested in lazy
+// functions are skipped, since they only become known once their outer
+// function got compiled; their positions can be passed again then. Has no
+// effect without the lazy compile dispatcher, or if the source is not external.
+V8_EXPORT_PRIVATE void CompileFunctionsInBackground(
+    Isolate* isolate, Local<UnboundScript> script,
+    const std::vector<int>& function_positions);
+
 /*
  * Provide API layer between inspector and type profile.
  */
@@ -46,6 +46,11 @@ void CompilationStatistics::RecordTotalStats(const BasicStats& stats) {
   total_stats_.Accumulate(stats);
 }
 
+void CompilationStatistics::RecordSkippedPhase(const char* phase_name) {
+  base::MutexGuard guard(&record_mutex_);
+  skipped_phase_map_[phase_name]++;
+}
+
 void CompilationStatistics::BasicStats::Accumulate(const BasicStats& stats) {
   delta_ += stats.delta_;
   total_allocated_bytes_ += stats.total_allocated_bytes_;
@@ -171,6 +176,28 @@ std::ostream& operator<<(std::ostream& os, const AsPrintableStatistics& ps) {
   if (!ps.machine_output) WriteFullLine(os);
   WriteLine(os, ps.machine_output, "totals", s.total_stats_, s.total_stats_);
 
+  if (!s.skipped_phase_map_.empty()) {
+    const size_t kBufferSize = 128;
+    char buffer[kBufferSize];
+    if (!ps.machine_output) {
+      WriteFullLine(os);
+      base::OS::SNPrintF(buffer, kBufferSize, "%34s %10s\n",
+                         "Skipped for huge graphs", "Count");
+      os << buffer;
+      WriteFullLine(os);
+    }
+    for (const auto& it : s.skipped_phase_map_) {
+      if (ps.machine_output) {
+        base::OS::SNPrintF(buffer, kBufferSize, "\n\"%s_skipped\"=%zu",
+                           it.first.c_str(), it.second);
+      } else {
+        base::OS::SNPrintF(buffer, kBufferSize, "%34s %10zu\n",
+                           it.first.c_str(), it.second);
+      }
+      os << buffer;
+    }
+  }
+
   return os;
 }
 
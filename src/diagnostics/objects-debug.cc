@@ -1568,6 +1568,15 @@ void JSRegExp::JSRegExpVerify(Isolate* isolate) {
       CHECK_EQ(arr.get(JSRegExp::kIrregexpTicksUntilTierUpIndex),
                uninitialized);
       CHECK_EQ(arr.get(JSRegExp::kIrregexpBacktrackLimit), uninitialized);
+      CHECK_EQ(arr.get(JSRegExp::kIrregexpPrefilterIndex), uninitialized);
+      CHECK_EQ(arr.get(JSRegExp::kIrregexpPrefilterOffsetIndex),
+               uninitialized);
+      CHECK_EQ(arr.get(JSRegExp::kIrregexpLatin1CaptureFreeCodeIndex),
+               uninitialized);
+      CHECK_EQ(arr.get(JSRegExp::kIrregexpUC16CaptureFreeCodeIndex),
+               uninitialized);
+      Object dfa = arr.get(JSRegExp::kExperimentalDfaIndex);
+      CHECK(dfa == uninitialized || (is_compiled && dfa.IsForeign()));
       break;
     }
     case JSRegExp::IRREGEXP: {
@@ -1605,6 +1614,27 @@ void JSRegExp::JSRegExpVerify(Isolate* isolate) {
       CHECK(arr.get(JSRegExp::kIrregexpMaxRegisterCountIndex).IsSmi());
       CHECK(arr.get(JSRegExp::kIrregexpTicksUntilTierUpIndex).IsSmi());
       CHECK(arr.get(JSRegExp::kIrregexpBacktrackLimit).IsSmi());
+
+      // Smi : No prefilter (-1).
+      // SeqOneByteString: A literal that every match contains.
+      Object prefilter = arr.get(JSRegExp::kIrregexpPrefilterIndex);
+      CHECK((prefilter.IsSmi() &&
+             Smi::ToInt(prefilter) == JSRegExp::kUninitializedValue) ||
+            prefilter.IsSeqOneByteString());
+      CHECK(arr.get(JSRegExp::kIrregexpPrefilterOffsetIndex).IsSmi());
+
+      // Smi : Not compiled yet (-1), or can't be compiled (-2).
+      // Code: Compiled irregexp code without captures.
+      for (bool is_latin1 : {true, false}) {
+        Object capture_free_code =
+            arr.get(JSRegExp::capture_free_code_index(is_latin1));
+        CHECK((capture_free_code.IsSmi() &&
+               (Smi::ToInt(capture_free_code) ==
+                    JSRegExp::kUninitializedValue ||
+                Smi::ToInt(capture_free_code) ==
+                    JSRegExp::kNoCaptureFreeCode)) ||
+              capture_free_code.IsCodeT());
+      }
       break;
     }
     default:
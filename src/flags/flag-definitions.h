@@ -418,6 +418,8 @@ DEFINE_NEG_IMPLICATION(enable_third_party_heap, concurrent_recompilation)
 DEFINE_NEG_IMPLICATION(enable_third_party_heap, script_streaming)
 DEFINE_NEG_IMPLICATION(enable_third_party_heap,
                        parallel_compile_tasks_for_eager_toplevel)
+DEFINE_NEG_IMPLICATION(enable_third_party_heap,
+                       parallel_compile_tasks_for_streaming)
 DEFINE_NEG_IMPLICATION(enable_third_party_heap, use_marking_progress_bar)
 DEFINE_NEG_IMPLICATION(enable_third_party_heap, move_object_start)
 DEFINE_NEG_IMPLICATION(enable_third_party_heap, concurrent_marking)
@@ -734,6 +736,9 @@ DEFINE_UINT(
     "max number of threads that concurrent Sparkplug can use (0 for unbounded)")
 DEFINE_BOOL(concurrent_sparkplug_high_priority_threads, false,
             "use high priority compiler threads for concurrent Sparkplug")
+DEFINE_UINT(concurrent_sparkplug_functions_per_job, 8,
+            "max number of functions of a batch that are compiled by one "
+            "concurrent Sparkplug job (0 for the whole batch)")
 #else
 DEFINE_BOOL(baseline_batch_compilation, false, "batch compile Sparkplug code")
 DEFINE_BOOL_READONLY(concurrent_sparkplug, false,
@@ -950,6 +955,16 @@ DEFINE_BOOL(turbo_use_mid_tier_regalloc_for_huge_functions, true,
             "fall back to the mid-tier register allocator for huge functions")
 DEFINE_BOOL(turbo_force_mid_tier_regalloc, false,
             "always use the mid-tier register allocator (for testing)")
+DEFINE_BOOL(turbo_skip_expensive_phases_for_huge_graphs, true,
+            "skip or cheapen expensive optimizations in TurboFan for huge "
+            "graphs")
+DEFINE_INT(turbo_huge_graph_node_limit, 100000,
+           "number of nodes above which a TurboFan graph is considered huge")
+DEFINE_SIZE_T(turbo_huge_graph_zone_limit_mb, 256,
+              "zone memory (in Mbytes) above which a TurboFan compilation is "
+              "considered huge")
+DEFINE_BOOL(trace_turbo_huge_graphs, false,
+            "trace TurboFan phases skipped for huge graphs")
 
 DEFINE_BOOL(turbo_optimize_apply, true, "optimize Function.prototype.apply")
 
@@ -1017,6 +1032,18 @@ DEFINE_INT(wasm_tiering_budget, 1800000,
 DEFINE_INT(
     wasm_caching_threshold, 1000000,
     "the amount of wasm top tier code that triggers the next caching event")
+DEFINE_STRING(wasm_disk_cache_dir, nullptr,
+              "directory of a persistent cache for compiled wasm modules; the "
+              "directory must exist (disabled if not set)")
+DEFINE_SIZE_T(wasm_disk_cache_max_size_mb, 256,
+              "maximal size (in Mbytes) of the persistent wasm module cache")
+DEFINE_INT(wasm_disk_cache_store_delay, 10,
+           "seconds after baseline compilation after which a wasm module is "
+           "stored in the persistent cache with the functions tiered up so "
+           "far (with dynamic tiering)")
+DEFINE_BOOL(wasm_shared_import_wrapper_cache, true,
+            "share compiled import wrappers between all wasm modules of the "
+            "process")
 DEFINE_BOOL(trace_wasm_compilation_times, false,
             "print how long it took to compile each wasm function")
 DEFINE_INT(wasm_tier_up_filter, -1, "only tier-up function with this index")
@@ -1134,6 +1161,10 @@ DEFINE_BOOL(wasm_loop_unrolling, true,
             "enable loop unrolling for wasm functions")
 DEFINE_BOOL(wasm_loop_peeling, false, "enable loop peeling for wasm functions")
 DEFINE_SIZE_T(wasm_loop_peeling_max_size, 1000, "maximum size for peeling")
+DEFINE_BOOL(wasm_bounds_check_elimination, true,
+            "skip a memory bounds check in TurboFan if the same index was "
+            "already checked with at least the same offset on all paths "
+            "(checks are not hoisted out of loops)")
 DEFINE_BOOL(wasm_fuzzer_gen_test, false,
             "generate a test case when running a wasm fuzzer")
 DEFINE_IMPLICATION(wasm_fuzzer_gen_test, single_threaded)
@@ -1153,12 +1184,17 @@ DEFINE_DEBUG_BOOL(trace_wasm_lazy_compilation, false,
                   "trace lazy compilation of wasm functions")
 DEFINE_BOOL(wasm_lazy_validation, false,
             "enable lazy validation for lazily compiled wasm functions")
+DEFINE_BOOL(wasm_lazy_deserialization, false,
+            "copy deserialized wasm code into the code space on the first call "
+            "of each function")
 DEFINE_BOOL(wasm_simd_ssse3_codegen, false, "allow wasm SIMD SSSE3 codegen")
 
 DEFINE_BOOL(wasm_code_gc, true, "enable garbage collection of wasm code")
 DEFINE_BOOL(trace_wasm_code_gc, false, "trace garbage collection of wasm code")
 DEFINE_BOOL(stress_wasm_code_gc, false,
             "stress test garbage collection of wasm code")
+DEFINE_BOOL(wasm_reuse_freed_code_space, true,
+            "reuse pages freed by garbage collection of wasm code for new code")
 DEFINE_INT(wasm_max_initial_code_space_reservation, 0,
            "maximum size of the initial wasm code space reservation (in MB)")
 
@@ -1342,6 +1378,12 @@ DEFINE_GENERIC_IMPLICATION(
     trace_zone_type_stats,
     TracingFlags::zone_stats.store(
         v8::tracing::TracingCategoryObserver::ENABLED_BY_NATIVE))
+DEFINE_BOOL(zone_segment_pool, true,
+            "recycle freed zone segments of common sizes instead of returning "
+            "them to the system allocator")
+DEFINE_SIZE_T(zone_segment_pool_max_size_kb, 1024,
+              "maximal size (in Kbytes) of zone segments retained for reuse "
+              "per allocator")
 DEFINE_BOOL(track_retaining_path, false,
             "enable support for tracking retaining path")
 DEFINE_DEBUG_BOOL(trace_backing_store, false, "trace backing store events")
@@ -1623,6 +1665,13 @@ DEFINE_BOOL(external_reference_stats, false,
 // compilation-cache.cc
 DEFINE_BOOL(compilation_cache, true, "enable compilation cache")
 
+// shared-compilation-cache.cc
+DEFINE_BOOL(shared_compilation_cache, false,
+            "share compiled scripts between the isolates of the process")
+DEFINE_SIZE_T(shared_compilation_cache_max_size_mb, 64,
+              "maximum size of the shared compilation cache (in Mbytes)")
+DEFINE_NEG_IMPLICATION(predictable, shared_compilation_cache)
+
 DEFINE_BOOL(cache_prototype_transitions, true, "cache prototype transitions")
 
 // lazy-compile-dispatcher.cc
@@ -1639,6 +1688,11 @@ DEFINE_IMPLICATION(parallel_compile_tasks_for_eager_toplevel,
 DEFINE_BOOL(parallel_compile_tasks_for_lazy, false,
             "spawn parallel compile tasks for all lazily compiled functions")
 DEFINE_IMPLICATION(parallel_compile_tasks_for_lazy, lazy_compile_dispatcher)
+DEFINE_BOOL(parallel_compile_tasks_for_streaming, false,
+            "spawn parallel compile tasks for eagerly compiled, top-level "
+            "functions of streamed scripts")
+DEFINE_IMPLICATION(parallel_compile_tasks_for_streaming,
+                   lazy_compile_dispatcher)
 
 // cpu-profiler.cc
 DEFINE_INT(cpu_profiler_sampling_interval, 1000,
@@ -1840,6 +1894,12 @@ DEFINE_BOOL(serialization_statistics, false,
 // Regexp
 DEFINE_BOOL(regexp_optimization, true, "generate optimized regexp code")
 DEFINE_BOOL(regexp_interpret_all, false, "interpret all regexp code")
+DEFINE_BOOL(regexp_prefilter, true,
+            "search for a literal that every match contains before running "
+            "the regexp")
+DEFINE_BOOL(regexp_capture_free_code, true,
+            "compile a variant of regexp code without captures for global "
+            "replacements that don't need them")
 #ifdef V8_TARGET_BIG_ENDIAN
 #define REGEXP_PEEPHOLE_OPTIMIZATION_BOOL false
 #else
@@ -1871,6 +1931,12 @@ DEFINE_IMPLICATION(default_to_experimental_regexp_engine,
                    enable_experimental_regexp_engine)
 DEFINE_BOOL(trace_experimental_regexp_engine, false,
             "trace execution of experimental regexp engine")
+DEFINE_BOOL(experimental_regexp_engine_lazy_dfa, true,
+            "look for matches of the experimental regexp engine with a lazily "
+            "built DFA before computing captures")
+DEFINE_SIZE_T(experimental_regexp_engine_dfa_cache_kb, 256,
+              "maximum size of the DFA state cache of an experimental regexp "
+              "(in Kbytes)")
 
 DEFINE_BOOL(enable_experimental_regexp_engine_on_excessive_backtracks, false,
             "fall back to a breadth-first regexp engine on excessive "
@@ -2235,6 +2301,7 @@ DEFINE_NEG_IMPLICATION(predictable, stress_concurrent_inlining)
 DEFINE_NEG_IMPLICATION(predictable, lazy_compile_dispatcher)
 DEFINE_NEG_IMPLICATION(predictable, parallel_compile_tasks_for_eager_toplevel)
 DEFINE_NEG_IMPLICATION(predictable, parallel_compile_tasks_for_lazy)
+DEFINE_NEG_IMPLICATION(predictable, parallel_compile_tasks_for_streaming)
 
 DEFINE_BOOL(predictable_gc_schedule, false,
             "Predictable garbage collection schedule. Fixes heap growing, "
@@ -2256,6 +2323,7 @@ DEFINE_NEG_IMPLICATION(single_threaded, lazy_compile_dispatcher)
 DEFINE_NEG_IMPLICATION(single_threaded,
                        parallel_compile_tasks_for_eager_toplevel)
 DEFINE_NEG_IMPLICATION(single_threaded, parallel_compile_tasks_for_lazy)
+DEFINE_NEG_IMPLICATION(single_threaded, parallel_compile_tasks_for_streaming)
 
 //
 // Parallel and concurrent GC (Orinoco) related flags.
@@ -497,6 +497,10 @@ void ComputeFlagListHash() {
     if (flag.PointsTo(&FLAG_profile_deserialization)) continue;
     // Skip FLAG_random_seed to allow predictable code caching.
     if (flag.PointsTo(&FLAG_random_seed)) continue;
+#if V8_ENABLE_WEBASSEMBLY
+    // Lazy deserialization does not change the serialized wasm code.
+    if (flag.PointsTo(&FLAG_wasm_lazy_deserialization)) continue;
+#endif  // V8_ENABLE_WEBASSEMBLY
     modified_args_as_string << flag;
   }
   std::string args(modified_args_as_string.str());
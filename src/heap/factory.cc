@@ -3649,6 +3649,11 @@ void Factory::SetRegExpIrregexpData(Handle<JSRegExp> regexp,
   store.set(JSRegExp::kIrregexpCaptureNameMapIndex, uninitialized);
   store.set(JSRegExp::kIrregexpTicksUntilTierUpIndex, ticks_until_tier_up);
   store.set(JSRegExp::kIrregexpBacktrackLimit, Smi::FromInt(backtrack_limit));
+  store.set(JSRegExp::kIrregexpPrefilterIndex, uninitialized);
+  store.set(JSRegExp::kIrregexpPrefilterOffsetIndex,
+            Smi::FromInt(JSRegExp::kNoPrefilterOffset));
+  store.set(JSRegExp::kIrregexpLatin1CaptureFreeCodeIndex, uninitialized);
+  store.set(JSRegExp::kIrregexpUC16CaptureFreeCodeIndex, uninitialized);
   regexp->set_data(store);
 }
 
@@ -3673,6 +3678,11 @@ void Factory::SetRegExpExperimentalData(Handle<JSRegExp> regexp,
   store.set(JSRegExp::kIrregexpCaptureNameMapIndex, uninitialized);
   store.set(JSRegExp::kIrregexpTicksUntilTierUpIndex, uninitialized);
   store.set(JSRegExp::kIrregexpBacktrackLimit, uninitialized);
+  store.set(JSRegExp::kIrregexpPrefilterIndex, uninitialized);
+  store.set(JSRegExp::kIrregexpPrefilterOffsetIndex, uninitialized);
+  store.set(JSRegExp::kIrregexpLatin1CaptureFreeCodeIndex, uninitialized);
+  store.set(JSRegExp::kIrregexpUC16CaptureFreeCodeIndex, uninitialized);
+  store.set(JSRegExp::kExperimentalDfaIndex, uninitialized);
   regexp->set_data(store);
 }
 
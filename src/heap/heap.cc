@@ -4206,6 +4206,10 @@ void Heap::MemoryPressureNotification(MemoryPressureLevel level,
                static_cast<int>(level));
   MemoryPressureLevel previous =
       memory_pressure_level_.exchange(level, std::memory_order_relaxed);
+  if (level != MemoryPressureLevel::kNone) {
+    // Pooled zone segments are not in use and can be released right away.
+    isolate()->allocator()->TrimSegmentPool();
+  }
   if ((previous != MemoryPressureLevel::kCritical &&
        level == MemoryPressureLevel::kCritical) ||
       (previous == MemoryPressureLevel::kNone &&
@@ -5331,7 +5335,8 @@ void Heap::RecordStats(HeapStats* stats, bool take_snapshot) {
       memory_allocator()->Size() + memory_allocator()->Available();
   *stats->os_error = base::OS::GetLastError();
   // TODO(leszeks): Include the string table in both current and peak usage.
-  *stats->malloced_memory = isolate_->allocator()->GetCurrentMemoryUsage();
+  *stats->malloced_memory = isolate_->allocator()->GetCurrentMemoryUsage() +
+                            isolate_->allocator()->GetPooledMemoryUsage();
   *stats->malloced_peak_memory = isolate_->allocator()->GetMaxMemoryUsage();
   if (take_snapshot) {
     HeapObjectIterator iterator(this);
@@ -320,6 +320,34 @@ bool Bytecodes::IsStarLookahead(Bytecode bytecode, OperandScale operand_scale) {
   return false;
 }
 
+// static
+bool Bytecodes::IsJumpIfBooleanLookahead(Bytecode bytecode,
+                                         OperandScale operand_scale) {
+  if (operand_scale == OperandScale::kSingle) {
+    switch (bytecode) {
+      // All of these produce a boolean in the accumulator, which the bytecode
+      // generator usually consumes with a JumpIfTrue or JumpIfFalse.
+      case Bytecode::kTestEqual:
+      case Bytecode::kTestEqualStrict:
+      case Bytecode::kTestLessThan:
+      case Bytecode::kTestGreaterThan:
+      case Bytecode::kTestLessThanOrEqual:
+      case Bytecode::kTestGreaterThanOrEqual:
+      case Bytecode::kTestReferenceEqual:
+      case Bytecode::kTestInstanceOf:
+      case Bytecode::kTestIn:
+      case Bytecode::kTestUndetectable:
+      case Bytecode::kTestNull:
+      case Bytecode::kTestUndefined:
+      case Bytecode::kTestTypeOf:
+        return true;
+      default:
+        return false;
+    }
+  }
+  return false;
+}
+
 // static
 bool Bytecodes::IsBytecodeWithScalableOperands(Bytecode bytecode) {
   for (int i = 0; i < NumberOfOperands(bytecode); i++) {
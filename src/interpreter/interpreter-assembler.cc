@@ -1222,11 +1222,66 @@ void InterpreterAssembler::InlineShortStar(TNode<WordT> target_bytecode) {
   implicit_register_use_ = previous_acc_use;
 }
 
+void InterpreterAssembler::JumpIfBooleanDispatchLookahead(
+    TNode<WordT> target_bytecode) {
+  Label do_inline_jump_if_true(this), do_inline_jump_if_false(this),
+      done(this);
+
+  // Test bytecodes are followed by a conditional jump on their result more
+  // often than not. Handling the jump right here saves a dispatch.
+  TNode<Int32T> target = TruncateWordToInt32(target_bytecode);
+  GotoIf(Word32Equal(target,
+                     Int32Constant(static_cast<int>(Bytecode::kJumpIfTrue))),
+         &do_inline_jump_if_true);
+  Branch(Word32Equal(target,
+                     Int32Constant(static_cast<int>(Bytecode::kJumpIfFalse))),
+         &do_inline_jump_if_false, &done);
+
+  BIND(&do_inline_jump_if_true);
+  InlineJumpIfBoolean(Bytecode::kJumpIfTrue);
+
+  BIND(&do_inline_jump_if_false);
+  InlineJumpIfBoolean(Bytecode::kJumpIfFalse);
+
+  BIND(&done);
+}
+
+void InterpreterAssembler::InlineJumpIfBoolean(Bytecode jump_bytecode) {
+  DCHECK(jump_bytecode == Bytecode::kJumpIfTrue ||
+         jump_bytecode == Bytecode::kJumpIfFalse);
+  Bytecode previous_bytecode = bytecode_;
+  ImplicitRegisterUse previous_acc_use = implicit_register_use_;
+
+  bytecode_ = jump_bytecode;
+  implicit_register_use_ = ImplicitRegisterUse::kNone;
+
+#ifdef V8_TRACE_UNOPTIMIZED
+  TraceBytecode(Runtime::kTraceUnoptimizedBytecodeEntry);
+#endif
+
+  // Same as the JumpIfTrue and JumpIfFalse handlers. Both paths dispatch.
+  TNode<Object> accumulator = GetAccumulator();
+  CSA_DCHECK(this, IsBoolean(CAST(accumulator)));
+  JumpIfTaggedEqual(accumulator,
+                    jump_bytecode == Bytecode::kJumpIfTrue ? TrueConstant()
+                                                           : FalseConstant(),
+                    0);
+
+  DCHECK_EQ(implicit_register_use_,
+            Bytecodes::GetImplicitRegisterUse(bytecode_));
+
+  bytecode_ = previous_bytecode;
+  implicit_register_use_ = previous_acc_use;
+}
+
 void InterpreterAssembler::Dispatch() {
   Comment("========= Dispatch");
   DCHECK_IMPLIES(Bytecodes::MakesCallAlongCriticalPath(bytecode_), made_call_);
   TNode<IntPtrT> target_offset = Advance();
   TNode<WordT> target_bytecode = LoadBytecode(target_offset);
+  if (Bytecodes::IsJumpIfBooleanLookahead(bytecode_, operand_scale_)) {
+    JumpIfBooleanDispatchLookahead(target_bytecode);
+  }
   DispatchToBytecodeWithOptionalStarLookahead(target_bytecode);
 }
 
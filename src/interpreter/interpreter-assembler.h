@@ -419,6 +419,15 @@ class V8_EXPORT_PRIVATE InterpreterAssembler : public CodeStubAssembler {
   // the next dispatch offset.
   void InlineShortStar(TNode<WordT> target_bytecode);
 
+  // Look ahead for JumpIfTrue or JumpIfFalse and inline it in a branch,
+  // including the subsequent dispatch. Anything after this point can assume
+  // that the following instruction was neither of them.
+  void JumpIfBooleanDispatchLookahead(TNode<WordT> target_bytecode);
+
+  // Build code for the |jump_bytecode| at the current BytecodeOffset(),
+  // including the dispatch to either the jump target or the next bytecode.
+  void InlineJumpIfBoolean(Bytecode jump_bytecode);
+
   // Dispatch to the bytecode handler with code entry point |handler_entry|.
   void DispatchToBytecodeHandlerEntry(TNode<RawPtrT> handler_entry,
                                       TNode<IntPtrT> bytecode_offset);
@@ -74,6 +74,14 @@ namespace internal {
   /* percent of freed code size per module, collected on GC */                 \
   HR(wasm_module_freed_code_size_percent, V8.WasmModuleCodeSizePercentFreed,   \
      0, 100, 32)                                                               \
+  /* percent of generated code size per module which was freed but can not */  \
+  /* be reused for new code yet, collected on GC */                            \
+  HR(wasm_module_fragmented_code_size_percent,                                 \
+     V8.WasmModuleCodeSizePercentFragmented, 0, 100, 32)                       \
+  /* percent of freed code size per module which was made available for new */ \
+  /* code again, collected on GC */                                            \
+  HR(wasm_module_reclaimed_code_size_percent,                                  \
+     V8.WasmModuleCodeSizePercentReclaimed, 0, 100, 32)                        \
   /* number of code GCs triggered per native module, collected on code GC */   \
   HR(wasm_module_num_triggered_code_gcs,                                       \
      V8.WasmModuleNumberOfCodeGCsTriggered, 1, 128, 20)                        \
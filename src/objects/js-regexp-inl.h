@@ -133,6 +133,8 @@ void JSRegExp::DiscardCompiledCodeForSerialization() {
   SetDataAt(kIrregexpUC16CodeIndex, uninitialized);
   SetDataAt(kIrregexpLatin1BytecodeIndex, uninitialized);
   SetDataAt(kIrregexpUC16BytecodeIndex, uninitialized);
+  SetDataAt(kIrregexpLatin1CaptureFreeCodeIndex, uninitialized);
+  SetDataAt(kIrregexpUC16CaptureFreeCodeIndex, uninitialized);
 }
 
 }  // namespace internal
@@ -161,6 +161,13 @@ void JSRegExp::set_code(bool is_latin1, Handle<Code> code) {
   SetDataAt(code_index(is_latin1), ToCodeT(*code));
 }
 
+Object JSRegExp::capture_free_code(bool is_latin1) const {
+  DCHECK_EQ(type_tag(), JSRegExp::IRREGEXP);
+  Object value = DataAt(capture_free_code_index(is_latin1));
+  DCHECK_IMPLIES(V8_EXTERNAL_CODE_SPACE_BOOL, value.IsSmi() || value.IsCodeT());
+  return value;
+}
+
 Object JSRegExp::bytecode(bool is_latin1) const {
   DCHECK(type_tag() == JSRegExp::IRREGEXP ||
          type_tag() == JSRegExp::EXPERIMENTAL);
@@ -69,6 +69,9 @@ class JSRegExp : public TorqueGeneratedJSRegExp<JSRegExp, JSObject> {
   // This could be a Smi kUninitializedValue or Code.
   V8_EXPORT_PRIVATE Object code(bool is_latin1) const;
   V8_EXPORT_PRIVATE void set_code(bool is_unicode, Handle<Code> code);
+  // This could be a Smi kUninitializedValue, a Smi kNoCaptureFreeCode or
+  // Code that records only the bounds of the match.
+  Object capture_free_code(bool is_latin1) const;
   // This could be a Smi kUninitializedValue or ByteArray.
   V8_EXPORT_PRIVATE Object bytecode(bool is_latin1) const;
   // Sets the bytecode as well as initializing trampoline slots to the
@@ -148,6 +151,11 @@ class JSRegExp : public TorqueGeneratedJSRegExp<JSRegExp, JSObject> {
                      : kIrregexpUC16BytecodeIndex;
   }
 
+  static constexpr int capture_free_code_index(bool is_latin1) {
+    return is_latin1 ? kIrregexpLatin1CaptureFreeCodeIndex
+                     : kIrregexpUC16CaptureFreeCodeIndex;
+  }
+
   // Dispatched behavior.
   DECL_PRINTER(JSRegExp)
   DECL_VERIFIER(JSRegExp)
@@ -202,7 +210,22 @@ class JSRegExp : public TorqueGeneratedJSRegExp<JSRegExp, JSObject> {
   // above to save space.
   static constexpr int kIrregexpBacktrackLimit =
       kIrregexpTicksUntilTierUpIndex + 1;
-  static constexpr int kIrregexpDataSize = kIrregexpBacktrackLimit + 1;
+  // A one-byte String that occurs in every match, or a Smi marker value equal
+  // to kUninitializedValue if there is none.
+  static constexpr int kIrregexpPrefilterIndex = kIrregexpBacktrackLimit + 1;
+  // A smi containing the distance between the start of a match and the
+  // prefilter literal, or kNoPrefilterOffset if it varies.
+  static constexpr int kIrregexpPrefilterOffsetIndex =
+      kIrregexpPrefilterIndex + 1;
+  // A Code object that only records the bounds of the match, for callers that
+  // don't need the captures, or a Smi marker value equal to
+  // kUninitializedValue or kNoCaptureFreeCode.
+  static constexpr int kIrregexpLatin1CaptureFreeCodeIndex =
+      kIrregexpPrefilterOffsetIndex + 1;
+  static constexpr int kIrregexpUC16CaptureFreeCodeIndex =
+      kIrregexpLatin1CaptureFreeCodeIndex + 1;
+  static constexpr int kIrregexpDataSize =
+      kIrregexpUC16CaptureFreeCodeIndex + 1;
 
   // TODO(mbid,v8:10765): At the moment the EXPERIMENTAL data array conforms
   // to the format of an IRREGEXP data array, with most fields set to some
@@ -211,7 +234,12 @@ class JSRegExp : public TorqueGeneratedJSRegExp<JSRegExp, JSObject> {
   // various fields from the data array. `RegExpExecInternal` should probably
   // distinguish between EXPERIMENTAL and IRREGEXP, and then we can get rid of
   // all the IRREGEXP only fields.
-  static constexpr int kExperimentalDataSize = kIrregexpDataSize;
+  //
+  // The EXPERIMENTAL only fields follow the IRREGEXP ones.
+  // A Managed<ExperimentalDfa> holding the lazily built DFA of the compiled
+  // bytecode, or a Smi marker value equal to kUninitializedValue.
+  static constexpr int kExperimentalDfaIndex = kIrregexpDataSize;
+  static constexpr int kExperimentalDataSize = kExperimentalDfaIndex + 1;
 
   // In-object fields.
   static constexpr int kLastIndexFieldIndex = 0;
@@ -236,6 +264,13 @@ class JSRegExp : public TorqueGeneratedJSRegExp<JSRegExp, JSObject> {
   // If the backtrack limit is set to this marker value, no limit is applied.
   static constexpr uint32_t kNoBacktrackLimit = 0;
 
+  // The prefilter offset when the literal's position in a match varies.
+  static constexpr int kNoPrefilterOffset = -1;
+
+  // The capture-free code marker for regexps that can't be compiled without
+  // captures, e.g. because they contain back references.
+  static constexpr int kNoCaptureFreeCode = -2;
+
   // The heuristic value for the length of the subject string for which we
   // tier-up to the compiler immediately, instead of using the interpreter.
   static constexpr int kTierUpForSubjectLengthValue = 1000;
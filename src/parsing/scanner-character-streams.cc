@@ -511,6 +511,9 @@ class Windows1252CharacterStream final : public Utf16CharacterStream {
 // character position is tricky because the byte position cannot be derived
 // from the character position.
 //
+// Runs of ascii bytes are not decoded, neither when filling the buffer nor
+// when seeking, but they are still widened to utf-16 for the scanner.
+//
 // TODO(verwaest): Decode utf8 chunks into utf16 chunks on the blink side
 // instead so we don't need to buffer.
 
@@ -619,6 +622,16 @@ bool Utf8ExternalStreamingStream::SkipToPosition(size_t position) {
   }
 
   while (cursor < end && chars < position) {
+    // Fast path for ascii sequences: each byte is one char, so skip them
+    // without decoding.
+    if (V8_LIKELY(state == unibrow::Utf8::State::kAccept)) {
+      size_t remaining = end - cursor;
+      int max_length = static_cast<int>(std::min(remaining, position - chars));
+      int ascii_length = NonAsciiStart(cursor, max_length);
+      cursor += ascii_length;
+      chars += ascii_length;
+      if (cursor == end || chars == position) break;
+    }
     unibrow::uchar t =
         unibrow::Utf8::ValueOfIncremental(&cursor, &state, &incomplete_char);
     if (t != unibrow::Utf8::kIncomplete) {
@@ -694,6 +707,19 @@ void Utf8ExternalStreamingStream::FillBufferFromCurrentChunk() {
 
   const uint16_t* max_buffer_end = buffer_start_ + kBufferSize;
   while (cursor < end && output_cursor + 1 < max_buffer_end) {
+    // Fast path for ascii sequences. Most sources are (almost) entirely ascii,
+    // so a refill of the buffer usually only widens the bytes, without
+    // decoding a single character.
+    if (V8_LIKELY(state == unibrow::Utf8::State::kAccept)) {
+      size_t remaining = end - cursor;
+      size_t max_buffer = max_buffer_end - output_cursor;
+      int max_length = static_cast<int>(std::min(remaining, max_buffer));
+      int ascii_length = NonAsciiStart(cursor, max_length);
+      CopyChars(output_cursor, cursor, ascii_length);
+      cursor += ascii_length;
+      output_cursor += ascii_length;
+      if (cursor == end || output_cursor + 1 >= max_buffer_end) break;
+    }
     unibrow::uchar t =
         unibrow::Utf8::ValueOfIncremental(&cursor, &state, &incomplete_char);
     if (V8_LIKELY(t <= unibrow::Utf16::kMaxNonSurrogateCharCode)) {
@@ -705,15 +731,6 @@ void Utf8ExternalStreamingStream::FillBufferFromCurrentChunk() {
       *(output_cursor++) = unibrow::Utf16::LeadSurrogate(t);
       *(output_cursor++) = unibrow::Utf16::TrailSurrogate(t);
     }
-    // Fast path for ascii sequences.
-    size_t remaining = end - cursor;
-    size_t max_buffer = max_buffer_end - output_cursor;
-    int max_length = static_cast<int>(std::min(remaining, max_buffer));
-    DCHECK_EQ(state, unibrow::Utf8::State::kAccept);
-    int ascii_length = NonAsciiStart(cursor, max_length);
-    CopyChars(output_cursor, cursor, ascii_length);
-    cursor += ascii_length;
-    output_cursor += ascii_length;
   }
 
   current_.pos.bytes = chunk.start.bytes + (cursor - chunk.data.get());
@@ -0,0 +1,357 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/regexp/experimental/experimental-dfa.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "src/base/functional.h"
+#include "src/strings/char-predicates-inl.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+// Flushing the cache only pays off if the DFA states built since the last
+// flush were used for at least this many input characters each on average.
+constexpr int kMinCharactersPerState = 10;
+
+// The DFA disables itself after this many searches gave up.
+constexpr int kMaxGiveUps = 4;
+
+// Approximate memory used by a node of the state id map besides the key.
+constexpr size_t kStateIdEntryOverhead = 4 * sizeof(void*);
+
+}  // namespace
+
+size_t ExperimentalDfa::StateKeyHash::operator()(
+    const std::vector<int>& key) const {
+  return base::hash_range(key.begin(), key.end());
+}
+
+ExperimentalDfa::ExperimentalDfa(base::Vector<const RegExpInstruction> bytecode,
+                                 size_t max_cache_size)
+    : bytecode_(bytecode.begin(), bytecode.end()),
+      max_cache_size_(max_cache_size),
+      pc_visited_(bytecode.size(), 0) {
+  DCHECK(!bytecode_.empty());
+
+  // Two characters belong to the same class unless a CONSUME_RANGE
+  // instruction or an assertion can tell them apart.
+  std::vector<int> boundaries = {0};
+  auto add_range = [&](int from, int to) {
+    boundaries.push_back(from);
+    boundaries.push_back(to + 1);
+  };
+  for (const RegExpInstruction& inst : bytecode_) {
+    if (inst.opcode == RegExpInstruction::CONSUME_RANGE) {
+      add_range(inst.payload.consume_range.min,
+                inst.payload.consume_range.max);
+    } else if (inst.opcode == RegExpInstruction::ASSERTION) {
+      has_assertions_ = true;
+    }
+  }
+  if (has_assertions_) {
+    add_range('0', '9');
+    add_range('A', 'Z');
+    add_range('_', '_');
+    add_range('a', 'z');
+    add_range('\n', '\n');
+    add_range('\r', '\r');
+    add_range(0x2028, 0x2029);
+  }
+  std::sort(boundaries.begin(), boundaries.end());
+  boundaries.erase(std::unique(boundaries.begin(), boundaries.end()),
+                   boundaries.end());
+  for (int boundary : boundaries) {
+    if (boundary > std::numeric_limits<base::uc16>::max()) break;
+    class_starts_.push_back(static_cast<base::uc16>(boundary));
+  }
+  for (int c = 0; c < kLatin1ClassTableSize; ++c) {
+    latin1_classes_[c] = static_cast<uint16_t>(ClassOfSlow(c));
+  }
+
+  // Unless the regexp is sticky or anchored at the start, the compiler emits
+  // the preamble /[^]*?/ as
+  //
+  //   0: FORK 2
+  //   1: JMP 4
+  //   2: CONSUME_RANGE [0x0000, 0xFFFF]
+  //   3: FORK 2
+  //   4: ...
+  //
+  // A thread at pc 3 runs exactly like a thread that starts at pc 0.
+  if (bytecode_.size() > 4 &&
+      bytecode_[0].opcode == RegExpInstruction::FORK &&
+      bytecode_[0].payload.pc == 2 &&
+      bytecode_[1].opcode == RegExpInstruction::JMP &&
+      bytecode_[1].payload.pc == 4 &&
+      bytecode_[2].opcode == RegExpInstruction::CONSUME_RANGE &&
+      bytecode_[2].payload.consume_range.min == 0x0000 &&
+      bytecode_[2].payload.consume_range.max == 0xFFFF &&
+      bytecode_[3].opcode == RegExpInstruction::FORK &&
+      bytecode_[3].payload.pc == 2) {
+    idle_pc_ = 3;
+  }
+
+  FlushCache();
+}
+
+size_t ExperimentalDfa::InitialSize() const {
+  return sizeof(ExperimentalDfa) +
+         bytecode_.capacity() * sizeof(RegExpInstruction) +
+         class_starts_.capacity() * sizeof(base::uc16) +
+         transitions_.capacity() * sizeof(int32_t) +
+         pc_visited_.capacity() * sizeof(uint32_t);
+}
+
+int ExperimentalDfa::ClassOfSlow(base::uc16 c) const {
+  auto it = std::upper_bound(class_starts_.begin(), class_starts_.end(), c);
+  DCHECK(it != class_starts_.begin());
+  return static_cast<int>(it - class_starts_.begin()) - 1;
+}
+
+uint8_t ExperimentalDfa::FlagsAfter(base::uc16 c) const {
+  uint8_t flags = 0;
+  if (IsRegExpWord(c)) flags |= kAfterWordCharacter;
+  if (unibrow::IsLineTerminator(c)) flags |= kAfterLineTerminator;
+  return flags;
+}
+
+namespace {
+
+bool SatisfiesAssertion(RegExpAssertion::Type type, bool at_start,
+                        bool after_word, bool after_line_terminator,
+                        bool at_end, bool before_word,
+                        bool before_line_terminator) {
+  switch (type) {
+    case RegExpAssertion::Type::START_OF_INPUT:
+      return at_start;
+    case RegExpAssertion::Type::END_OF_INPUT:
+      return at_end;
+    case RegExpAssertion::Type::START_OF_LINE:
+      return at_start || after_line_terminator;
+    case RegExpAssertion::Type::END_OF_LINE:
+      return at_end || before_line_terminator;
+    case RegExpAssertion::Type::BOUNDARY:
+      return after_word != before_word;
+    case RegExpAssertion::Type::NON_BOUNDARY:
+      return after_word == before_word;
+  }
+}
+
+}  // namespace
+
+int32_t ExperimentalDfa::ComputeTransition(int state, int char_class) {
+  const bool at_end = char_class == class_count();
+  const base::uc16 c = at_end ? 0 : class_starts_[char_class];
+  const uint8_t flags = states_[state].flags;
+
+  if (++visit_generation_ == 0) {
+    std::fill(pc_visited_.begin(), pc_visited_.end(), 0);
+    visit_generation_ = 1;
+  }
+
+  // Run the threads like NfaInterpreter::RunActiveThreads: the stack holds
+  // the active threads from low to high priority, and a thread that reaches
+  // a pc that a thread with higher priority already reached is dropped.
+  const std::vector<int>& pcs = states_[state].pcs;
+  stack_.assign(pcs.rbegin(), pcs.rend());
+  blocked_.clear();
+  bool accepted = false;
+  while (!stack_.empty()) {
+    int pc = stack_.back();
+    stack_.pop_back();
+    bool running = true;
+    while (running && pc_visited_[pc] != visit_generation_) {
+      pc_visited_[pc] = visit_generation_;
+      const RegExpInstruction& inst = bytecode_[pc];
+      switch (inst.opcode) {
+        case RegExpInstruction::CONSUME_RANGE:
+          blocked_.push_back(pc);
+          running = false;
+          break;
+        case RegExpInstruction::ASSERTION:
+          running = SatisfiesAssertion(
+              inst.payload.assertion_type, flags & kAtStart,
+              flags & kAfterWordCharacter, flags & kAfterLineTerminator,
+              at_end, !at_end && IsRegExpWord(c),
+              !at_end && unibrow::IsLineTerminator(c));
+          ++pc;
+          break;
+        case RegExpInstruction::FORK:
+          stack_.push_back(inst.payload.pc);
+          ++pc;
+          break;
+        case RegExpInstruction::JMP:
+          pc = inst.payload.pc;
+          break;
+        case RegExpInstruction::ACCEPT:
+          // Threads with lower priority can only produce worse matches.
+          accepted = true;
+          stack_.clear();
+          running = false;
+          break;
+        case RegExpInstruction::SET_REGISTER_TO_CP:
+        case RegExpInstruction::CLEAR_REGISTER:
+          ++pc;
+          break;
+      }
+    }
+  }
+
+  const int32_t accepted_bit = accepted ? kAcceptedBit : 0;
+  if (at_end) return (kDeadState << kStateShift) | accepted_bit;
+
+  // Feed the character to the blocked threads like
+  // NfaInterpreter::FlushBlockedThreads.  All characters of the class behave
+  // the same.
+  next_pcs_.clear();
+  for (int pc : blocked_) {
+    RegExpInstruction::Uc16Range range = bytecode_[pc].payload.consume_range;
+    if (c >= range.min && c <= range.max) next_pcs_.push_back(pc + 1);
+  }
+  if (next_pcs_.empty()) return (kDeadState << kStateShift) | accepted_bit;
+
+  int next = Intern(next_pcs_, has_assertions_ ? FlagsAfter(c) : 0);
+  if (next == kCacheFull) return kCacheFull;
+  return (next << kStateShift) | (IsIdle(next) ? kIdleBit : 0) | accepted_bit;
+}
+
+int ExperimentalDfa::Intern(const std::vector<int>& pcs, uint8_t flags) {
+  std::vector<int> key(pcs);
+  key.push_back(flags);
+  auto it = state_ids_.find(key);
+  if (it != state_ids_.end()) return it->second;
+
+  // The pcs are stored both in the state and in the key.
+  size_t size = sizeof(State) + 2 * key.size() * sizeof(int) +
+                stride() * sizeof(int32_t) + kStateIdEntryOverhead;
+  if (cache_size_ + size > max_cache_size_) return kCacheFull;
+  cache_size_ += size;
+
+  int id = static_cast<int>(states_.size());
+  states_.push_back(State{pcs, flags});
+  transitions_.resize(transitions_.size() + stride(), kUnknownTransition);
+  state_ids_.emplace(std::move(key), id);
+  return id;
+}
+
+bool ExperimentalDfa::IsIdle(int state) const {
+  const std::vector<int>& pcs = states_[state].pcs;
+  return idle_pc_ != -1 && pcs.size() == 1 && pcs[0] == idle_pc_;
+}
+
+void ExperimentalDfa::FlushCache() {
+  states_.clear();
+  state_ids_.clear();
+  transitions_.clear();
+  cache_size_ = 0;
+  ++cache_epoch_;
+
+  states_.push_back(State{{}, 0});
+  transitions_.resize(stride(), kUnknownTransition);
+  DCHECK_EQ(kDeadState, static_cast<int>(states_.size()) - 1);
+}
+
+ExperimentalDfa::Result ExperimentalDfa::GiveUp() {
+  if (++give_up_count_ == kMaxGiveUps) disabled_ = true;
+  return Result::kGaveUp;
+}
+
+bool ExperimentalDfa::MakeRoom(Search* search, int position) {
+  if (search->flush_position != -1 &&
+      position - search->flush_position <
+          kMinCharactersPerState * static_cast<int>(states_.size())) {
+    return false;
+  }
+  State current = states_[search->state];
+  FlushCache();
+  search->flush_position = position;
+  search->cache_epoch = cache_epoch_;
+  search->state = Intern(current.pcs, current.flags);
+  return search->state != kCacheFull;
+}
+
+template <class Character>
+base::Optional<ExperimentalDfa::Result> ExperimentalDfa::Run(
+    base::Vector<const Character> input, Search* search, int limit) {
+  DCHECK(!disabled_);
+  DCHECK_LE(search->position, input.length());
+
+  if (search->state == kNoState) {
+    const int start = search->position;
+    uint8_t flags = 0;
+    if (has_assertions_) {
+      flags = start == 0 ? kAtStart : FlagsAfter(input[start - 1]);
+    }
+    next_pcs_.assign(1, 0);
+    int state = Intern(next_pcs_, flags);
+    if (state == kCacheFull) {
+      FlushCache();
+      state = Intern(next_pcs_, flags);
+      if (state == kCacheFull) return GiveUp();
+    }
+    search->state = state;
+    search->cache_epoch = cache_epoch_;
+  } else if (search->cache_epoch != cache_epoch_) {
+    // A search for the same regexp, e.g. from an interrupt, flushed the cache
+    // while this one was suspended.
+    return Result::kGaveUp;
+  }
+
+  const int length = input.length();
+  int state = search->state;
+  int position = search->position;
+  int restart_position = search->restart_position;
+  int match_end = search->match_end;
+  while (true) {
+    const int char_class =
+        position == length ? class_count() : ClassOf(input[position]);
+    int32_t transition = transitions_[state * stride() + char_class];
+    if (transition == kUnknownTransition) {
+      transition = ComputeTransition(state, char_class);
+      if (transition == kCacheFull) {
+        search->state = state;
+        if (!MakeRoom(search, position)) return GiveUp();
+        state = search->state;
+        continue;
+      }
+      transitions_[state * stride() + char_class] = transition;
+    }
+
+    if (transition & kAcceptedBit) match_end = position;
+    if (position == length) break;
+
+    ++position;
+    state = transition >> kStateShift;
+    if (state == kDeadState) break;
+    if ((transition & kIdleBit) && match_end == -1) {
+      restart_position = position;
+    }
+    if (position == limit) {
+      search->state = state;
+      search->position = position;
+      search->restart_position = restart_position;
+      search->match_end = match_end;
+      return base::nullopt;
+    }
+  }
+
+  search->state = state;
+  search->position = position;
+  search->restart_position = restart_position;
+  search->match_end = match_end;
+  return match_end == -1 ? Result::kNoMatch : Result::kMatch;
+}
+
+template base::Optional<ExperimentalDfa::Result> ExperimentalDfa::Run(
+    base::Vector<const uint8_t> input, Search* search, int limit);
+template base::Optional<ExperimentalDfa::Result> ExperimentalDfa::Run(
+    base::Vector<const base::uc16> input, Search* search, int limit);
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,167 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_REGEXP_EXPERIMENTAL_EXPERIMENTAL_DFA_H_
+#define V8_REGEXP_EXPERIMENTAL_EXPERIMENTAL_DFA_H_
+
+#include <unordered_map>
+#include <vector>
+
+#include "src/base/optional.h"
+#include "src/base/strings.h"
+#include "src/base/vector.h"
+#include "src/regexp/experimental/experimental-bytecode.h"
+
+namespace v8 {
+namespace internal {
+
+// A deterministic automaton for a program of experimental regexp bytecode
+// that is constructed lazily during matching, similar to RE2's DFA.
+//
+// A DFA state is the priority-ordered list of program counters that the
+// threads of the NfaInterpreter are blocked at after consuming the input up
+// to some position, plus whatever the assertions of the program need to know
+// about the character before that position.  Registers are not tracked, so a
+// search with the DFA finds out whether and where the next match ends, but
+// not where it begins or what the captures are.  The interpreter then only
+// runs the NFA simulation over the part of the input that contains a match.
+//
+// States and transitions are computed on first use and cached for the
+// lifetime of the regexp.  The memory of the cache is bounded: if it is full,
+// it is flushed and the search continues from scratch.  If the cache is
+// flushed so often that the DFA is no faster than the NFA simulation, the
+// search gives up and the caller falls back to the NFA, and after a few such
+// searches the DFA disables itself.
+class ExperimentalDfa final {
+ public:
+  ExperimentalDfa(base::Vector<const RegExpInstruction> bytecode,
+                  size_t max_cache_size);
+  ExperimentalDfa(const ExperimentalDfa&) = delete;
+  ExperimentalDfa& operator=(const ExperimentalDfa&) = delete;
+
+  enum class Result { kMatch, kNoMatch, kGaveUp };
+
+  // The progress of a search, such that it can be suspended to handle
+  // interrupts.
+  struct Search {
+    explicit Search(int start)
+        : position(start), restart_position(start), match_end(-1) {}
+
+    // The position of the next character to consume.
+    int position;
+    // Where the NfaInterpreter has to start to find the match that the DFA
+    // finds.  It is advanced while the DFA is in the state that the NFA is
+    // in right after a (failed) attempt to match at every position.
+    int restart_position;
+    // The end of the best match found so far, or -1.
+    int match_end;
+
+    // Internal state of the search.
+    int state = kNoState;
+    int cache_epoch = -1;
+    int flush_position = -1;
+  };
+
+  // Continues {search} on {input} until it is finished, or until it reached
+  // {limit} before the end of the input; returns nullopt in the latter case.
+  template <class Character>
+  base::Optional<Result> Run(base::Vector<const Character> input,
+                             Search* search, int limit);
+
+  // Whether searches gave up too often for the DFA to be useful.
+  bool disabled() const { return disabled_; }
+
+  // The memory used by the DFA before its cache is filled by a search.
+  size_t InitialSize() const;
+
+ private:
+  static constexpr int kNoState = -1;
+  // The state without threads, from which there is no match.
+  static constexpr int kDeadState = 0;
+  // An entry of the transition table that is not yet computed.
+  static constexpr int32_t kUnknownTransition = -1;
+  // Returned instead of a transition if there is no space left in the cache.
+  static constexpr int32_t kCacheFull = -2;
+
+  // What assertions need to know about the character before a position.
+  enum ContextFlag : uint8_t {
+    kAtStart = 1 << 0,
+    kAfterWordCharacter = 1 << 1,
+    kAfterLineTerminator = 1 << 2,
+  };
+
+  // A transition table entry stores the next state along with whether the
+  // transition passes an ACCEPT and whether the next state is idle.
+  static constexpr int32_t kAcceptedBit = 1 << 0;
+  static constexpr int32_t kIdleBit = 1 << 1;
+  static constexpr int kStateShift = 2;
+
+  struct State {
+    // Program counters of blocked threads, from high to low priority.
+    std::vector<int> pcs;
+    uint8_t flags;
+  };
+
+  struct StateKeyHash {
+    size_t operator()(const std::vector<int>& key) const;
+  };
+
+  int ClassOf(base::uc16 c) const {
+    if (c < kLatin1ClassTableSize) return latin1_classes_[c];
+    return ClassOfSlow(c);
+  }
+  int ClassOfSlow(base::uc16 c) const;
+  uint8_t FlagsAfter(base::uc16 c) const;
+
+  // Returns the id of the state, or kCacheFull.
+  int Intern(const std::vector<int>& pcs, uint8_t flags);
+  // Returns the transition table entry, or kCacheFull.
+  int32_t ComputeTransition(int state, int char_class);
+  bool IsIdle(int state) const;
+  void FlushCache();
+  Result GiveUp();
+  // Flushes the cache while {search} is at {position} if that pays off.
+  bool MakeRoom(Search* search, int position);
+
+  const std::vector<RegExpInstruction> bytecode_;
+  const size_t max_cache_size_;
+  bool has_assertions_ = false;
+  // The pc in the unanchored preamble at which a thread starts a new match
+  // attempt at every position, or -1 if there is no such preamble.
+  int idle_pc_ = -1;
+
+  // The input characters are partitioned into classes of characters that
+  // the program cannot tell apart.  Class k consists of the characters from
+  // class_starts_[k] up to the next start; the class with index
+  // class_count() stands for the end of the input.
+  std::vector<base::uc16> class_starts_;
+  static constexpr int kLatin1ClassTableSize = 256;
+  uint16_t latin1_classes_[kLatin1ClassTableSize];
+  int class_count() const { return static_cast<int>(class_starts_.size()); }
+  int stride() const { return class_count() + 1; }
+
+  std::vector<State> states_;
+  // Keys are the pcs of a state followed by its flags.
+  std::unordered_map<std::vector<int>, int, StateKeyHash> state_ids_;
+  // stride() entries per state.
+  std::vector<int32_t> transitions_;
+  size_t cache_size_ = 0;
+  // Incremented on every flush, which invalidates all state ids.
+  int cache_epoch_ = 0;
+
+  int give_up_count_ = 0;
+  bool disabled_ = false;
+
+  // Scratch space of ComputeTransition.
+  std::vector<int> stack_;
+  std::vector<int> blocked_;
+  std::vector<int> next_pcs_;
+  std::vector<uint32_t> pc_visited_;
+  uint32_t visit_generation_ = 0;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_REGEXP_EXPERIMENTAL_EXPERIMENTAL_DFA_H_
@@ -9,6 +9,7 @@
 #include "src/common/assert-scope.h"
 #include "src/objects/fixed-array-inl.h"
 #include "src/objects/string-inl.h"
+#include "src/regexp/experimental/experimental-dfa.h"
 #include "src/regexp/experimental/experimental.h"
 #include "src/strings/char-predicates-inl.h"
 #include "src/zone/zone-allocator.h"
@@ -137,12 +138,14 @@ class NfaInterpreter {
   // ACCEPTing thread with highest priority.
  public:
   NfaInterpreter(Isolate* isolate, RegExp::CallOrigin call_origin,
-                 ByteArray bytecode, int register_count_per_match, String input,
+                 ByteArray bytecode, std::shared_ptr<ExperimentalDfa> dfa,
+                 int register_count_per_match, String input,
                  int32_t input_index, Zone* zone)
       : isolate_(isolate),
         call_origin_(call_origin),
         bytecode_object_(bytecode),
         bytecode_(ToInstructionVector(bytecode, no_gc_)),
+        dfa_(std::move(dfa)),
         register_count_per_match_(register_count_per_match),
         input_object_(input),
         input_(ToCharacterVector<Character>(input, no_gc_)),
@@ -328,6 +331,14 @@ class NfaInterpreter {
       best_match_registers_ = base::nullopt;
     }
 
+    int dfa_match_end = -1;
+    if (dfa_ != nullptr && !dfa_->disabled()) {
+      bool has_match = true;
+      int err_code = SkipToDfaMatch(&has_match, &dfa_match_end);
+      if (err_code != RegExp::kInternalRegExpSuccess) return err_code;
+      if (!has_match) return RegExp::kInternalRegExpSuccess;
+    }
+
     // All threads start at bytecode 0.
     active_threads_.Add(
         InterpreterThread{0, NewRegisterArray(kUndefinedRegisterValue)}, zone_);
@@ -361,6 +372,40 @@ class NfaInterpreter {
       RunActiveThreads();
     }
 
+    DCHECK_IMPLIES(dfa_match_end != -1,
+                   FoundMatch() && (*best_match_registers_)[1] == dfa_match_end);
+    return RegExp::kInternalRegExpSuccess;
+  }
+
+  // Searches for the next match with the lazy DFA, which is much faster than
+  // running the threads but doesn't compute captures.  If there is no match,
+  // `has_match` is set to false.  Otherwise `input_index_` is advanced to
+  // where running the threads finds the same match, and its end is written to
+  // `match_end`.  If the DFA gives up, nothing changes.  Returns
+  // RegExp::kInternalRegExpSuccess or an error code due to interrupt.
+  int SkipToDfaMatch(bool* has_match, int* match_end) {
+    ExperimentalDfa::Search search(input_index_);
+    base::Optional<ExperimentalDfa::Result> result;
+    while (true) {
+      static constexpr int kCharsBetweenInterruptHandling = 4096;
+      result = dfa_->Run(input_, &search,
+                         search.position + kCharsBetweenInterruptHandling);
+      if (result.has_value()) break;
+      int err_code = HandleInterrupts();
+      if (err_code != RegExp::kInternalRegExpSuccess) return err_code;
+    }
+
+    switch (*result) {
+      case ExperimentalDfa::Result::kMatch:
+        SetInputIndex(search.restart_position);
+        *match_end = search.match_end;
+        break;
+      case ExperimentalDfa::Result::kNoMatch:
+        *has_match = false;
+        break;
+      case ExperimentalDfa::Result::kGaveUp:
+        break;
+    }
     return RegExp::kInternalRegExpSuccess;
   }
 
@@ -519,6 +564,11 @@ class NfaInterpreter {
   ByteArray bytecode_object_;
   base::Vector<const RegExpInstruction> bytecode_;
 
+  // The lazy DFA of the bytecode, if any.
+  // Owned jointly with the regexp, since interrupts can run JavaScript that
+  // recompiles the regexp and drops its reference.
+  const std::shared_ptr<ExperimentalDfa> dfa_;
+
   // Number of registers used per thread.
   const int register_count_per_match_;
 
@@ -558,21 +608,22 @@ class NfaInterpreter {
 
 int ExperimentalRegExpInterpreter::FindMatches(
     Isolate* isolate, RegExp::CallOrigin call_origin, ByteArray bytecode,
-    int register_count_per_match, String input, int start_index,
-    int32_t* output_registers, int output_register_count, Zone* zone) {
+    const std::shared_ptr<ExperimentalDfa>& dfa, int register_count_per_match,
+    String input, int start_index, int32_t* output_registers,
+    int output_register_count, Zone* zone) {
   DCHECK(input.IsFlat());
   DisallowGarbageCollection no_gc;
 
   if (input.GetFlatContent(no_gc).IsOneByte()) {
-    NfaInterpreter<uint8_t> interpreter(isolate, call_origin, bytecode,
+    NfaInterpreter<uint8_t> interpreter(isolate, call_origin, bytecode, dfa,
                                         register_count_per_match, input,
                                         start_index, zone);
     return interpreter.FindMatches(output_registers, output_register_count);
   } else {
     DCHECK(input.GetFlatContent(no_gc).IsTwoByte());
     NfaInterpreter<base::uc16> interpreter(isolate, call_origin, bytecode,
-                                           register_count_per_match, input,
-                                           start_index, zone);
+                                           dfa, register_count_per_match,
+                                           input, start_index, zone);
     return interpreter.FindMatches(output_registers, output_register_count);
   }
 }
@@ -5,6 +5,8 @@
 #ifndef V8_REGEXP_EXPERIMENTAL_EXPERIMENTAL_INTERPRETER_H_
 #define V8_REGEXP_EXPERIMENTAL_EXPERIMENTAL_INTERPRETER_H_
 
+#include <memory>
+
 #include "src/regexp/experimental/experimental-bytecode.h"
 #include "src/regexp/regexp.h"
 
@@ -12,6 +14,7 @@ namespace v8 {
 namespace internal {
 
 class ByteArray;
+class ExperimentalDfa;
 class String;
 class Zone;
 
@@ -22,11 +25,15 @@ class ExperimentalRegExpInterpreter final : public AllStatic {
   // `max_match_num` matches in `input`, starting at `start_index`.  Returns
   // the actual number of matches found.  The boundaries of matching subranges
   // are written to `matches_out`.  Provided in variants for one-byte and
-  // two-byte strings.
+  // two-byte strings.  If `dfa` is not null, it is used to skip the parts of
+  // the input that don't contain a match.  The interpreter shares ownership
+  // of `dfa`, which stays alive even if interrupts replace the regexp's data.
   static int FindMatches(Isolate* isolate, RegExp::CallOrigin call_origin,
-                         ByteArray bytecode, int capture_count, String input,
-                         int start_index, int32_t* output_registers,
-                         int output_register_count, Zone* zone);
+                         ByteArray bytecode,
+                         const std::shared_ptr<ExperimentalDfa>& dfa,
+                         int capture_count, String input, int start_index,
+                         int32_t* output_registers, int output_register_count,
+                         Zone* zone);
 };
 
 }  // namespace internal
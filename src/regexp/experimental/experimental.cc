@@ -6,7 +6,9 @@
 
 #include "src/common/assert-scope.h"
 #include "src/objects/js-regexp-inl.h"
+#include "src/objects/managed-inl.h"
 #include "src/regexp/experimental/experimental-compiler.h"
+#include "src/regexp/experimental/experimental-dfa.h"
 #include "src/regexp/experimental/experimental-interpreter.h"
 #include "src/regexp/regexp-parser.h"
 #include "src/utils/ostreams.h"
@@ -96,8 +98,20 @@ base::Optional<CompilationResult> CompileImpl(Isolate* isolate,
   return result;
 }
 
+size_t DfaCacheSize() {
+  return FLAG_experimental_regexp_engine_dfa_cache_kb * KB;
+}
+
 }  // namespace
 
+base::Vector<RegExpInstruction> AsInstructionSequence(ByteArray raw_bytes) {
+  RegExpInstruction* inst_begin =
+      reinterpret_cast<RegExpInstruction*>(raw_bytes.GetDataStartAddress());
+  int inst_num = raw_bytes.length() / sizeof(RegExpInstruction);
+  DCHECK_EQ(sizeof(RegExpInstruction) * inst_num, raw_bytes.length());
+  return base::Vector<RegExpInstruction>(inst_begin, inst_num);
+}
+
 bool ExperimentalRegExp::Compile(Isolate* isolate, Handle<JSRegExp> re) {
   DCHECK(FLAG_enable_experimental_regexp_engine);
   DCHECK_EQ(re->type_tag(), JSRegExp::EXPERIMENTAL);
@@ -120,21 +134,30 @@ bool ExperimentalRegExp::Compile(Isolate* isolate, Handle<JSRegExp> re) {
   re->set_bytecode_and_trampoline(isolate, compilation_result->bytecode);
   re->set_capture_name_map(compilation_result->capture_name_map);
 
-  return true;
-}
+  if (FLAG_experimental_regexp_engine_lazy_dfa) {
+    // The DFA is built while matching, when we can't allocate on the heap, so
+    // it lives off-heap. Only its initial size is reported: most regexps
+    // never fill the cache, and reporting the cache limit for each of them
+    // would trigger GCs for memory that is not used.
+    auto dfa = std::make_unique<ExperimentalDfa>(
+        AsInstructionSequence(*compilation_result->bytecode), DfaCacheSize());
+    size_t dfa_size = dfa->InitialSize();
+    Handle<Managed<ExperimentalDfa>> managed_dfa =
+        Managed<ExperimentalDfa>::FromUniquePtr(isolate, dfa_size,
+                                                std::move(dfa));
+    FixedArray::cast(re->data()).set(JSRegExp::kExperimentalDfaIndex,
+                                     *managed_dfa);
+  }
 
-base::Vector<RegExpInstruction> AsInstructionSequence(ByteArray raw_bytes) {
-  RegExpInstruction* inst_begin =
-      reinterpret_cast<RegExpInstruction*>(raw_bytes.GetDataStartAddress());
-  int inst_num = raw_bytes.length() / sizeof(RegExpInstruction);
-  DCHECK_EQ(sizeof(RegExpInstruction) * inst_num, raw_bytes.length());
-  return base::Vector<RegExpInstruction>(inst_begin, inst_num);
+  return true;
 }
 
 namespace {
 
 int32_t ExecRawImpl(Isolate* isolate, RegExp::CallOrigin call_origin,
-                    ByteArray bytecode, String subject, int capture_count,
+                    ByteArray bytecode,
+                    const std::shared_ptr<ExperimentalDfa>& dfa,
+                    String subject, int capture_count,
                     int32_t* output_registers, int32_t output_register_count,
                     int32_t subject_index) {
   DisallowGarbageCollection no_gc;
@@ -149,8 +172,9 @@ int32_t ExecRawImpl(Isolate* isolate, RegExp::CallOrigin call_origin,
     DCHECK(subject.IsFlat());
     Zone zone(isolate->allocator(), ZONE_NAME);
     result = ExperimentalRegExpInterpreter::FindMatches(
-        isolate, call_origin, bytecode, register_count_per_match, subject,
-        subject_index, output_registers, output_register_count, &zone);
+        isolate, call_origin, bytecode, dfa, register_count_per_match,
+        subject, subject_index, output_registers, output_register_count,
+        &zone);
   } while (result == RegExp::kInternalRegExpRetry &&
            call_origin == RegExp::kFromRuntime);
   return result;
@@ -175,8 +199,17 @@ int32_t ExperimentalRegExp::ExecRaw(Isolate* isolate,
 
   static constexpr bool kIsLatin1 = true;
   ByteArray bytecode = ByteArray::cast(regexp.bytecode(kIsLatin1));
+  Object dfa_object =
+      FixedArray::cast(regexp.data()).get(JSRegExp::kExperimentalDfaIndex);
+  // Keep the DFA alive for the whole call: handling interrupts can run
+  // JavaScript that recompiles the regexp, after which a GC frees the old
+  // Managed<ExperimentalDfa>.
+  std::shared_ptr<ExperimentalDfa> dfa;
+  if (!dfa_object.IsSmi()) {
+    dfa = Managed<ExperimentalDfa>::cast(dfa_object).get();
+  }
 
-  return ExecRawImpl(isolate, call_origin, bytecode, subject,
+  return ExecRawImpl(isolate, call_origin, bytecode, dfa, subject,
                      regexp.capture_count(), output_registers,
                      output_register_count, subject_index);
 }
@@ -274,8 +307,13 @@ int32_t ExperimentalRegExp::OneshotExecRaw(Isolate* isolate,
   if (!compilation_result.has_value()) return RegExp::kInternalRegExpException;
 
   DisallowGarbageCollection no_gc;
+  std::shared_ptr<ExperimentalDfa> dfa;
+  if (FLAG_experimental_regexp_engine_lazy_dfa) {
+    dfa = std::make_shared<ExperimentalDfa>(
+        AsInstructionSequence(*compilation_result->bytecode), DfaCacheSize());
+  }
   return ExecRawImpl(isolate, RegExp::kFromRuntime,
-                     *compilation_result->bytecode, *subject,
+                     *compilation_result->bytecode, dfa, *subject,
                      regexp->capture_count(), output_registers,
                      output_register_count, subject_index);
 }
@@ -1010,7 +1010,8 @@ RegExpNode* RegExpLookaround::ToNode(RegExpCompiler* compiler,
 
   const int registers_per_capture = 2;
   const int register_of_first_capture = 2;
-  int register_count = capture_count_ * registers_per_capture;
+  int register_count =
+      compiler->capture_free() ? 0 : capture_count_ * registers_per_capture;
   int register_start =
       register_of_first_capture + capture_from_ * registers_per_capture;
 
@@ -1034,6 +1035,9 @@ RegExpNode* RegExpCapture::ToNode(RegExpTree* body, int index,
                                   RegExpCompiler* compiler,
                                   RegExpNode* on_success) {
   DCHECK_NOT_NULL(body);
+  if (index > 0 && compiler->capture_free()) {
+    return body->ToNode(compiler, on_success);
+  }
   int start_reg = RegExpCapture::StartRegister(index);
   int end_reg = RegExpCapture::EndRegister(index);
   if (compiler->read_backward()) std::swap(start_reg, end_reg);
@@ -1614,7 +1618,9 @@ RegExpNode* RegExpQuantifier::ToNode(int min, int max, bool is_greedy,
   if (max == 0) return on_success;  // This can happen due to recursion.
   bool body_can_be_empty = (body->min_match() == 0);
   int body_start_reg = RegExpCompiler::kNoRegister;
-  Interval capture_registers = body->CaptureRegisters();
+  Interval capture_registers = compiler->capture_free()
+                                   ? Interval::Empty()
+                                   : body->CaptureRegisters();
   bool needs_capture_clearing = !capture_registers.is_empty();
   Zone* zone = compiler->zone();
 
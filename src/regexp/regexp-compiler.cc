@@ -7,6 +7,7 @@
 #include "src/base/safe_conversions.h"
 #include "src/execution/isolate.h"
 #include "src/objects/fixed-array-inl.h"
+#include "src/objects/js-regexp.h"
 #include "src/regexp/regexp-macro-assembler-arch.h"
 #include "src/strings/unicode-inl.h"
 #include "src/zone/zone-list-inl.h"
@@ -238,14 +239,17 @@ class RecursionCheck {
 // Attempts to compile the regexp using an Irregexp code generator.  Returns
 // a fixed array or a null handle depending on whether it succeeded.
 RegExpCompiler::RegExpCompiler(Isolate* isolate, Zone* zone, int capture_count,
-                               RegExpFlags flags, bool one_byte)
-    : next_register_(JSRegExp::RegistersForCaptureCount(capture_count)),
+                               RegExpFlags flags, bool one_byte,
+                               bool capture_free)
+    : next_register_(
+          JSRegExp::RegistersForCaptureCount(capture_free ? 0 : capture_count)),
       unicode_lookaround_stack_register_(kNoRegister),
       unicode_lookaround_position_register_(kNoRegister),
       work_list_(nullptr),
       recursion_depth_(0),
       flags_(flags),
       one_byte_(one_byte),
+      capture_free_(capture_free),
       reg_exp_too_big_(false),
       limiting_recursion_(false),
       optimize_(FLAG_regexp_optimization),
@@ -3950,6 +3954,183 @@ RegExpNode* RegExpCompiler::PreprocessRegExp(RegExpCompileData* data,
   return node;
 }
 
+namespace {
+
+// Shorter literals occur too often to pay for the search.
+constexpr size_t kMinPrefilterLength = 2;
+// Offsets are small in practice. The limit keeps the sums from overflowing.
+constexpr int kMaxPrefilterOffset = 1 << 16;
+
+// Collects the longest literal that every match of a tree contains. Only
+// one-byte literals are collected: they cover the patterns that benefit most,
+// e.g. those for log lines, and can be searched for in any subject.
+class PrefilterCollector {
+ public:
+  struct Literal {
+    // The characters of the literal, or nullptr if there is none.
+    ZoneVector<uint8_t>* chars = nullptr;
+    // The distance between the start of the match and the literal.
+    int offset = JSRegExp::kNoPrefilterOffset;
+    // Whether the tree matches exactly the literal. Such literals are joined
+    // with adjacent ones.
+    bool is_whole = false;
+  };
+
+  PrefilterCollector(Zone* zone, RegExpFlags flags)
+      : zone_(zone), flags_(flags) {}
+
+  Literal Collect(RegExpTree* tree, int depth) {
+    if (depth > RegExpCompiler::kMaxRecursion) return {};
+    if (tree->IsAtom()) return CollectAtom(tree->AsAtom());
+    if (tree->IsText()) {
+      ZoneList<TextElement>* elements = tree->AsText()->elements();
+      ZoneList<RegExpTree*> nodes(elements->length(), zone_);
+      for (const TextElement& element : *elements) {
+        nodes.Add(element.tree(), zone_);
+      }
+      return CollectSequence(&nodes, depth);
+    }
+    if (tree->IsAlternative()) {
+      return CollectSequence(tree->AsAlternative()->nodes(), depth);
+    }
+    if (tree->IsCapture()) {
+      return Collect(tree->AsCapture()->body(), depth + 1);
+    }
+    if (tree->IsGroup()) return Collect(tree->AsGroup()->body(), depth + 1);
+    if (tree->IsQuantifier()) {
+      RegExpQuantifier* quantifier = tree->AsQuantifier();
+      if (quantifier->min() == 0) return {};
+      // The first repetition starts where the quantifier does.
+      Literal literal = Collect(quantifier->body(), depth + 1);
+      literal.is_whole = literal.is_whole && quantifier->max() == 1;
+      return literal;
+    }
+    // Disjunctions would need a set of literals. Lookarounds and back
+    // references don't consume the characters they look at.
+    return {};
+  }
+
+ private:
+  Literal CollectAtom(RegExpAtom* atom) {
+    ZoneVector<uint8_t>* chars = zone_->New<ZoneVector<uint8_t>>(zone_);
+    for (base::uc16 c : atom->data()) {
+      if (c > kMaxUInt8) return {};
+      chars->push_back(static_cast<uint8_t>(c));
+    }
+    return {chars, 0, true};
+  }
+
+  Literal CollectSequence(ZoneList<RegExpTree*>* nodes, int depth) {
+    Literal best;
+    Literal run;
+    bool all_whole = true;
+    // The distance between the start of the match and the current node.
+    int offset = 0;
+    for (RegExpTree* node : *nodes) {
+      Literal literal = Collect(node, depth + 1);
+      if (literal.is_whole) {
+        if (run.chars == nullptr) {
+          run.chars = zone_->New<ZoneVector<uint8_t>>(
+              literal.chars->begin(), literal.chars->end(), zone_);
+          run.offset = offset;
+        } else {
+          run.chars->insert(run.chars->end(), literal.chars->begin(),
+                            literal.chars->end());
+        }
+      } else {
+        all_whole = false;
+        best = Longer(best, run);
+        run = {};
+        literal.offset = Add(offset, literal.offset);
+        best = Longer(best, literal);
+      }
+      offset = Add(offset, FixedLength(node, depth + 1));
+    }
+    best = Longer(best, run);
+    best.is_whole = all_whole && best.chars != nullptr;
+    return best;
+  }
+
+  // Returns the number of characters that every match of {tree} consumes, or
+  // kNoPrefilterOffset if that number varies.
+  int FixedLength(RegExpTree* tree, int depth) {
+    static constexpr int kVaries = JSRegExp::kNoPrefilterOffset;
+    if (depth > RegExpCompiler::kMaxRecursion) return kVaries;
+    // Character classes can match surrogate pairs in unicode mode only.
+    if (tree->IsCharacterClass()) return IsUnicode(flags_) ? kVaries : 1;
+    if (tree->IsCapture()) {
+      return FixedLength(tree->AsCapture()->body(), depth + 1);
+    }
+    if (tree->IsGroup()) return FixedLength(tree->AsGroup()->body(), depth + 1);
+    if (tree->IsQuantifier()) {
+      RegExpQuantifier* quantifier = tree->AsQuantifier();
+      if (quantifier->min() != quantifier->max()) return kVaries;
+      int length = FixedLength(quantifier->body(), depth + 1);
+      if (length == kVaries) return kVaries;
+      if (length != 0 && quantifier->min() > kMaxPrefilterOffset / length) {
+        return kVaries;
+      }
+      return quantifier->min() * length;
+    }
+    if (tree->IsAlternative()) {
+      int length = 0;
+      for (RegExpTree* node : *tree->AsAlternative()->nodes()) {
+        length = Add(length, FixedLength(node, depth + 1));
+      }
+      return length;
+    }
+    if (tree->min_match() != tree->max_match()) return kVaries;
+    return tree->min_match() <= kMaxPrefilterOffset ? tree->min_match()
+                                                     : kVaries;
+  }
+
+  static int Add(int a, int b) {
+    if (a == JSRegExp::kNoPrefilterOffset ||
+        b == JSRegExp::kNoPrefilterOffset || a + b > kMaxPrefilterOffset) {
+      return JSRegExp::kNoPrefilterOffset;
+    }
+    return a + b;
+  }
+
+  // Prefers longer literals, then those at a known offset.
+  static Literal Longer(Literal a, Literal b) {
+    if (b.chars == nullptr) return a;
+    if (a.chars == nullptr || b.chars->size() > a.chars->size()) return b;
+    if (b.chars->size() == a.chars->size() &&
+        a.offset == JSRegExp::kNoPrefilterOffset &&
+        b.offset != JSRegExp::kNoPrefilterOffset) {
+      return b;
+    }
+    return a;
+  }
+
+  Zone* const zone_;
+  const RegExpFlags flags_;
+};
+
+}  // namespace
+
+void RegExpCompiler::ExtractPrefilter(RegExpCompileData* data) {
+  // Anchored regexps only try a few positions, which is cheaper than a search
+  // through the subject. Sticky ones are typically run at many consecutive
+  // positions, and each run would search the rest of the subject. The search
+  // doesn't know about case folding.
+  if (!FLAG_regexp_prefilter || IsIgnoreCase(flags()) || IsSticky(flags()) ||
+      data->tree->IsAnchoredAtStart() || data->tree->IsAnchoredAtEnd()) {
+    return;
+  }
+  PrefilterCollector collector(zone(), flags());
+  PrefilterCollector::Literal literal = collector.Collect(data->tree, 0);
+  if (literal.chars == nullptr || literal.chars->size() < kMinPrefilterLength) {
+    return;
+  }
+  data->prefilter = literal.chars;
+  // Unicode regexps may step back into a surrogate pair before the start
+  // position, so the start position is only used to fail early.
+  data->prefilter_offset =
+      IsUnicode(flags()) ? JSRegExp::kNoPrefilterOffset : literal.offset;
+}
+
 void RegExpCompiler::ToNodeCheckForStackOverflow() {
   if (StackLimitCheck{isolate()}.HasOverflowed()) {
     V8::FatalProcessOutOfMemory(isolate(), "RegExpCompiler");
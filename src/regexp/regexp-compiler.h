@@ -451,8 +451,10 @@ class FrequencyCollator {
 
 class RegExpCompiler {
  public:
+  // If {capture_free} is set, capture groups other than the match itself
+  // are compiled to their bodies and allocate no registers.
   RegExpCompiler(Isolate* isolate, Zone* zone, int capture_count,
-                 RegExpFlags flags, bool is_one_byte);
+                 RegExpFlags flags, bool is_one_byte, bool capture_free);
 
   int AllocateRegister() {
     if (next_register_ >= RegExpMacroAssembler::kMaxRegister) {
@@ -511,6 +513,12 @@ class RegExpCompiler {
   // lead surrogate and start matching from there.
   RegExpNode* OptionallyStepBackToLeadSurrogate(RegExpNode* on_success);
 
+  // Looks for a literal that every match contains and records it in
+  // data->prefilter. Before running the regexp, the subject is searched for
+  // the literal in order to skip the positions that can't start a match, or
+  // to fail right away.
+  void ExtractPrefilter(RegExpCompileData* data);
+
   inline void AddWork(RegExpNode* node) {
     if (!node->on_work_list() && !node->label()->is_bound()) {
       node->set_on_work_list(true);
@@ -535,6 +543,7 @@ class RegExpCompiler {
   void SetRegExpTooBig() { reg_exp_too_big_ = true; }
 
   inline bool one_byte() { return one_byte_; }
+  inline bool capture_free() { return capture_free_; }
   inline bool optimize() { return optimize_; }
   inline void set_optimize(bool value) { optimize_ = value; }
   inline bool limiting_recursion() { return limiting_recursion_; }
@@ -577,6 +586,7 @@ class RegExpCompiler {
   const RegExpFlags flags_;
   RegExpMacroAssembler* macro_assembler_;
   bool one_byte_;
+  const bool capture_free_;
   bool reg_exp_too_big_;
   bool limiting_recursion_;
   int to_node_overflow_check_ticks_ = 0;
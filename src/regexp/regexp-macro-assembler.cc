@@ -369,7 +369,8 @@ int NativeRegExpMacroAssembler::Match(Handle<JSRegExp> regexp,
                                       Handle<String> subject,
                                       int* offsets_vector,
                                       int offsets_vector_length,
-                                      int previous_index, Isolate* isolate) {
+                                      int previous_index, Isolate* isolate,
+                                      bool capture_free) {
   DCHECK(subject->IsFlat());
   DCHECK_LE(0, previous_index);
   DCHECK_LE(previous_index, subject->length());
@@ -409,7 +410,7 @@ int NativeRegExpMacroAssembler::Match(Handle<JSRegExp> regexp,
   int byte_length = char_length << char_size_shift;
   const byte* input_end = input_start + byte_length;
   return Execute(*subject, start_offset, input_start, input_end, offsets_vector,
-                 offsets_vector_length, isolate, *regexp);
+                 offsets_vector_length, isolate, *regexp, capture_free);
 }
 
 // static
@@ -418,7 +419,7 @@ int NativeRegExpMacroAssembler::ExecuteForTesting(
     const byte* input_end, int* output, int output_size, Isolate* isolate,
     JSRegExp regexp) {
   return Execute(input, start_offset, input_start, input_end, output,
-                 output_size, isolate, regexp);
+                 output_size, isolate, regexp, false);
 }
 
 // Returns a {Result} sentinel, or the number of successful matches.
@@ -428,11 +429,14 @@ int NativeRegExpMacroAssembler::ExecuteForTesting(
 int NativeRegExpMacroAssembler::Execute(
     String input,  // This needs to be the unpacked (sliced, cons) string.
     int start_offset, const byte* input_start, const byte* input_end,
-    int* output, int output_size, Isolate* isolate, JSRegExp regexp) {
+    int* output, int output_size, Isolate* isolate, JSRegExp regexp,
+    bool capture_free) {
   RegExpStackScope stack_scope(isolate);
 
   bool is_one_byte = String::IsOneByteRepresentationUnderneath(input);
-  Code code = FromCodeT(CodeT::cast(regexp.code(is_one_byte)));
+  Code code = FromCodeT(CodeT::cast(capture_free
+                                        ? regexp.capture_free_code(is_one_byte)
+                                        : regexp.code(is_one_byte)));
   RegExp::CallOrigin call_origin = RegExp::CallOrigin::kFromRuntime;
 
   using RegexpMatcherSig =
@@ -295,9 +295,11 @@ class NativeRegExpMacroAssembler: public RegExpMacroAssembler {
   ~NativeRegExpMacroAssembler() override = default;
 
   // Returns a {Result} sentinel, or the number of successful matches.
+  // If {capture_free} is set, the capture-free code is run, which only
+  // stores the bounds of each match in the offsets vector.
   static int Match(Handle<JSRegExp> regexp, Handle<String> subject,
                    int* offsets_vector, int offsets_vector_length,
-                   int previous_index, Isolate* isolate);
+                   int previous_index, Isolate* isolate, bool capture_free);
 
   V8_EXPORT_PRIVATE static int ExecuteForTesting(String input, int start_offset,
                                                  const byte* input_start,
@@ -347,7 +349,7 @@ class NativeRegExpMacroAssembler: public RegExpMacroAssembler {
   // Returns a {Result} sentinel, or the number of successful matches.
   static int Execute(String input, int start_offset, const byte* input_start,
                      const byte* input_end, int* output, int output_size,
-                     Isolate* isolate, JSRegExp regexp);
+                     Isolate* isolate, JSRegExp regexp, bool capture_free);
 
   std::unordered_map<uint32_t, Handle<ByteArray>> range_array_cache_;
 };
@@ -247,6 +247,8 @@ class RegExpParserImpl final {
   bool simple() const { return simple_; }
   bool contains_anchor() const { return contains_anchor_; }
   void set_contains_anchor() { contains_anchor_ = true; }
+  bool has_back_references() const { return has_back_references_; }
+  void set_has_back_references() { has_back_references_ = true; }
   int captures_started() const { return captures_started_; }
   int position() const { return next_pos_ - 1; }
   bool failed() const { return failed_; }
@@ -341,6 +343,7 @@ class RegExpParserImpl final {
   bool has_more_;
   bool simple_;
   bool contains_anchor_;
+  bool has_back_references_;
   bool is_scanned_for_captures_;
   bool has_named_captures_;  // Only valid after we have scanned for captures.
   bool failed_;
@@ -373,6 +376,7 @@ RegExpParserImpl<CharT>::RegExpParserImpl(
       has_more_(true),
       simple_(false),
       contains_anchor_(false),
+      has_back_references_(false),
       is_scanned_for_captures_(false),
       has_named_captures_(false),
       failed_(false),
@@ -694,6 +698,7 @@ RegExpTree* RegExpParserImpl<CharT>::ParseDisjunction() {
                 RegExpTree* atom = zone()->template New<RegExpBackReference>(
                     capture, builder->flags());
                 builder->AddAtom(atom);
+                set_has_back_references();
               }
               break;
             }
@@ -1195,6 +1200,7 @@ bool RegExpParserImpl<CharT>::ParseNamedBackReference(
     atom->set_name(name);
 
     builder->AddAtom(atom);
+    set_has_back_references();
 
     if (named_back_references_ == nullptr) {
       named_back_references_ =
@@ -2049,6 +2055,7 @@ bool RegExpParserImpl<CharT>::Parse(RegExpCompileData* result) {
   const int capture_count = captures_started();
   result->simple = tree->IsAtom() && simple() && capture_count == 0;
   result->contains_anchor = contains_anchor();
+  result->has_back_references = has_back_references();
   result->capture_count = capture_count;
   result->named_captures = GetNamedCaptures();
   return true;
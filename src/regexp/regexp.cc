@@ -68,9 +68,11 @@ class RegExpImpl final : public AllStatic {
   // The captures and subcaptures are stored into the registers vector.
   // If matching fails, returns RE_FAILURE.
   // If execution fails, sets a pending exception and returns RE_EXCEPTION.
+  // If {capture_free} is set, only the bounds of each match are stored, and
+  // RE_RETRY is returned if there is no capture-free code for the subject.
   static int IrregexpExecRaw(Isolate* isolate, Handle<JSRegExp> regexp,
                              Handle<String> subject, int index, int32_t* output,
-                             int output_size);
+                             int output_size, bool capture_free = false);
 
   // Execute an Irregexp bytecode pattern.
   // On a successful match, the result is a JSArray containing
@@ -88,6 +90,16 @@ class RegExpImpl final : public AllStatic {
                                             Handle<String> sample_subject,
                                             bool is_one_byte);
 
+  // Compiles native code that only records the bounds of the match. Returns
+  // false if the regexp can't be compiled that way; no exception is thrown
+  // in that case, since the full code can be used instead.
+  static bool CompileIrregexpCaptureFree(Isolate* isolate, Handle<JSRegExp> re,
+                                         Handle<String> sample_subject,
+                                         bool is_one_byte);
+  static inline bool EnsureCompiledIrregexpCaptureFree(
+      Isolate* isolate, Handle<JSRegExp> re, Handle<String> sample_subject,
+      bool is_one_byte);
+
   // Returns true on success, false on failure.
   static bool Compile(Isolate* isolate, Zone* zone, RegExpCompileData* input,
                       RegExpFlags flags, Handle<String> pattern,
@@ -454,6 +466,18 @@ bool RegExpImpl::EnsureCompiledIrregexp(Isolate* isolate, Handle<JSRegExp> re,
   return CompileIrregexp(isolate, re, sample_subject, is_one_byte);
 }
 
+bool RegExpImpl::EnsureCompiledIrregexpCaptureFree(
+    Isolate* isolate, Handle<JSRegExp> re, Handle<String> sample_subject,
+    bool is_one_byte) {
+  DCHECK(!re->ShouldProduceBytecode());
+  Object compiled_code = re->capture_free_code(is_one_byte);
+  if (compiled_code.IsCodeT()) return true;
+  if (compiled_code == Smi::FromInt(JSRegExp::kNoCaptureFreeCode)) {
+    return false;
+  }
+  return CompileIrregexpCaptureFree(isolate, re, sample_subject, is_one_byte);
+}
+
 namespace {
 
 #ifdef DEBUG
@@ -594,6 +618,16 @@ bool RegExpImpl::CompileIrregexp(Isolate* isolate, Handle<JSRegExp> re,
     SetIrregexpMaxRegisterCount(*data, compile_data.register_count);
   }
   data->set(JSRegExp::kIrregexpBacktrackLimit, Smi::FromInt(backtrack_limit));
+  if (compile_data.prefilter != nullptr) {
+    Handle<String> prefilter =
+        isolate->factory()
+            ->NewStringFromOneByte(base::VectorOf(*compile_data.prefilter),
+                                   AllocationType::kOld)
+            .ToHandleChecked();
+    data->set(JSRegExp::kIrregexpPrefilterIndex, *prefilter);
+    data->set(JSRegExp::kIrregexpPrefilterOffsetIndex,
+              Smi::FromInt(compile_data.prefilter_offset));
+  }
 
   if (FLAG_trace_regexp_tier_up) {
     PrintF("JSRegExp object %p %s size: %d\n",
@@ -607,6 +641,51 @@ bool RegExpImpl::CompileIrregexp(Isolate* isolate, Handle<JSRegExp> re,
   return true;
 }
 
+bool RegExpImpl::CompileIrregexpCaptureFree(Isolate* isolate,
+                                            Handle<JSRegExp> re,
+                                            Handle<String> sample_subject,
+                                            bool is_one_byte) {
+  Zone zone(isolate->allocator(), ZONE_NAME);
+  PostponeInterruptsScope postpone(isolate);
+
+  DCHECK(re->capture_free_code(is_one_byte) ==
+         Smi::FromInt(JSRegExp::kUninitializedValue));
+
+  RegExpFlags flags = JSRegExp::AsRegExpFlags(re->flags());
+  Handle<FixedArray> data =
+      Handle<FixedArray>(FixedArray::cast(re->data()), isolate);
+  Smi no_code = Smi::FromInt(JSRegExp::kNoCaptureFreeCode);
+
+  Handle<String> pattern(re->source(), isolate);
+  pattern = String::Flatten(isolate, pattern);
+  RegExpCompileData compile_data;
+  // Back references need the captures they refer to. Parsing only fails here
+  // if we run out of stack.
+  if (!RegExpParser::ParseRegExpFromHeapString(isolate, &zone, pattern, flags,
+                                               &compile_data) ||
+      compile_data.has_back_references) {
+    data->set(JSRegExp::kIrregexpLatin1CaptureFreeCodeIndex, no_code);
+    data->set(JSRegExp::kIrregexpUC16CaptureFreeCodeIndex, no_code);
+    return false;
+  }
+  compile_data.compilation_target = RegExpCompilationTarget::kNative;
+  compile_data.capture_free = true;
+  uint32_t backtrack_limit = re->backtrack_limit();
+  if (!Compile(isolate, &zone, &compile_data, flags, pattern, sample_subject,
+               is_one_byte, backtrack_limit)) {
+    data->set(JSRegExp::capture_free_code_index(is_one_byte), no_code);
+    return false;
+  }
+
+  Code code = Code::cast(*compile_data.code);
+  data->set(JSRegExp::capture_free_code_index(is_one_byte), ToCodeT(code));
+  int register_max = IrregexpMaxRegisterCount(*data);
+  if (compile_data.register_count > register_max) {
+    SetIrregexpMaxRegisterCount(*data, compile_data.register_count);
+  }
+  return true;
+}
+
 int RegExpImpl::IrregexpMaxRegisterCount(FixedArray re) {
   return Smi::ToInt(re.get(JSRegExp::kIrregexpMaxRegisterCountIndex));
 }
@@ -654,26 +733,71 @@ int RegExpImpl::IrregexpPrepare(Isolate* isolate, Handle<JSRegExp> regexp,
   return JSRegExp::RegistersForCaptureCount(regexp->capture_count());
 }
 
+namespace {
+
+// Returns the position to start matching at, skipping the positions at which
+// no match can start because the regexp's prefilter literal doesn't occur at
+// the right distance. Returns -1 if the literal doesn't occur at all.
+// RegExpBuiltinsAssembler::SkipToPrefilterCandidate is the CSA counterpart.
+int SkipToPrefilterCandidate(Isolate* isolate, JSRegExp regexp,
+                             String subject, int index) {
+  DisallowGarbageCollection no_gc;
+  FixedArray data = FixedArray::cast(regexp.data());
+  Object prefilter = data.get(JSRegExp::kIrregexpPrefilterIndex);
+  if (prefilter.IsSmi()) return index;
+
+  SeqOneByteString literal = SeqOneByteString::cast(prefilter);
+  int offset = Smi::ToInt(data.get(JSRegExp::kIrregexpPrefilterOffsetIndex));
+  int search_start = index + std::max(offset, 0);
+  if (search_start + literal.length() > subject.length()) return -1;
+
+  base::Vector<const uint8_t> pattern(literal.GetChars(no_gc),
+                                      literal.length());
+  String::FlatContent content = subject.GetFlatContent(no_gc);
+  int found =
+      content.IsOneByte()
+          ? SearchString(isolate, content.ToOneByteVector(), pattern,
+                         search_start)
+          : SearchString(isolate, content.ToUC16Vector(), pattern,
+                         search_start);
+  if (found == -1) return -1;
+  return offset == JSRegExp::kNoPrefilterOffset ? index : found - offset;
+}
+
+}  // namespace
+
 int RegExpImpl::IrregexpExecRaw(Isolate* isolate, Handle<JSRegExp> regexp,
                                 Handle<String> subject, int index,
-                                int32_t* output, int output_size) {
+                                int32_t* output, int output_size,
+                                bool capture_free) {
   DCHECK_LE(0, index);
   DCHECK_LE(index, subject->length());
   DCHECK(subject->IsFlat());
-  DCHECK_GE(output_size,
-            JSRegExp::RegistersForCaptureCount(regexp->capture_count()));
+  DCHECK_GE(output_size, JSRegExp::RegistersForCaptureCount(
+                             capture_free ? 0 : regexp->capture_count()));
+
+  index = SkipToPrefilterCandidate(isolate, *regexp, *subject, index);
+  if (index == -1) return RegExp::RE_FAILURE;
 
   bool is_one_byte = String::IsOneByteRepresentationUnderneath(*subject);
 
   if (!regexp->ShouldProduceBytecode()) {
     do {
-      EnsureCompiledIrregexp(isolate, regexp, subject, is_one_byte);
+      if (!capture_free) {
+        EnsureCompiledIrregexp(isolate, regexp, subject, is_one_byte);
+      } else if (!EnsureCompiledIrregexpCaptureFree(isolate, regexp, subject,
+                                                    is_one_byte)) {
+        // The subject changed its representation, and there is no
+        // capture-free code for the new one. The caller has to switch to the
+        // full code.
+        return RegExp::RE_RETRY;
+      }
       // The stack is used to allocate registers for the compiled regexp code.
       // This means that in case of failure, the output registers array is left
       // untouched and contains the capture results from the previous successful
       // match.  We can use that to set the last match info lazily.
-      int res = NativeRegExpMacroAssembler::Match(regexp, subject, output,
-                                                  output_size, index, isolate);
+      int res = NativeRegExpMacroAssembler::Match(
+          regexp, subject, output, output_size, index, isolate, capture_free);
       if (res != NativeRegExpMacroAssembler::RETRY) {
         DCHECK(res != NativeRegExpMacroAssembler::EXCEPTION ||
                isolate->has_pending_exception());
@@ -696,6 +820,7 @@ int RegExpImpl::IrregexpExecRaw(Isolate* isolate, Handle<JSRegExp> regexp,
     UNREACHABLE();
   } else {
     DCHECK(regexp->ShouldProduceBytecode());
+    DCHECK(!capture_free);
 
     do {
       IrregexpInterpreter::Result result =
@@ -877,8 +1002,9 @@ bool RegExpImpl::Compile(Isolate* isolate, Zone* zone, RegExpCompileData* data,
     return false;
   }
 
+  DCHECK_IMPLIES(data->capture_free, !data->has_back_references);
   RegExpCompiler compiler(isolate, zone, data->capture_count, flags,
-                          is_one_byte);
+                          is_one_byte, data->capture_free);
 
   if (compiler.optimize()) {
     compiler.set_optimize(!TooMuchRegExpCode(isolate, pattern));
@@ -897,6 +1023,7 @@ bool RegExpImpl::Compile(Isolate* isolate, Zone* zone, RegExpCompileData* data,
   }
 
   data->node = compiler.PreprocessRegExp(data, flags, is_one_byte);
+  compiler.ExtractPrefilter(data);
   data->error = AnalyzeRegExp(isolate, is_one_byte, flags, data->node);
   if (data->error != RegExpError::kNone) {
     return false;
@@ -914,8 +1041,8 @@ bool RegExpImpl::Compile(Isolate* isolate, Zone* zone, RegExpCompileData* data,
         is_one_byte ? NativeRegExpMacroAssembler::LATIN1
                     : NativeRegExpMacroAssembler::UC16;
 
-    const int output_register_count =
-        JSRegExp::RegistersForCaptureCount(data->capture_count);
+    const int output_register_count = JSRegExp::RegistersForCaptureCount(
+        data->capture_free ? 0 : data->capture_count);
 #if V8_TARGET_ARCH_IA32
     macro_assembler.reset(new RegExpMacroAssemblerIA32(isolate, zone, mode,
                                                        output_register_count));
@@ -1042,7 +1169,8 @@ bool RegExpImpl::Compile(Isolate* isolate, Zone* zone, RegExpCompileData* data,
 }
 
 RegExpGlobalCache::RegExpGlobalCache(Handle<JSRegExp> regexp,
-                                     Handle<String> subject, Isolate* isolate)
+                                     Handle<String> subject, Isolate* isolate,
+                                     bool needs_captures)
     : register_array_(nullptr),
       register_array_size_(0),
       regexp_(regexp),
@@ -1076,6 +1204,18 @@ RegExpGlobalCache::RegExpGlobalCache(Handle<JSRegExp> regexp,
       } else {
         register_array_size_ = std::max(
             {registers_per_match_, Isolate::kJSRegexpStaticOffsetsVectorSize});
+        // Without captures, more matches fit into a batch, and the code
+        // doesn't spend time on recording them. Regexps without capture
+        // groups only record the match anyway.
+        if (!needs_captures && FLAG_regexp_capture_free_code &&
+            regexp->capture_count() > 0 &&
+            RegExpImpl::EnsureCompiledIrregexpCaptureFree(
+                isolate_, regexp_, subject_,
+                String::IsOneByteRepresentationUnderneath(*subject_))) {
+          capture_free_ = true;
+          last_match_captures_.reset(new int32_t[registers_per_match_]);
+          registers_per_match_ = JSRegExp::RegistersForCaptureCount(0);
+        }
       }
       break;
     }
@@ -1134,6 +1274,17 @@ int RegExpGlobalCache::AdvanceZeroLength(int last_index) {
 }
 
 int32_t* RegExpGlobalCache::FetchNext() {
+  int32_t* next_match = FetchNextBatchEntry();
+  if (next_match == nullptr && capture_free_ && num_matches_ == 0) {
+    // The last match is final now, so it's time to find its captures.
+    int32_t* last_match =
+        &register_array_[(current_match_index_ - 1) * registers_per_match_];
+    if (last_match[0] >= 0) RecoverCaptures(last_match);
+  }
+  return next_match;
+}
+
+int32_t* RegExpGlobalCache::FetchNextBatchEntry() {
   current_match_index_++;
 
   if (current_match_index_ >= num_matches_) {
@@ -1176,13 +1327,23 @@ int32_t* RegExpGlobalCache::FetchNext() {
         }
         num_matches_ = RegExpImpl::IrregexpExecRaw(
             isolate_, regexp_, subject_, last_end_index, register_array_,
-            register_array_size_);
+            register_array_size_, capture_free_);
+        if (num_matches_ == RegExp::kInternalRegExpRetry) {
+          // The subject changed its representation, and the capture-free
+          // code for it can't be compiled.
+          if (!UseFullCode()) return nullptr;
+          num_matches_ = RegExpImpl::IrregexpExecRaw(
+              isolate_, regexp_, subject_, last_end_index, register_array_,
+              register_array_size_);
+        }
         break;
       }
     }
 
     // Fall back to experimental engine if needed and possible.
     if (num_matches_ == RegExp::kInternalRegExpFallbackToExperimental) {
+      // The experimental engine records all captures.
+      if (capture_free_ && !UseFullCode()) return nullptr;
       num_matches_ = ExperimentalRegExp::OneshotExecRaw(
           isolate_, regexp_, subject_, register_array_, register_array_size_,
           last_end_index);
@@ -1198,7 +1359,54 @@ int32_t* RegExpGlobalCache::FetchNext() {
   }
 }
 
+bool RegExpGlobalCache::RecoverCaptures(int32_t* match) {
+  DCHECK(capture_free_);
+  DCHECK_LE(0, match[0]);
+  const int register_count =
+      JSRegExp::RegistersForCaptureCount(regexp_->capture_count());
+  int32_t* captures = last_match_captures_.get();
+  // There are no back references, so the captures don't affect where the
+  // regexp matches, and the full code finds the same match.
+  int result = RegExpImpl::IrregexpExecRaw(isolate_, regexp_, subject_,
+                                           match[0], captures, register_count);
+  if (result == RegExp::kInternalRegExpFallbackToExperimental) {
+    result = ExperimentalRegExp::OneshotExecRaw(
+        isolate_, regexp_, subject_, captures, register_count, match[0]);
+  }
+  if (result < 0) {
+    num_matches_ = -1;  // Signal exception.
+    return false;
+  }
+  DCHECK_EQ(1, result);
+  DCHECK_EQ(match[0], captures[0]);
+  DCHECK_EQ(match[1], captures[1]);
+  return true;
+}
+
+bool RegExpGlobalCache::UseFullCode() {
+  DCHECK(capture_free_);
+  // If the next batch has no match, the last match of the previous batch is
+  // the last successful one, so it has to be where the full code would have
+  // put it, with its captures.
+  int32_t* last_match =
+      &register_array_[(current_match_index_ - 1) * registers_per_match_];
+  const bool has_last_match = last_match[0] >= 0;
+  if (has_last_match && !RecoverCaptures(last_match)) return false;
+
+  capture_free_ = false;
+  registers_per_match_ =
+      JSRegExp::RegistersForCaptureCount(regexp_->capture_count());
+  max_matches_ = register_array_size_ / registers_per_match_;
+  current_match_index_ = max_matches_;
+  if (has_last_match) {
+    std::copy_n(last_match_captures_.get(), registers_per_match_,
+                &register_array_[(max_matches_ - 1) * registers_per_match_]);
+  }
+  return true;
+}
+
 int32_t* RegExpGlobalCache::LastSuccessfulMatch() {
+  if (capture_free_) return last_match_captures_.get();
   int index = current_match_index_ * registers_per_match_;
   if (num_matches_ == 0) {
     // After a failed match we shift back by one result.
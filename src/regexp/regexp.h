@@ -5,6 +5,8 @@
 #ifndef V8_REGEXP_REGEXP_H_
 #define V8_REGEXP_REGEXP_H_
 
+#include <memory>
+
 #include "src/common/assert-scope.h"
 #include "src/handles/handles.h"
 #include "src/regexp/regexp-error.h"
@@ -43,6 +45,9 @@ struct RegExpCompileData {
   // True, iff the pattern is anchored at the start of the string with '^'.
   bool contains_anchor = false;
 
+  // True, iff the pattern contains back references.
+  bool has_back_references = false;
+
   // Only set if the pattern contains named captures.
   // Note: the lifetime equals that of the parse/compile zone.
   ZoneVector<RegExpCapture*>* named_captures = nullptr;
@@ -61,8 +66,21 @@ struct RegExpCompileData {
   // The number of registers used by the generated code.
   int register_count = 0;
 
+  // A one-byte literal that every match contains, or nullptr. Only set if the
+  // literal is worth searching for before running the regexp.
+  // Note: the lifetime equals that of the parse/compile zone.
+  ZoneVector<uint8_t>* prefilter = nullptr;
+
+  // The distance between the start of a match and the prefilter literal, or
+  // JSRegExp::kNoPrefilterOffset if it varies.
+  int prefilter_offset = -1;
+
   // The compilation target (bytecode or native code).
   RegExpCompilationTarget compilation_target;
+
+  // True, iff the generated code only records the bounds of the match and
+  // not the captures. Only valid for patterns without back references.
+  bool capture_free = false;
 };
 
 class RegExp final : public AllStatic {
@@ -171,8 +189,11 @@ class RegExp final : public AllStatic {
 // iterator over multiple results (retrieved batch-wise in advance).
 class RegExpGlobalCache final {
  public:
+  // If {needs_captures} is false, the results of FetchNext may consist of
+  // the bounds of the match only. This allows running code that doesn't
+  // record captures, and fitting more matches into one batch.
   RegExpGlobalCache(Handle<JSRegExp> regexp, Handle<String> subject,
-                    Isolate* isolate);
+                    Isolate* isolate, bool needs_captures = true);
 
   ~RegExpGlobalCache();
 
@@ -182,12 +203,19 @@ class RegExpGlobalCache final {
   // still in available in memory when a failure happens.
   int32_t* FetchNext();
 
+  // Returns the last match including its captures.
   int32_t* LastSuccessfulMatch();
 
   bool HasException() { return num_matches_ < 0; }
 
  private:
+  int32_t* FetchNextBatchEntry();
   int AdvanceZeroLength(int last_index);
+  // Matches the full regexp at the start of {match} to fill in the captures
+  // that the capture-free code doesn't record.
+  bool RecoverCaptures(int32_t* match);
+  // Switches from the capture-free code to the full code between batches.
+  bool UseFullCode();
 
   int num_matches_;
   int max_matches_;
@@ -196,6 +224,10 @@ class RegExpGlobalCache final {
   // Pointer to the last set of captures.
   int32_t* register_array_;
   int register_array_size_;
+  // Whether the capture-free code is run, which stores two registers per
+  // match. The captures of the last match are then kept separately.
+  bool capture_free_ = false;
+  std::unique_ptr<int32_t[]> last_match_captures_;
   Handle<JSRegExp> regexp_;
   Handle<String> subject_;
   Isolate* isolate_;
@@ -651,7 +651,9 @@ V8_WARN_UNUSED_RESULT static Object StringReplaceGlobalRegExpWithString(
     }
   }
 
-  RegExpGlobalCache global_cache(regexp, subject, isolate);
+  // Only a replacement that refers to captures needs them for every match.
+  const bool needs_captures = !simple_replace;
+  RegExpGlobalCache global_cache(regexp, subject, isolate, needs_captures);
   if (global_cache.HasException()) return ReadOnlyRoots(isolate).exception();
 
   int32_t* current_match = global_cache.FetchNext();
@@ -718,7 +720,8 @@ V8_WARN_UNUSED_RESULT static Object StringReplaceGlobalRegExpWithEmptyString(
     }
   }
 
-  RegExpGlobalCache global_cache(regexp, subject, isolate);
+  const bool needs_captures = false;
+  RegExpGlobalCache global_cache(regexp, subject, isolate, needs_captures);
   if (global_cache.HasException()) return ReadOnlyRoots(isolate).exception();
 
   int32_t* current_match = global_cache.FetchNext();
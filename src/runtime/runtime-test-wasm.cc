@@ -20,6 +20,7 @@
 #include "src/wasm/wasm-module.h"
 #include "src/wasm/wasm-objects-inl.h"
 #include "src/wasm/wasm-serialization.h"
+#include "src/wasm/wasm-tiering-feedback.h"
 
 namespace v8 {
 namespace internal {
@@ -371,6 +372,35 @@ RUNTIME_FUNCTION(Runtime_DeserializeWasmModule) {
   return *module_object;
 }
 
+RUNTIME_FUNCTION(Runtime_WasmSerializeTieringFeedback) {
+  HandleScope scope(isolate);
+  DCHECK_EQ(1, args.length());
+  Handle<WasmModuleObject> module_obj = args.at<WasmModuleObject>(0);
+  base::OwnedVector<uint8_t> feedback =
+      wasm::WasmTieringFeedback::Export(module_obj->native_module());
+  Handle<JSArrayBuffer> array_buffer =
+      isolate->factory()
+          ->NewJSArrayBufferAndBackingStore(feedback.size(),
+                                            InitializedFlag::kUninitialized)
+          .ToHandleChecked();
+  if (!feedback.empty()) {
+    memcpy(array_buffer->backing_store(), feedback.start(), feedback.size());
+  }
+  return *array_buffer;
+}
+
+RUNTIME_FUNCTION(Runtime_WasmImportTieringFeedback) {
+  HandleScope scope(isolate);
+  DCHECK_EQ(1, args.length());
+  Handle<JSArrayBuffer> buffer = args.at<JSArrayBuffer>(0);
+  CHECK(!buffer->was_detached());
+  base::Vector<const uint8_t> feedback{
+      reinterpret_cast<const uint8_t*>(buffer->backing_store()),
+      buffer->byte_length()};
+  return isolate->heap()->ToBoolean(
+      wasm::GetWasmEngine()->ImportTieringFeedback(feedback));
+}
+
 RUNTIME_FUNCTION(Runtime_WasmGetNumberOfInstances) {
   SealHandleScope shs(isolate);
   DCHECK_EQ(1, args.length());
@@ -400,6 +430,15 @@ RUNTIME_FUNCTION(Runtime_WasmNumCodeSpaces) {
   return *isolate->factory()->NewNumberFromSize(num_spaces);
 }
 
+RUNTIME_FUNCTION(Runtime_WasmReclaimedCodeSize) {
+  DCHECK_EQ(1, args.length());
+  HandleScope scope(isolate);
+  Handle<WasmInstanceObject> instance = args.at<WasmInstanceObject>(0);
+  size_t reclaimed_size =
+      instance->module_object().native_module()->reclaimed_code_size();
+  return *isolate->factory()->NewNumberFromSize(reclaimed_size);
+}
+
 RUNTIME_FUNCTION(Runtime_WasmTraceMemory) {
   HandleScope scope(isolate);
   DCHECK_EQ(1, args.length());
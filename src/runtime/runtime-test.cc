@@ -10,6 +10,7 @@
 #include "src/api/api-inl.h"
 #include "src/base/numbers/double.h"
 #include "src/base/platform/mutex.h"
+#include "src/baseline/baseline-batch-compiler.h"
 #include "src/codegen/assembler-inl.h"
 #include "src/codegen/compiler.h"
 #include "src/codegen/pending-optimization-table.h"
@@ -815,6 +816,12 @@ RUNTIME_FUNCTION(Runtime_WaitForBackgroundOptimization) {
   return ReadOnlyRoots(isolate).undefined_value();
 }
 
+RUNTIME_FUNCTION(Runtime_WaitForBaselineBatchCompilation) {
+  DCHECK_EQ(0, args.length());
+  isolate->baseline_batch_compiler()->AwaitCompileTasksForTesting();
+  return ReadOnlyRoots(isolate).undefined_value();
+}
+
 RUNTIME_FUNCTION(Runtime_FinalizeOptimization) {
   DCHECK_EQ(0, args.length());
   if (isolate->concurrent_recompilation_enabled()) {
@@ -574,6 +574,7 @@ namespace internal {
   F(TurbofanStaticAssert, 1, 1)               \
   F(TypedArraySpeciesProtector, 0, 1)         \
   F(WaitForBackgroundOptimization, 0, 1)      \
+  F(WaitForBaselineBatchCompilation, 0, 1)    \
   I(DeoptimizeNow, 0, 1)
 
 #define FOR_EACH_INTRINSIC_TYPEDARRAY(F, I)    \
@@ -638,7 +639,10 @@ namespace internal {
   F(SetWasmCompileControls, 2, 1)          \
   F(SetWasmInstantiateControls, 0, 1)      \
   F(WasmGetNumberOfInstances, 1, 1)        \
+  F(WasmImportTieringFeedback, 1, 1)       \
   F(WasmNumCodeSpaces, 1, 1)               \
+  F(WasmReclaimedCodeSize, 1, 1)           \
+  F(WasmSerializeTieringFeedback, 1, 1)    \
   F(WasmTierDown, 0, 1)                    \
   F(WasmTierUp, 0, 1)                      \
   F(WasmTierUpFunction, 2, 1)              \
@@ -12,6 +12,7 @@
 namespace v8 {
 namespace internal {
 
+class BackgroundMergeTask;
 class PersistentHandles;
 
 class V8_EXPORT_PRIVATE AlignedCachedData {
@@ -62,6 +63,12 @@ enum class SerializedCodeSanityCheckResult {
 class CodeSerializer : public Serializer {
  public:
   struct OffThreadDeserializeData {
+   public:
+    bool HasResult() const { return !maybe_result.is_null(); }
+    // Returns a handle to the deserialized Script in {heap}, which has to be
+    // the current thread's local heap.
+    Handle<Script> GetOnlyScript(LocalHeap* heap);
+
    private:
     friend class CodeSerializer;
     MaybeHandle<SharedFunctionInfo> maybe_result;
@@ -90,7 +97,8 @@ class CodeSerializer : public Serializer {
   FinishOffThreadDeserialize(Isolate* isolate, OffThreadDeserializeData&& data,
                              AlignedCachedData* cached_data,
                              Handle<String> source,
-                             ScriptOriginOptions origin_options);
+                             ScriptOriginOptions origin_options,
+                             BackgroundMergeTask* background_merge_task);
 
   uint32_t source_hash() const { return source_hash_; }
 
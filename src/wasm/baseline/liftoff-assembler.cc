@@ -717,6 +717,34 @@ void LiftoffAssembler::PrepareLoopArgs(int num) {
   }
 }
 
+void LiftoffAssembler::PrepareLoopLocals(int min_free_regs) {
+  auto num_free_regs = [this](RegClass rc) {
+    return GetCacheRegList(rc)
+        .MaskOut(cache_state_.used_registers)
+        .GetNumRegsSet();
+  };
+  int free_gp_regs = num_free_regs(kGpReg);
+  int free_fp_regs = num_free_regs(kFpReg);
+  // Spill from the last local, such that the parameters, which are often the
+  // hottest locals, are the last to lose their registers.
+  for (uint32_t i = num_locals_; i > 0; --i) {
+    VarState* slot = &cache_state_.stack_state[i - 1];
+    if (slot->is_stack()) continue;
+    if (slot->is_reg()) {
+      LiftoffRegister reg = slot->reg();
+      int* free_regs = reg.is_gp_pair() || reg.is_gp() ? &free_gp_regs
+                                                       : &free_fp_regs;
+      int regs_per_slot = reg.is_pair() ? 2 : 1;
+      if (cache_state_.get_use_count(reg) == 1 &&
+          *free_regs >= min_free_regs) {
+        continue;
+      }
+      if (cache_state_.get_use_count(reg) == 1) *free_regs += regs_per_slot;
+    }
+    Spill(slot);
+  }
+}
+
 void LiftoffAssembler::MaterializeMergedConstants(uint32_t arity) {
   // Materialize constants on top of the stack ({arity} many), and locals.
   VarState* stack_base = cache_state_.stack_state.data();
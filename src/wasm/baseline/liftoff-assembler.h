@@ -538,6 +538,13 @@ class LiftoffAssembler : public TurboAssembler {
   // stack, so that we can merge different values on the back-edge.
   void PrepareLoopArgs(int num);
 
+  // Prepare the locals for entering a loop. Locals stay in their registers
+  // as long as at least {min_free_regs} registers of each class stay free
+  // for the loop body; the remaining locals are spilled. A local can only
+  // keep a register that no other stack slot uses, since the loop body can
+  // assign a different value to it.
+  void PrepareLoopLocals(int min_free_regs);
+
   V8_INLINE static int NextSpillOffset(ValueKind kind, int top_spill_offset) {
     int offset = top_spill_offset + SlotSizeForType(kind);
     if (NeedsAlignment(kind)) {
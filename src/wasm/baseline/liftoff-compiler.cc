@@ -102,6 +102,10 @@ constexpr ValueKind kPointerKind = LiftoffAssembler::kPointerKind;
 constexpr ValueKind kSmiKind = LiftoffAssembler::kSmiKind;
 constexpr ValueKind kTaggedKind = LiftoffAssembler::kTaggedKind;
 
+// Locals are kept in registers across loop headers as long as this many
+// registers of each class remain available for the loop body.
+constexpr int kMinFreeRegistersInLoops = 4;
+
 // Used to construct fixed-size signatures: MakeSig::Returns(...).Params(...);
 using MakeSig = FixedSizeSignature<ValueKind>;
 
@@ -1186,12 +1190,23 @@ class LiftoffCompiler {
   void Block(FullDecoder* decoder, Control* block) { PushControl(block); }
 
   void Loop(FullDecoder* decoder, Control* loop) {
-    // Before entering a loop, spill all locals to the stack, in order to free
-    // the cache registers, and to avoid unnecessarily reloading stack values
-    // into registers at branches.
-    // TODO(clemensb): Come up with a better strategy here, involving
-    // pre-analysis of the function.
-    __ SpillLocals();
+    if (for_debugging_) {
+      // Debug code expects locals on the stack at every breakpoint anyway.
+      __ SpillLocals();
+    } else {
+      // Keep locals in registers across the loop header, such that the loop
+      // body and the back-edges do not need to reload and spill them. Spill
+      // locals only if too few registers would be left for the loop body.
+      __ PrepareLoopLocals(kMinFreeRegistersInLoops);
+      // Cache the memory start across the loop, if it is not cached already
+      // and registers allow. Otherwise it would be reloaded in every
+      // iteration that accesses memory.
+      if (env_->module->has_memory &&
+          __ cache_state()->cached_mem_start == no_reg &&
+          NumFreeGpRegisters() > kMinFreeRegistersInLoops) {
+        GetMemoryStart({});
+      }
+    }
 
     __ PrepareLoopArgs(loop->start_merge.arity);
 
@@ -3070,6 +3085,11 @@ class LiftoffCompiler {
     return true;
   }
 
+  int NumFreeGpRegisters() const {
+    return kGpCacheRegList.MaskOut(asm_.cache_state()->used_registers)
+        .GetNumRegsSet();
+  }
+
   Register GetMemoryStart(LiftoffRegList pinned) {
     Register memory_start = __ cache_state()->cached_mem_start;
     if (memory_start == no_reg) {
@@ -6630,6 +6650,23 @@ class LiftoffCompiler {
   }
 
  private:
+  // Records the {target} of the next feedback-collecting call instruction.
+  // The targets can already be known from an earlier compilation of this
+  // function, or from imported tiering feedback.
+  void RecordCallTarget(FullDecoder* decoder, uint32_t target) {
+    base::MutexGuard mutex_guard(&decoder->module_->type_feedback.mutex);
+    std::vector<uint32_t>& call_targets =
+        decoder->module_->type_feedback.feedback_for_function[func_index_]
+            .call_targets;
+    if (num_call_instructions_ < call_targets.size()) {
+      call_targets[num_call_instructions_] = target;
+    } else {
+      DCHECK_EQ(num_call_instructions_, call_targets.size());
+      call_targets.push_back(target);
+    }
+    num_call_instructions_++;
+  }
+
   void CallDirect(FullDecoder* decoder,
                   const CallFunctionImmediate<validate>& imm,
                   const Value args[], Value returns[], TailCall tail_call) {
@@ -6647,10 +6684,7 @@ class LiftoffCompiler {
     // computations much more complicated.
     uintptr_t vector_slot = num_call_instructions_ * 2;
     if (FLAG_wasm_speculative_inlining) {
-      base::MutexGuard mutex_guard(&decoder->module_->type_feedback.mutex);
-      decoder->module_->type_feedback.feedback_for_function[func_index_]
-          .call_targets.push_back(imm.index);
-      num_call_instructions_++;
+      RecordCallTarget(decoder, imm.index);
     }
 
     if (imm.index < env_->module->num_imported_functions) {
@@ -6887,12 +6921,7 @@ class LiftoffCompiler {
       LiftoffAssembler::VarState vector_var(kPointerKind, vector, 0);
       LiftoffRegister index = pinned.set(__ GetUnusedRegister(kGpReg, pinned));
       uintptr_t vector_slot = num_call_instructions_ * 2;
-      {
-        base::MutexGuard mutex_guard(&decoder->module_->type_feedback.mutex);
-        decoder->module_->type_feedback.feedback_for_function[func_index_]
-            .call_targets.push_back(FunctionTypeFeedback::kNonDirectCall);
-      }
-      num_call_instructions_++;
+      RecordCallTarget(decoder, FunctionTypeFeedback::kNonDirectCall);
       __ LoadConstant(index, WasmValue::ForUintPtr(vector_slot));
       LiftoffAssembler::VarState index_var(kIntPtrKind, index, 0);
 
@@ -116,6 +116,9 @@ class WireBytesStorage {
 enum class CompilationEvent : uint8_t {
   kFinishedBaselineCompilation,
   kFinishedExportWrappers,
+  // All functions reached their requested top tier. Only triggered without
+  // dynamic tiering.
+  kFinishedTopTierCompilation,
   kFinishedCompilationChunk,
   kFailedCompilation,
   kFinishedRecompilation
@@ -163,7 +166,8 @@ class V8_EXPORT_PRIVATE CompilationState {
 
   void InitializeAfterDeserialization(
       base::Vector<const int> lazy_functions,
-      base::Vector<const int> liftoff_functions);
+      base::Vector<const int> liftoff_functions,
+      base::Vector<const int> lazily_deserialized_functions);
 
   // Set a higher priority for the compilation job.
   void SetHighPriority();
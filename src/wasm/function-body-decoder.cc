@@ -84,6 +84,37 @@ unsigned OpcodeLength(const byte* pc, const byte* end) {
   return WasmDecoder<Decoder::kNoValidation>::OpcodeLength(&decoder, pc);
 }
 
+bool CollectCallTargets(AccountingAllocator* allocator,
+                        const WasmModule* module, const byte* start,
+                        const byte* end, std::vector<uint32_t>* targets) {
+  Zone zone(allocator, ZONE_NAME);
+  WasmFeatures unused_detected_features = WasmFeatures::None();
+  WasmDecoder<Decoder::kFullValidation> decoder(
+      &zone, module, WasmFeatures::All(), &unused_detected_features, nullptr,
+      start, end);
+  uint32_t locals_length;
+  if (decoder.DecodeLocals(start, &locals_length, 0) < 0) return false;
+  for (const byte* pc = start + locals_length; pc < end;) {
+    switch (static_cast<WasmOpcode>(*pc)) {
+      case kExprCallFunction:
+      case kExprReturnCall: {
+        CallFunctionImmediate<Decoder::kFullValidation> imm(&decoder, pc + 1);
+        targets->push_back(imm.index);
+        break;
+      }
+      case kExprCallRef:
+      case kExprReturnCallRef:
+        targets->push_back(FunctionTypeFeedback::kNonDirectCall);
+        break;
+      default:
+        break;
+    }
+    pc += WasmDecoder<Decoder::kFullValidation>::OpcodeLength(&decoder, pc);
+    if (decoder.failed()) return false;
+  }
+  return true;
+}
+
 bool CheckHardwareSupportsSimd() { return CpuFeatures::SupportsWasmSimd128(); }
 
 std::pair<uint32_t, uint32_t> StackEffect(const WasmModule* module,
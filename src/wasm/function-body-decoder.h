@@ -9,6 +9,8 @@
 #ifndef V8_WASM_FUNCTION_BODY_DECODER_H_
 #define V8_WASM_FUNCTION_BODY_DECODER_H_
 
+#include <vector>
+
 #include "src/base/compiler-specific.h"
 #include "src/base/iterator.h"
 #include "src/common/globals.h"
@@ -80,6 +82,15 @@ V8_EXPORT_PRIVATE BitVector* AnalyzeLoopAssignmentForTesting(
 // Computes the length of the opcode at the given address.
 V8_EXPORT_PRIVATE unsigned OpcodeLength(const byte* pc, const byte* end);
 
+// Appends the static target of each call instruction in the function body
+// between {start} and {end} that collects call feedback to {targets}, in the
+// format of {FunctionTypeFeedback::call_targets}. Calls in unreachable code
+// are included. Returns false if the body cannot be decoded.
+V8_EXPORT_PRIVATE bool CollectCallTargets(AccountingAllocator* allocator,
+                                          const WasmModule* module,
+                                          const byte* start, const byte* end,
+                                          std::vector<uint32_t>* targets);
+
 // Computes the stack effect of the opcode at the given address.
 // Returns <pop count, push count>.
 // Be cautious with control opcodes: This function only covers their immediate,
@@ -30,6 +30,7 @@
 #include "src/wasm/module-decoder.h"
 #include "src/wasm/streaming-decoder.h"
 #include "src/wasm/wasm-code-manager.h"
+#include "src/wasm/wasm-disk-cache.h"
 #include "src/wasm/wasm-engine.h"
 #include "src/wasm/wasm-import-wrapper-cache.h"
 #include "src/wasm/wasm-js.h"
@@ -571,9 +572,12 @@ class CompilationStateImpl {
 
   // Initialize the compilation progress after deserialization. This is needed
   // for recompilation (e.g. for tier down) to work later.
+  // Functions in {lazily_deserialized_functions} already count as compiled
+  // with TurboFan, but use the lazy compile stub until they get deserialized.
   void InitializeCompilationProgressAfterDeserialization(
       base::Vector<const int> lazy_functions,
-      base::Vector<const int> liftoff_functions);
+      base::Vector<const int> liftoff_functions,
+      base::Vector<const int> lazily_deserialized_functions);
 
   // Initializes compilation units based on the information encoded in the
   // {compilation_progress_}.
@@ -764,6 +768,8 @@ class CompilationStateImpl {
 
   int outstanding_baseline_units_ = 0;
   int outstanding_export_wrappers_ = 0;
+  // Functions that did not reach their required top tier yet.
+  int outstanding_top_tier_functions_ = 0;
   // The amount of generated top tier code since the last
   // {kFinishedCompilationChunk} event.
   size_t bytes_since_last_chunk_ = 0;
@@ -856,9 +862,10 @@ void CompilationState::SetHighPriority() { Impl(this)->SetHighPriority(); }
 
 void CompilationState::InitializeAfterDeserialization(
     base::Vector<const int> lazy_functions,
-    base::Vector<const int> liftoff_functions) {
+    base::Vector<const int> liftoff_functions,
+    base::Vector<const int> lazily_deserialized_functions) {
   Impl(this)->InitializeCompilationProgressAfterDeserialization(
-      lazy_functions, liftoff_functions);
+      lazy_functions, liftoff_functions, lazily_deserialized_functions);
 }
 
 bool CompilationState::failed() const { return Impl(this)->failed(); }
@@ -955,6 +962,12 @@ ExecutionTierPair GetRequestedExecutionTiers(
   bool dynamic_tiering =
       Impl(native_module->compilation_state())->dynamic_tiering();
   bool tier_up_enabled = !dynamic_tiering && FLAG_wasm_tier_up;
+  // Functions which were hot in an earlier run are compiled with TurboFan right
+  // away. {known_hot_functions} does not change once compilation started.
+  if (dynamic_tiering &&
+      module->type_feedback.known_hot_functions.count(func_index) != 0) {
+    tier_up_enabled = true;
+  }
   if (module->origin != kWasmOrigin || !tier_up_enabled ||
       V8_UNLIKELY(FLAG_wasm_tier_up_filter >= 0 &&
                   func_index !=
@@ -1132,11 +1145,108 @@ void ValidateSequentially(
   }
 }
 
+// Validates the functions of a module on worker threads, with the calling
+// thread contributing. Eagerly compiled functions are validated as part of
+// their compilation, so only the lazily compiled functions need to be
+// validated upfront.
+class ValidateFunctionsJob final : public JobTask {
+ public:
+  ValidateFunctionsJob(const WasmModule* module, WasmFeatures enabled_features,
+                       ModuleWireBytes wire_bytes, bool lazy_module,
+                       OnlyLazyFunctions only_lazy_functions,
+                       std::atomic<bool>* found_error)
+      : module_(module),
+        enabled_features_(enabled_features),
+        wire_bytes_(wire_bytes),
+        lazy_module_(lazy_module),
+        only_lazy_functions_(only_lazy_functions),
+        next_function_(module->num_imported_functions),
+        end_function_(module->num_imported_functions +
+                      module->num_declared_functions),
+        found_error_(found_error) {}
+
+  void Run(JobDelegate* delegate) override {
+    TRACE_EVENT0("v8.wasm", "wasm.ValidateFunctions");
+    AccountingAllocator* allocator = GetWasmEngine()->allocator();
+    while (!found_error_->load(std::memory_order_relaxed)) {
+      uint32_t func_index =
+          next_function_.fetch_add(1, std::memory_order_relaxed);
+      if (func_index >= end_function_) return;
+      if (only_lazy_functions_) {
+        CompileStrategy strategy = GetCompileStrategy(
+            module_, enabled_features_, func_index, lazy_module_);
+        if (strategy != CompileStrategy::kLazy &&
+            strategy != CompileStrategy::kLazyBaselineEagerTopTier) {
+          continue;
+        }
+      }
+      const WasmFunction* func = &module_->functions[func_index];
+      DecodeResult result = ValidateSingleFunction(
+          module_, func_index, wire_bytes_.GetFunctionBytes(func), allocator,
+          enabled_features_);
+      if (result.failed()) {
+        found_error_->store(true, std::memory_order_relaxed);
+        return;
+      }
+      if (delegate && delegate->ShouldYield()) return;
+    }
+  }
+
+  size_t GetMaxConcurrency(size_t /* worker_count */) const override {
+    if (found_error_->load(std::memory_order_relaxed)) return 0;
+    uint32_t next_function = next_function_.load(std::memory_order_relaxed);
+    if (next_function >= end_function_) return 0;
+    return std::min(static_cast<size_t>(FLAG_wasm_num_compilation_tasks),
+                    static_cast<size_t>(end_function_ - next_function));
+  }
+
+ private:
+  const WasmModule* const module_;
+  const WasmFeatures enabled_features_;
+  const ModuleWireBytes wire_bytes_;
+  const bool lazy_module_;
+  const OnlyLazyFunctions only_lazy_functions_;
+  std::atomic<uint32_t> next_function_;
+  const uint32_t end_function_;
+  std::atomic<bool>* const found_error_;
+};
+
+// Validates the functions of {module} in parallel. Returns false if any of
+// them is invalid; {ValidateSequentially} then finds the first error, so that
+// the reported error does not depend on the scheduling of the workers.
+bool ValidateFunctions(const WasmModule* module, WasmFeatures enabled_features,
+                       ModuleWireBytes wire_bytes, bool lazy_module,
+                       OnlyLazyFunctions only_lazy_functions) {
+  std::atomic<bool> found_error{false};
+  auto job = std::make_unique<ValidateFunctionsJob>(
+      module, enabled_features, wire_bytes, lazy_module, only_lazy_functions,
+      &found_error);
+  if (FLAG_wasm_num_compilation_tasks > 0) {
+    V8::GetCurrentPlatform()
+        ->PostJob(TaskPriority::kUserVisible, std::move(job))
+        ->Join();
+  } else {
+    job->Run(nullptr);
+  }
+  return !found_error.load(std::memory_order_relaxed);
+}
+
 bool IsLazyModule(const WasmModule* module) {
   return FLAG_wasm_lazy_compilation ||
          (FLAG_asm_wasm_lazy_compilation && is_asmjs_module(module));
 }
 
+void LogLazyCode(Isolate* isolate, Handle<WasmModuleObject> module_object,
+                 WasmCode* code) {
+  if (!WasmCode::ShouldBeLogged(isolate)) return;
+  DisallowGarbageCollection no_gc;
+  Object url_obj = module_object->script().name();
+  DCHECK(url_obj.IsString() || url_obj.IsUndefined());
+  std::unique_ptr<char[]> url =
+      url_obj.IsString() ? String::cast(url_obj).ToCString() : nullptr;
+  code->LogCode(isolate, url.get(), module_object->script().id());
+}
+
 }  // namespace
 
 bool CompileLazy(Isolate* isolate, Handle<WasmInstanceObject> instance,
@@ -1157,6 +1267,25 @@ bool CompileLazy(Isolate* isolate, Handle<WasmInstanceObject> instance,
 
   DCHECK(!native_module->lazy_compile_frozen());
 
+  // Serialized TurboFan code only needs to be copied and relocated. While
+  // tiered down, compile debugging code instead.
+  LazilyDeserializedCode* lazily_deserialized_code =
+      native_module->lazily_deserialized_code();
+  if (lazily_deserialized_code &&
+      lazily_deserialized_code->HasFunction(func_index) &&
+      !native_module->IsTieredDown()) {
+    TRACE_LAZY("Deserializing wasm-function#%d.\n", func_index);
+    WasmCodeRefScope code_ref_scope;
+    CodeSpaceWriteScope code_space_write_scope(native_module);
+    // This returns nullptr if another isolate deserialized the function
+    // concurrently; the jump table is patched already in that case.
+    if (WasmCode* code =
+            lazily_deserialized_code->Deserialize(native_module, func_index)) {
+      LogLazyCode(isolate, module_object, code);
+    }
+    return true;
+  }
+
   TRACE_LAZY("Compiling wasm-function#%d.\n", func_index);
 
   base::ThreadTicks thread_ticks = base::ThreadTicks::IsSupported()
@@ -1212,14 +1341,7 @@ bool CompileLazy(Isolate* isolate, Handle<WasmInstanceObject> instance,
   }
   DCHECK_EQ(func_index, code->index());
 
-  if (WasmCode::ShouldBeLogged(isolate)) {
-    DisallowGarbageCollection no_gc;
-    Object url_obj = module_object->script().name();
-    DCHECK(url_obj.IsString() || url_obj.IsUndefined());
-    std::unique_ptr<char[]> url =
-        url_obj.IsString() ? String::cast(url_obj).ToCString() : nullptr;
-    code->LogCode(isolate, url.get(), module_object->script().id());
-  }
+  LogLazyCode(isolate, module_object, code);
 
   counters->wasm_lazily_compiled_functions()->Increment();
 
@@ -1736,6 +1858,11 @@ void InitializeLazyCompilation(NativeModule* native_module) {
 
 std::unique_ptr<CompilationUnitBuilder> InitializeCompilation(
     Isolate* isolate, NativeModule* native_module) {
+  // Streaming compilation does not know the wire bytes yet, so it cannot look
+  // up feedback from earlier runs.
+  if (native_module->HasWireBytes()) {
+    GetWasmEngine()->ApplyTieringFeedback(native_module);
+  }
   InitializeLazyCompilation(native_module);
   CompilationStateImpl* compilation_state =
       Impl(native_module->compilation_state());
@@ -1850,11 +1977,15 @@ void CompileNativeModule(Isolate* isolate,
     // Validate wasm modules for lazy compilation if requested. Never validate
     // asm.js modules as these are valid by construction (additionally a CHECK
     // will catch this during lazy compilation).
-    ValidateSequentially(wasm_module, native_module.get(), isolate->counters(),
-                         isolate->allocator(), thrower, lazy_module,
-                         kOnlyLazyFunctions);
-    // On error: Return and leave the module in an unexecutable state.
-    if (thrower->error()) return;
+    if (!ValidateFunctions(wasm_module, native_module->enabled_features(),
+                           wire_bytes, lazy_module, kOnlyLazyFunctions)) {
+      ValidateSequentially(wasm_module, native_module.get(),
+                           isolate->counters(), isolate->allocator(), thrower,
+                           lazy_module, kOnlyLazyFunctions);
+      // On error: Return and leave the module in an unexecutable state.
+      DCHECK(thrower->error());
+      return;
+    }
   }
 
   DCHECK_GE(kMaxInt, native_module->module()->num_declared_functions);
@@ -1972,6 +2103,9 @@ std::shared_ptr<NativeModule> CompileToNativeModule(
       engine->NewNativeModule(isolate, enabled, module, code_size_estimate);
   native_module->SetWireBytes(std::move(wire_bytes_copy));
   native_module->compilation_state()->set_compilation_id(compilation_id);
+  if (engine->disk_cache() && wasm_module->origin == kWasmOrigin) {
+    engine->disk_cache()->Observe(native_module);
+  }
   // Sync compilation is user blocking, so we increase the priority.
   native_module->compilation_state()->SetHighPriority();
 
@@ -2071,6 +2205,103 @@ void AsyncCompileJob::Abort() {
   GetWasmEngine()->RemoveCompileJob(this);
 }
 
+// The function bodies to validate during streaming compilation. The streaming
+// thread adds function bodies as they arrive, and the workers of a
+// {ValidateFunctionsStreamingJob} pick them up in order.
+class ValidateFunctionsStreamingJobData {
+ public:
+  struct Unit {
+    int func_index = -1;
+    base::Vector<const uint8_t> code;
+  };
+
+  explicit ValidateFunctionsStreamingJobData(int max_units)
+      : units_(base::OwnedVector<Unit>::New(max_units)) {}
+
+  // Called on the streaming thread only.
+  void AddUnit(int func_index, base::Vector<const uint8_t> code) {
+    size_t index = num_available_units_.load(std::memory_order_relaxed);
+    DCHECK_LT(index, units_.size());
+    units_[index] = {func_index, code};
+    num_available_units_.store(index + 1, std::memory_order_release);
+  }
+
+  // Returns the next unit to validate, or nullptr if all units that arrived
+  // so far are taken.
+  const Unit* GetUnit() {
+    size_t next = next_unit_.load(std::memory_order_relaxed);
+    do {
+      if (next >= num_available_units_.load(std::memory_order_acquire)) {
+        return nullptr;
+      }
+    } while (!next_unit_.compare_exchange_weak(next, next + 1,
+                                               std::memory_order_relaxed));
+    return &units_[next];
+  }
+
+  size_t NumOutstandingUnits() const {
+    size_t available = num_available_units_.load(std::memory_order_relaxed);
+    size_t next = next_unit_.load(std::memory_order_relaxed);
+    return next >= available ? 0 : available - next;
+  }
+
+  // The units added so far. Only valid once the job finished.
+  base::Vector<const Unit> units() const {
+    return units_.as_vector().SubVector(
+        0, num_available_units_.load(std::memory_order_relaxed));
+  }
+
+  void set_found_error() {
+    found_error_.store(true, std::memory_order_relaxed);
+  }
+  bool found_error() const {
+    return found_error_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  base::OwnedVector<Unit> units_;
+  std::atomic<size_t> num_available_units_{0};
+  std::atomic<size_t> next_unit_{0};
+  std::atomic<bool> found_error_{false};
+};
+
+class ValidateFunctionsStreamingJob final : public JobTask {
+ public:
+  ValidateFunctionsStreamingJob(std::shared_ptr<const WasmModule> module,
+                                WasmFeatures enabled_features,
+                                ValidateFunctionsStreamingJobData* data)
+      : module_(std::move(module)),
+        enabled_features_(enabled_features),
+        data_(data) {}
+
+  void Run(JobDelegate* delegate) override {
+    TRACE_EVENT0("v8.wasm", "wasm.ValidateFunctionsStreaming");
+    AccountingAllocator* allocator = GetWasmEngine()->allocator();
+    while (const ValidateFunctionsStreamingJobData::Unit* unit =
+               data_->GetUnit()) {
+      DecodeResult result =
+          ValidateSingleFunction(module_.get(), unit->func_index, unit->code,
+                                 allocator, enabled_features_);
+      if (result.failed()) {
+        data_->set_found_error();
+        return;
+      }
+      if (delegate->ShouldYield()) return;
+    }
+  }
+
+  size_t GetMaxConcurrency(size_t /* worker_count */) const override {
+    if (data_->found_error()) return 0;
+    return std::min(static_cast<size_t>(FLAG_wasm_num_compilation_tasks),
+                    data_->NumOutstandingUnits());
+  }
+
+ private:
+  const std::shared_ptr<const WasmModule> module_;
+  const WasmFeatures enabled_features_;
+  ValidateFunctionsStreamingJobData* const data_;
+};
+
 class AsyncStreamingProcessor final : public StreamingProcessor {
  public:
   explicit AsyncStreamingProcessor(AsyncCompileJob* job,
@@ -2112,6 +2343,10 @@ class AsyncStreamingProcessor final : public StreamingProcessor {
 
   void CommitCompilationUnits();
 
+  // Waits for the validation of lazily compiled functions on worker threads,
+  // and returns the error of the first invalid function, if any.
+  WasmError FinishValidateFunctionsJob();
+
   ModuleDecoder decoder_;
   AsyncCompileJob* job_;
   std::unique_ptr<CompilationUnitBuilder> compilation_unit_builder_;
@@ -2125,6 +2360,13 @@ class AsyncStreamingProcessor final : public StreamingProcessor {
   // code section itself. Used by the {NativeModuleCache} to detect potential
   // duplicate modules.
   size_t prefix_hash_;
+
+  // Lazily compiled functions are validated on worker threads while the rest
+  // of the module is still arriving. The function bodies stay owned by the
+  // streaming decoder, which outlives this processor.
+  std::unique_ptr<ValidateFunctionsStreamingJobData>
+      validate_functions_job_data_;
+  std::unique_ptr<JobHandle> validate_functions_job_handle_;
 };
 
 std::shared_ptr<StreamingDecoder> AsyncCompileJob::CreateStreamingDecoder() {
@@ -2173,6 +2415,9 @@ void AsyncCompileJob::CreateNativeModule(
       isolate_, enabled_features_, std::move(module), code_size_estimate);
   native_module_->SetWireBytes({std::move(bytes_copy_), wire_bytes_.length()});
   native_module_->compilation_state()->set_compilation_id(compilation_id_);
+  if (WasmDiskCache* disk_cache = GetWasmEngine()->disk_cache()) {
+    disk_cache->Observe(native_module_);
+  }
 }
 
 bool AsyncCompileJob::GetOrCreateNativeModule(
@@ -2362,8 +2607,9 @@ class AsyncCompileJob::CompilationStateCallback
           job_->DoSync<CompileFailed>();
         }
         break;
+      case CompilationEvent::kFinishedTopTierCompilation:
       case CompilationEvent::kFinishedRecompilation:
-        // This event can happen out of order, hence don't remember this in
+        // These events can happen out of order, hence don't remember them in
         // {last_event_}.
         return;
     }
@@ -2531,7 +2777,10 @@ class AsyncCompileJob::DecodeModule : public AsyncCompileJob::CompileStep {
         const WasmModule* module = result.value().get();
         DCHECK_EQ(module->origin, kWasmOrigin);
         const bool lazy_module = job->wasm_lazy_compilation_;
-        if (MayCompriseLazyFunctions(module, enabled_features, lazy_module)) {
+        if (MayCompriseLazyFunctions(module, enabled_features, lazy_module) &&
+            !ValidateFunctions(module, enabled_features, job->wire_bytes_,
+                               lazy_module, kOnlyLazyFunctions)) {
+          // Find the first invalid function.
           auto allocator = GetWasmEngine()->allocator();
           int start = module->num_imported_functions;
           int end = start + module->num_declared_functions;
@@ -2568,6 +2817,21 @@ class AsyncCompileJob::DecodeModule : public AsyncCompileJob::CompileStep {
       size_t code_size_estimate =
           wasm::WasmCodeManager::EstimateNativeModuleCodeSize(
               module.get(), include_liftoff, job->dynamic_tiering_);
+      // Read the persistent cache here, off the main thread. Modules that are
+      // cached in this process are found in {PrepareAndStartCompile} without
+      // touching the disk.
+      WasmEngine* engine = GetWasmEngine();
+      base::Vector<const uint8_t> wire_bytes = job->wire_bytes_.module_bytes();
+      if (engine->disk_cache() &&
+          !engine->IsNativeModuleCached(kWasmOrigin, wire_bytes)) {
+        std::unique_ptr<WasmDiskCache::CachedModule> cached_module =
+            engine->disk_cache()->Read(job->enabled_features_, wire_bytes);
+        if (cached_module) {
+          job->DoSync<DeserializeCachedModule>(
+              std::move(module), code_size_estimate, std::move(cached_module));
+          return;
+        }
+      }
       job->DoSync<PrepareAndStartCompile>(std::move(module), true,
                                           code_size_estimate);
     }
@@ -2595,6 +2859,42 @@ class AsyncCompileJob::DecodeFail : public CompileStep {
   }
 };
 
+//==========================================================================
+// Step 1c (sync): Deserialize the module read from the persistent cache.
+//==========================================================================
+class AsyncCompileJob::DeserializeCachedModule : public CompileStep {
+ public:
+  DeserializeCachedModule(
+      std::shared_ptr<const WasmModule> module, size_t code_size_estimate,
+      std::unique_ptr<WasmDiskCache::CachedModule> cached_module)
+      : module_(std::move(module)),
+        code_size_estimate_(code_size_estimate),
+        cached_module_(std::move(cached_module)) {}
+
+ private:
+  void RunInForeground(AsyncCompileJob* job) override {
+    TRACE_COMPILE("(1c) Deserializing cached module...\n");
+    MaybeHandle<WasmModuleObject> result = cached_module_->Deserialize(
+        job->isolate_, job->wire_bytes_.module_bytes());
+    if (result.is_null()) {
+      // Compile the module instead. This replaces {this} step.
+      job->DoSync<PrepareAndStartCompile>(std::move(module_), true,
+                                          code_size_estimate_);
+      return;
+    }
+    job->module_object_ =
+        job->isolate_->global_handles()->Create(*result.ToHandleChecked());
+    job->native_module_ = job->module_object_->shared_native_module();
+    job->wire_bytes_ = ModuleWireBytes(job->native_module_->wire_bytes());
+    // {job} is deleted in FinishCompile, therefore the {return}.
+    return job->FinishCompile(false);
+  }
+
+  std::shared_ptr<const WasmModule> module_;
+  const size_t code_size_estimate_;
+  std::unique_ptr<WasmDiskCache::CachedModule> cached_module_;
+};
+
 //==========================================================================
 // Step 2 (sync): Create heap-allocated data and start compile.
 //==========================================================================
@@ -2712,6 +3012,7 @@ AsyncStreamingProcessor::AsyncStreamingProcessor(
       allocator_(allocator) {}
 
 AsyncStreamingProcessor::~AsyncStreamingProcessor() {
+  if (validate_functions_job_handle_) validate_functions_job_handle_->Cancel();
   if (job_->native_module_ && job_->native_module_->wire_bytes().empty()) {
     // Clean up the temporary cache entry.
     GetWasmEngine()->StreamingCompilationFailed(prefix_hash_);
@@ -2831,6 +3132,13 @@ bool AsyncStreamingProcessor::ProcessCodeSectionHeader(
   decoder_.set_code_section(code_section_start,
                             static_cast<uint32_t>(code_section_length));
 
+  if (!FLAG_wasm_lazy_validation &&
+      MayCompriseLazyFunctions(decoder_.module(), job_->enabled_features_,
+                               job_->wasm_lazy_compilation_)) {
+    validate_functions_job_data_ =
+        std::make_unique<ValidateFunctionsStreamingJobData>(num_functions);
+  }
+
   if (!GetWasmEngine()->GetStreamingCompilationOwnership(prefix_hash_)) {
     // Known prefix, wait until the end of the stream and check the cache.
     prefix_cache_hit_ = true;
@@ -2885,12 +3193,30 @@ bool AsyncStreamingProcessor::ProcessFunctionBody(
   if (validate_lazily_compiled_function) {
     // The native module does not own the wire bytes until {SetWireBytes} is
     // called in {OnFinishedStream}. Validation must use {bytes} parameter.
-    DecodeResult result = ValidateSingleFunction(module, func_index, bytes,
-                                                 allocator_, enabled_features);
-
-    if (result.failed()) {
-      FinishAsyncCompileJobWithError(result.error());
-      return false;
+    if (FLAG_wasm_num_compilation_tasks == 0) {
+      DecodeResult result = ValidateSingleFunction(
+          module, func_index, bytes, allocator_, enabled_features);
+      if (result.failed()) {
+        FinishAsyncCompileJobWithError(result.error());
+        return false;
+      }
+    } else {
+      DCHECK_NOT_NULL(validate_functions_job_data_);
+      // Stop streaming as soon as the workers found an invalid function.
+      if (validate_functions_job_data_->found_error()) {
+        FinishAsyncCompileJobWithError(FinishValidateFunctionsJob());
+        return false;
+      }
+      validate_functions_job_data_->AddUnit(func_index, bytes);
+      if (validate_functions_job_handle_) {
+        validate_functions_job_handle_->NotifyConcurrencyIncrease();
+      } else {
+        validate_functions_job_handle_ = V8::GetCurrentPlatform()->PostJob(
+            TaskPriority::kUserVisible,
+            std::make_unique<ValidateFunctionsStreamingJob>(
+                decoder_.shared_module(), enabled_features,
+                validate_functions_job_data_.get()));
+      }
     }
   }
 
@@ -2913,6 +3239,22 @@ void AsyncStreamingProcessor::CommitCompilationUnits() {
   compilation_unit_builder_->Commit();
 }
 
+WasmError AsyncStreamingProcessor::FinishValidateFunctionsJob() {
+  if (!validate_functions_job_handle_) return {};
+  validate_functions_job_handle_->Join();
+  validate_functions_job_handle_.reset();
+  if (!validate_functions_job_data_->found_error()) return {};
+  // Validate again in order, such that the reported error does not depend on
+  // the scheduling of the workers.
+  for (const auto& unit : validate_functions_job_data_->units()) {
+    DecodeResult result =
+        ValidateSingleFunction(decoder_.module(), unit.func_index, unit.code,
+                               allocator_, job_->enabled_features_);
+    if (result.failed()) return std::move(result).error();
+  }
+  UNREACHABLE();
+}
+
 void AsyncStreamingProcessor::OnFinishedChunk() {
   TRACE_STREAMING("FinishChunk...\n");
   if (compilation_unit_builder_) CommitCompilationUnits();
@@ -2923,6 +3265,11 @@ void AsyncStreamingProcessor::OnFinishedStream(
     base::OwnedVector<uint8_t> bytes) {
   TRACE_STREAMING("Finish stream...\n");
   DCHECK_EQ(NativeModuleCache::PrefixHash(bytes.as_vector()), prefix_hash_);
+  WasmError validation_error = FinishValidateFunctionsJob();
+  if (validation_error.has_error()) {
+    FinishAsyncCompileJobWithError(validation_error);
+    return;
+  }
   ModuleResult result = decoder_.FinishDecoding(false);
   if (result.failed()) {
     FinishAsyncCompileJobWithError(result.error());
@@ -3085,6 +3432,7 @@ uint8_t CompilationStateImpl::SetupCompilationProgressForFunction(
 
   // Count functions to complete baseline and top tier compilation.
   if (required_for_baseline) outstanding_baseline_units_++;
+  if (required_for_top_tier) outstanding_top_tier_functions_++;
 
   // Initialize function's compilation progress.
   ExecutionTier required_baseline_tier = required_for_baseline
@@ -3109,6 +3457,7 @@ void CompilationStateImpl::InitializeCompilationProgress(
   base::MutexGuard guard(&callbacks_mutex_);
   DCHECK_EQ(0, outstanding_baseline_units_);
   DCHECK_EQ(0, outstanding_export_wrappers_);
+  DCHECK_EQ(0, outstanding_top_tier_functions_);
   compilation_progress_.reserve(module->num_declared_functions);
   int start = module->num_imported_functions;
   int end = start + module->num_declared_functions;
@@ -3122,6 +3471,7 @@ void CompilationStateImpl::InitializeCompilationProgress(
           ReachedTierField::encode(ExecutionTier::kNone);
       compilation_progress_.push_back(kLiftoffOnlyFunctionProgress);
       outstanding_baseline_units_++;
+      outstanding_top_tier_functions_++;
       continue;
     }
     uint8_t function_progress = SetupCompilationProgressForFunction(
@@ -3234,7 +3584,8 @@ void CompilationStateImpl::AddCompilationUnit(CompilationUnitBuilder* builder,
 
 void CompilationStateImpl::InitializeCompilationProgressAfterDeserialization(
     base::Vector<const int> lazy_functions,
-    base::Vector<const int> liftoff_functions) {
+    base::Vector<const int> liftoff_functions,
+    base::Vector<const int> lazily_deserialized_functions) {
   TRACE_EVENT2("v8.wasm", "wasm.CompilationAfterDeserialization",
                "num_lazy_functions", lazy_functions.size(),
                "num_liftoff_functions", liftoff_functions.size());
@@ -3245,7 +3596,8 @@ void CompilationStateImpl::InitializeCompilationProgressAfterDeserialization(
   auto enabled_features = native_module_->enabled_features();
   const bool lazy_module = IsLazyModule(module);
   base::Optional<CodeSpaceWriteScope> lazy_code_space_write_scope;
-  if (lazy_module || !lazy_functions.empty()) {
+  if (lazy_module || !lazy_functions.empty() ||
+      !lazily_deserialized_functions.empty()) {
     lazy_code_space_write_scope.emplace(native_module_);
   }
   {
@@ -3274,6 +3626,9 @@ void CompilationStateImpl::InitializeCompilationProgressAfterDeserialization(
                                               native_module_, enabled_features,
                                               func_index);
     }
+    for (auto func_index : lazily_deserialized_functions) {
+      native_module_->UseLazyStub(func_index);
+    }
     for (auto func_index : liftoff_functions) {
       if (lazy_module) {
         native_module_->UseLazyStub(func_index);
@@ -3524,6 +3879,13 @@ void CompilationStateImpl::OnFinishedUnits(
         DCHECK_GT(outstanding_baseline_units_, 0);
         outstanding_baseline_units_--;
       }
+      ExecutionTier required_top_tier =
+          RequiredTopTierField::decode(function_progress);
+      if (reached_tier < required_top_tier &&
+          required_top_tier <= code->tier()) {
+        DCHECK_GT(outstanding_top_tier_functions_, 0);
+        outstanding_top_tier_functions_--;
+      }
       if (code->tier() == ExecutionTier::kTurbofan) {
         bytes_since_last_chunk_ += code->instructions().size();
       }
@@ -3575,6 +3937,9 @@ void CompilationStateImpl::TriggerCallbacks(
     triggered_events.Add(CompilationEvent::kFinishedExportWrappers);
     if (outstanding_baseline_units_ == 0) {
       triggered_events.Add(CompilationEvent::kFinishedBaselineCompilation);
+      if (!dynamic_tiering_ && outstanding_top_tier_functions_ == 0) {
+        triggered_events.Add(CompilationEvent::kFinishedTopTierCompilation);
+      }
     }
   }
 
@@ -3609,6 +3974,8 @@ void CompilationStateImpl::TriggerCallbacks(
                        "wasm.ExportWrappersFinished"),
         std::make_pair(CompilationEvent::kFinishedBaselineCompilation,
                        "wasm.BaselineFinished"),
+        std::make_pair(CompilationEvent::kFinishedTopTierCompilation,
+                       "wasm.TopTierFinished"),
         std::make_pair(CompilationEvent::kFinishedCompilationChunk,
                        "wasm.CompilationChunkFinished"),
         std::make_pair(CompilationEvent::kFinishedRecompilation,
@@ -3905,8 +4272,9 @@ WasmCode* CompileImportWrapper(
   // Keep the {WasmCode} alive until we explicitly call {IncRef}.
   WasmCodeRefScope code_ref_scope;
   CompilationEnv env = native_module->CreateCompilationEnv();
-  WasmCompilationResult result = compiler::CompileWasmImportCallWrapper(
-      &env, kind, sig, source_positions, expected_arity, suspend);
+  WasmCompilationResult result =
+      GetWasmEngine()->shared_import_wrapper_cache()->GetOrCompile(
+          &env, kind, sig, source_positions, expected_arity, suspend);
   WasmCode* published_code;
   {
     CodeSpaceWriteScope code_space_write_scope(native_module);
@@ -155,11 +155,12 @@ class AsyncCompileJob {
   class CompilationStateCallback;
 
   // States of the AsyncCompileJob.
-  class DecodeModule;            // Step 1  (async)
-  class DecodeFail;              // Step 1b (sync)
-  class PrepareAndStartCompile;  // Step 2  (sync)
-  class CompileFailed;           // Step 3a (sync)
-  class CompileFinished;         // Step 3b (sync)
+  class DecodeModule;             // Step 1  (async)
+  class DecodeFail;               // Step 1b (sync)
+  class DeserializeCachedModule;  // Step 1c (sync)
+  class PrepareAndStartCompile;   // Step 2  (sync)
+  class CompileFailed;            // Step 3a (sync)
+  class CompileFinished;          // Step 3b (sync)
 
   friend class AsyncStreamingProcessor;
 
@@ -213,9 +213,12 @@ class V8_EXPORT_PRIVATE AsyncStreamingDecoder : public StreamingDecoder {
 
   uint32_t module_offset() const { return module_offset_; }
 
+  // The processor may still validate function bodies on background threads
+  // until it is destroyed, so it has to be destroyed before the
+  // {section_buffers_} holding those bodies.
+  std::vector<std::shared_ptr<SectionBuffer>> section_buffers_;
   std::unique_ptr<StreamingProcessor> processor_;
   std::unique_ptr<DecodingState> state_;
-  std::vector<std::shared_ptr<SectionBuffer>> section_buffers_;
   bool code_section_processed_ = false;
   uint32_t module_offset_ = 0;
   size_t total_size_ = 0;
@@ -40,6 +40,7 @@
 #include "src/wasm/wasm-module.h"
 #include "src/wasm/wasm-objects-inl.h"
 #include "src/wasm/wasm-objects.h"
+#include "src/wasm/wasm-serialization.h"
 
 #if defined(V8_OS_WIN64)
 #include "src/base/platform/wrappers.h"
@@ -870,6 +871,33 @@ void WasmCodeAllocator::FreeCode(base::Vector<WasmCode* const> codes) {
       code_manager->Decommit(split_range);
     }
   }
+
+  // Otherwise, freed code space is never used again, and long-running
+  // processes which tier up and down repeatedly need more and more code
+  // spaces. The decommitted pages can be reused like fresh code space: they
+  // are page-aligned, so the first page of any allocation in there is either
+  // committed by an earlier allocation or starts at a page boundary, as
+  // {AllocateForCodeInRegion} expects. Partially freed pages stay in
+  // {freed_code_space_}. With --perf-prof, pages are never decommitted and
+  // code addresses must stay unique.
+  if (!FLAG_wasm_reuse_freed_code_space || FLAG_perf_prof) return;
+  size_t reclaimed_size = 0;
+  for (auto region : regions_to_decommit.regions()) {
+    base::AddressRegion reclaimed =
+        freed_code_space_.AllocateInRegion(region.size(), region);
+    DCHECK_EQ(region, reclaimed);
+    // The region is not allocated any more, such that allocating it again
+    // can merge it back into {allocated_code_space_}.
+    base::AddressRegion deallocated =
+        allocated_code_space_.AllocateInRegion(region.size(), region);
+    DCHECK_EQ(region, deallocated);
+    USE(deallocated);
+    free_code_space_.Merge(reclaimed);
+    reclaimed_size += reclaimed.size();
+  }
+  reclaimed_code_size_.fetch_add(reclaimed_size);
+  TRACE_HEAP("Reclaimed %zu bytes of freed code space for %p\n",
+             reclaimed_size, this);
 }
 
 size_t WasmCodeAllocator::GetNumCodeSpaces() const {
@@ -2317,6 +2345,20 @@ void NativeModule::SampleCodeSize(
         int freed_percent = static_cast<int>(100 * freed_size / generated_size);
         counters->wasm_module_freed_code_size_percent()->AddSample(
             freed_percent);
+        // Freed code which is not available for new code yet, relative to
+        // all generated code.
+        size_t reclaimed_size = code_allocator_.reclaimed_code_size();
+        DCHECK_LE(reclaimed_size, freed_size);
+        int fragmented_percent = static_cast<int>(
+            100 * (freed_size - reclaimed_size) / generated_size);
+        counters->wasm_module_fragmented_code_size_percent()->AddSample(
+            fragmented_percent);
+        if (freed_size > 0) {
+          int reclaimed_percent =
+              static_cast<int>(100 * reclaimed_size / freed_size);
+          counters->wasm_module_reclaimed_code_size_percent()->AddSample(
+              reclaimed_percent);
+        }
       }
       break;
     }
@@ -2514,6 +2556,12 @@ NamesProvider* NativeModule::GetNamesProvider() {
   return names_provider_.get();
 }
 
+void NativeModule::set_lazily_deserialized_code(
+    std::unique_ptr<LazilyDeserializedCode> lazily_deserialized_code) {
+  DCHECK_NULL(lazily_deserialized_code_);
+  lazily_deserialized_code_ = std::move(lazily_deserialized_code);
+}
+
 void WasmCodeManager::FreeNativeModule(
     base::Vector<VirtualMemory> owned_code_space, size_t committed_size) {
   base::MutexGuard lock(&native_modules_mutex_);
@@ -42,6 +42,7 @@ class Isolate;
 namespace wasm {
 
 class DebugInfo;
+class LazilyDeserializedCode;
 class NamesProvider;
 class NativeModule;
 struct WasmCompilationResult;
@@ -538,6 +539,11 @@ class WasmCodeAllocator {
   size_t freed_code_size() const {
     return freed_code_size_.load(std::memory_order_acquire);
   }
+  // The part of the freed code size which was made available for new code
+  // again. The rest is fragmented within pages that still hold live code.
+  size_t reclaimed_code_size() const {
+    return reclaimed_code_size_.load(std::memory_order_acquire);
+  }
 
   // Allocate code space. Returns a valid buffer or fails with OOM (crash).
   // Hold the {NativeModule}'s {allocation_mutex_} when calling this method.
@@ -591,7 +597,9 @@ class WasmCodeAllocator {
   // Code space that was allocated for code (subset of {owned_code_space_}).
   DisjointAllocationPool allocated_code_space_;
   // Code space that was allocated before but is dead now. Full pages within
-  // this region are discarded. It's still a subset of {owned_code_space_}.
+  // this region are discarded and, with --wasm-reuse-freed-code-space, moved
+  // from here and from {allocated_code_space_} back to {free_code_space_}.
+  // It's still a subset of {owned_code_space_}.
   DisjointAllocationPool freed_code_space_;
   std::vector<VirtualMemory> owned_code_space_;
 
@@ -610,6 +618,7 @@ class WasmCodeAllocator {
   std::atomic<size_t> committed_code_space_{0};
   std::atomic<size_t> generated_code_size_{0};
   std::atomic<size_t> freed_code_size_{0};
+  std::atomic<size_t> reclaimed_code_size_{0};
 
   std::shared_ptr<Counters> async_counters_;
 };
@@ -773,6 +782,9 @@ class V8_EXPORT_PRIVATE NativeModule final {
   size_t generated_code_size() const {
     return code_allocator_.generated_code_size();
   }
+  size_t reclaimed_code_size() const {
+    return code_allocator_.reclaimed_code_size();
+  }
   size_t liftoff_bailout_count() const { return liftoff_bailout_count_.load(); }
   size_t liftoff_code_size() const { return liftoff_code_size_.load(); }
   size_t turbofan_code_size() const { return turbofan_code_size_.load(); }
@@ -851,6 +863,14 @@ class V8_EXPORT_PRIVATE NativeModule final {
   // Get or create the NamesProvider. Requires {HasWireBytes()}.
   NamesProvider* GetNamesProvider();
 
+  // The serialized code of functions that get deserialized on their first
+  // call, or nullptr. This is set during deserialization, before the module
+  // is shared, and does not change afterwards.
+  LazilyDeserializedCode* lazily_deserialized_code() const {
+    return lazily_deserialized_code_.get();
+  }
+  void set_lazily_deserialized_code(std::unique_ptr<LazilyDeserializedCode>);
+
   uint32_t* tiering_budget_array() { return tiering_budgets_.get(); }
 
   Counters* counters() const { return code_allocator_.counters(); }
@@ -996,6 +1016,8 @@ class V8_EXPORT_PRIVATE NativeModule final {
 
   std::unique_ptr<NamesProvider> names_provider_;
 
+  std::unique_ptr<LazilyDeserializedCode> lazily_deserialized_code_;
+
   TieringState tiering_state_ = kTieredUp;
 
   // Cache both baseline and top-tier code if we are debugging, to speed up
@@ -0,0 +1,440 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/wasm/wasm-disk-cache.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <sstream>
+
+#include "include/v8-platform.h"
+#include "src/base/functional.h"
+#include "src/base/platform/platform.h"
+#include "src/base/platform/wrappers.h"
+#include "src/codegen/cpu-features.h"
+#include "src/flags/flags.h"
+#include "src/init/v8.h"
+#include "src/tasks/operations-barrier.h"
+#include "src/tracing/trace-event.h"
+#include "src/utils/utils.h"
+#include "src/utils/version.h"
+#include "src/wasm/compilation-environment.h"
+#include "src/wasm/wasm-code-manager.h"
+#include "src/wasm/wasm-engine.h"
+#include "src/wasm/wasm-serialization.h"
+
+namespace v8 {
+namespace internal {
+namespace wasm {
+
+namespace {
+
+// Every entry starts with this magic number, followed by the enabled wasm
+// features, the size of the wire bytes, the wire bytes, and the serialized
+// module.
+constexpr uint32_t kEntryMagicNumber = 0x32434457;  // "WDC2"
+constexpr size_t kEntryHeaderSize = 3 * sizeof(uint32_t);
+
+uint32_t FeatureBits(const WasmFeatures& enabled_features) {
+  return static_cast<uint32_t>(enabled_features.ToIntegral());
+}
+
+constexpr char kEntrySuffix[] = ".wasm-cache";
+constexpr char kIndexFileName[] = "wasm-cache-index";
+
+// Checks that {contents} is an entry for the given {wire_bytes} compiled with
+// {enabled_features}.
+bool IsValidEntry(base::Vector<const uint8_t> contents,
+                  const WasmFeatures& enabled_features,
+                  base::Vector<const uint8_t> wire_bytes) {
+  if (contents.size() < kEntryHeaderSize + wire_bytes.size()) return false;
+  uint32_t header[3];
+  static_assert(sizeof(header) == kEntryHeaderSize);
+  memcpy(header, contents.begin(), sizeof(header));
+  return header[0] == kEntryMagicNumber &&
+         header[1] == FeatureBits(enabled_features) &&
+         header[2] == wire_bytes.size() &&
+         memcmp(contents.begin() + kEntryHeaderSize, wire_bytes.begin(),
+                wire_bytes.size()) == 0;
+}
+
+// Stores of the same module are serialized, such that an older version of
+// the module never overwrites a newer one.
+struct StoreState {
+  base::Mutex mutex;
+  // Whether a {StoreTask} is posted or running.
+  bool store_scheduled = false;
+  // Whether the module got new code while a store was in progress.
+  bool store_again = false;
+};
+
+class StoreTask : public v8::Task {
+ public:
+  StoreTask(std::weak_ptr<WasmDiskCache> cache,
+            std::weak_ptr<NativeModule> native_module,
+            std::shared_ptr<StoreState> state)
+      : cache_(std::move(cache)),
+        native_module_(std::move(native_module)),
+        state_(std::move(state)),
+        engine_barrier_(GetWasmEngine()->GetBarrierForBackgroundCompile()) {}
+
+  // Posts a {StoreTask}, unless one is already scheduled. That one then
+  // stores the module again once it is done.
+  static void Schedule(std::weak_ptr<WasmDiskCache> cache,
+                       std::weak_ptr<NativeModule> native_module,
+                       std::shared_ptr<StoreState> state) {
+    {
+      base::MutexGuard guard(&state->mutex);
+      if (state->store_scheduled) {
+        state->store_again = true;
+        return;
+      }
+      state->store_scheduled = true;
+    }
+    V8::GetCurrentPlatform()->CallOnWorkerThread(std::make_unique<StoreTask>(
+        std::move(cache), std::move(native_module), std::move(state)));
+  }
+
+  void Run() override {
+    // Do not delay the shutdown of the engine.
+    auto engine_scope = engine_barrier_->TryLock();
+    if (!engine_scope) return;
+    std::shared_ptr<WasmDiskCache> cache = cache_.lock();
+    std::shared_ptr<NativeModule> native_module = native_module_.lock();
+    if (!cache || !native_module) return;
+    while (true) {
+      cache->Store(native_module.get());
+      base::MutexGuard guard(&state_->mutex);
+      if (!state_->store_again) {
+        state_->store_scheduled = false;
+        return;
+      }
+      state_->store_again = false;
+    }
+  }
+
+ private:
+  const std::weak_ptr<WasmDiskCache> cache_;
+  const std::weak_ptr<NativeModule> native_module_;
+  const std::shared_ptr<StoreState> state_;
+  const std::shared_ptr<OperationsBarrier> engine_barrier_;
+};
+
+// Stores the module with the functions that got tiered up a while after
+// baseline compilation, for modules which are too small to finish a chunk of
+// top tier code.
+class DelayedStoreTask : public v8::Task {
+ public:
+  DelayedStoreTask(std::weak_ptr<WasmDiskCache> cache,
+                   std::weak_ptr<NativeModule> native_module,
+                   std::shared_ptr<StoreState> state)
+      : cache_(std::move(cache)),
+        native_module_(std::move(native_module)),
+        state_(std::move(state)),
+        engine_barrier_(GetWasmEngine()->GetBarrierForBackgroundCompile()) {}
+
+  void Run() override {
+    auto engine_scope = engine_barrier_->TryLock();
+    if (!engine_scope) return;
+    StoreTask::Schedule(cache_, native_module_, state_);
+  }
+
+ private:
+  const std::weak_ptr<WasmDiskCache> cache_;
+  const std::weak_ptr<NativeModule> native_module_;
+  const std::shared_ptr<StoreState> state_;
+  const std::shared_ptr<OperationsBarrier> engine_barrier_;
+};
+
+class StoreToDiskCacheCallback : public CompilationEventCallback {
+ public:
+  StoreToDiskCacheCallback(std::weak_ptr<WasmDiskCache> cache,
+                           std::weak_ptr<NativeModule> native_module)
+      : cache_(std::move(cache)), native_module_(std::move(native_module)) {}
+
+  void call(CompilationEvent event) override {
+    switch (event) {
+      case CompilationEvent::kFinishedBaselineCompilation:
+        // Store the module right away, so that modules without tier-up are
+        // cached too. With dynamic tiering, the baseline code is not
+        // serialized, so store the module again after a delay, with the
+        // functions that were hot until then.
+        StoreTask::Schedule(cache_, native_module_, state_);
+        if (FLAG_wasm_dynamic_tiering) {
+          V8::GetCurrentPlatform()->CallDelayedOnWorkerThread(
+              std::make_unique<DelayedStoreTask>(cache_, native_module_,
+                                                 state_),
+              FLAG_wasm_disk_cache_store_delay);
+        }
+        return;
+      case CompilationEvent::kFinishedTopTierCompilation:
+      case CompilationEvent::kFinishedCompilationChunk:
+        // Store the module again whenever top tier code was added, i.e. after
+        // eager tier-up or, with dynamic tiering, after each chunk of
+        // --wasm-caching-threshold bytes of tiered-up code.
+        StoreTask::Schedule(cache_, native_module_, state_);
+        return;
+      default:
+        return;
+    }
+  }
+
+  ReleaseAfterFinalEvent release_after_final_event() override {
+    return kKeepAfterFinalEvent;
+  }
+
+ private:
+  const std::weak_ptr<WasmDiskCache> cache_;
+  const std::weak_ptr<NativeModule> native_module_;
+  const std::shared_ptr<StoreState> state_ = std::make_shared<StoreState>();
+};
+
+}  // namespace
+
+WasmDiskCache::WasmDiskCache(std::string directory, size_t max_size)
+    : directory_(std::move(directory)), max_size_(max_size) {
+  ReadIndex();
+}
+
+WasmDiskCache::~WasmDiskCache() { FlushIndex(); }
+
+// static
+std::string WasmDiskCache::KeyFor(const WasmFeatures& enabled_features,
+                                  base::Vector<const uint8_t> wire_bytes) {
+  size_t hash = base::hash_combine(
+      NativeModuleCache::WireBytesHash(wire_bytes), wire_bytes.size(),
+      FeatureBits(enabled_features), FlagList::Hash(),
+      CpuFeatures::SupportedFeatures(), Version::Hash());
+  char buffer[2 * sizeof(uint64_t) + 1];
+  base::OS::SNPrintF(buffer, static_cast<int>(sizeof(buffer)), "%016" PRIx64,
+                     static_cast<uint64_t>(hash));
+  return buffer;
+}
+
+MaybeHandle<WasmModuleObject> WasmDiskCache::CachedModule::Deserialize(
+    Isolate* isolate, base::Vector<const uint8_t> wire_bytes) {
+  TRACE_EVENT1("v8.wasm", "wasm.DiskCacheDeserialize", "wire_bytes",
+               wire_bytes.size());
+  constexpr base::Vector<const char> kNoSourceUrl;
+  if (file_) {
+    return DeserializeNativeModule(isolate, std::move(file_),
+                                   kEntryHeaderSize + wire_bytes.size(),
+                                   wire_bytes, kNoSourceUrl);
+  }
+  return DeserializeNativeModule(isolate, base::VectorOf(serialized_module_),
+                                 wire_bytes, kNoSourceUrl);
+}
+
+std::unique_ptr<WasmDiskCache::CachedModule> WasmDiskCache::Read(
+    const WasmFeatures& enabled_features,
+    base::Vector<const uint8_t> wire_bytes) {
+  TRACE_EVENT1("v8.wasm", "wasm.DiskCacheRead", "wire_bytes",
+               wire_bytes.size());
+  std::string key = KeyFor(enabled_features, wire_bytes);
+  if (FLAG_wasm_lazy_deserialization) {
+    // Map the entry instead of reading it, such that only the code of
+    // functions which actually get called is paged in.
+    std::unique_ptr<base::OS::MemoryMappedFile> file =
+        Map(key, enabled_features, wire_bytes);
+    if (!file) return {};
+    return std::make_unique<CachedModule>(std::move(file));
+  }
+  std::vector<uint8_t> serialized_module;
+  if (!Get(key, enabled_features, wire_bytes, &serialized_module)) return {};
+  return std::make_unique<CachedModule>(std::move(serialized_module));
+}
+
+MaybeHandle<WasmModuleObject> WasmDiskCache::Lookup(
+    Isolate* isolate, const WasmFeatures& enabled_features,
+    base::Vector<const uint8_t> wire_bytes) {
+  std::unique_ptr<CachedModule> cached_module =
+      Read(enabled_features, wire_bytes);
+  if (!cached_module) return {};
+  return cached_module->Deserialize(isolate, wire_bytes);
+}
+
+void WasmDiskCache::Observe(
+    const std::shared_ptr<NativeModule>& native_module) {
+  native_module->compilation_state()->AddCallback(
+      std::make_unique<StoreToDiskCacheCallback>(weak_from_this(),
+                                                 native_module));
+}
+
+void WasmDiskCache::Store(NativeModule* native_module) {
+  TRACE_EVENT0("v8.wasm", "wasm.DiskCacheStore");
+  WasmSerializer serializer(native_module);
+  std::vector<uint8_t> serialized_module(
+      serializer.GetSerializedNativeModuleSize());
+  if (!serializer.SerializeNativeModule(base::VectorOf(serialized_module))) {
+    return;
+  }
+  base::Vector<const uint8_t> wire_bytes = native_module->wire_bytes();
+  const WasmFeatures& enabled_features = native_module->enabled_features();
+  Put(KeyFor(enabled_features, wire_bytes), enabled_features, wire_bytes,
+      base::VectorOf(serialized_module));
+}
+
+bool WasmDiskCache::Put(const std::string& key,
+                        const WasmFeatures& enabled_features,
+                        base::Vector<const uint8_t> wire_bytes,
+                        base::Vector<const uint8_t> serialized_module) {
+  size_t size = kEntryHeaderSize + wire_bytes.size() + serialized_module.size();
+  if (size > max_size_ || wire_bytes.size() > kMaxUInt32) return false;
+
+  // Write to a temporary file first and rename it afterwards, so that readers
+  // never observe a partially written entry.
+  std::ostringstream temp_path;
+  temp_path << PathFor(key) << ".tmp." << base::OS::GetCurrentProcessId() << "."
+            << base::OS::GetCurrentThreadId();
+  FILE* file = base::OS::FOpen(temp_path.str().c_str(), "wb");
+  if (file == nullptr) return false;
+  uint32_t header[] = {kEntryMagicNumber, FeatureBits(enabled_features),
+                       static_cast<uint32_t>(wire_bytes.size())};
+  bool ok =
+      fwrite(header, 1, sizeof(header), file) == sizeof(header) &&
+      fwrite(wire_bytes.begin(), 1, wire_bytes.size(), file) ==
+          wire_bytes.size() &&
+      fwrite(serialized_module.begin(), 1, serialized_module.size(), file) ==
+          serialized_module.size();
+  ok = base::Fclose(file) == 0 && ok;
+  std::string path = PathFor(key);
+  // {rename} does not replace existing files on all platforms.
+  base::OS::Remove(path.c_str());
+  if (!ok || std::rename(temp_path.str().c_str(), path.c_str()) != 0) {
+    base::OS::Remove(temp_path.str().c_str());
+    return false;
+  }
+
+  base::MutexGuard guard(&mutex_);
+  TouchLocked(key, size);
+  EvictLocked();
+  WriteIndexLocked();
+  return true;
+}
+
+bool WasmDiskCache::Get(const std::string& key,
+                        const WasmFeatures& enabled_features,
+                        base::Vector<const uint8_t> wire_bytes,
+                        std::vector<uint8_t>* serialized_module) {
+  bool exists = false;
+  std::string contents = ReadFile(PathFor(key).c_str(), &exists, false);
+  if (!exists) return false;
+  base::Vector<const uint8_t> entry =
+      base::Vector<const uint8_t>::cast(base::VectorOf(contents));
+  if (!RecordLookup(key, entry, enabled_features, wire_bytes)) return false;
+  serialized_module->assign(
+      entry.begin() + kEntryHeaderSize + wire_bytes.size(), entry.end());
+  return true;
+}
+
+std::unique_ptr<base::OS::MemoryMappedFile> WasmDiskCache::Map(
+    const std::string& key, const WasmFeatures& enabled_features,
+    base::Vector<const uint8_t> wire_bytes) {
+  using FileMode = base::OS::MemoryMappedFile::FileMode;
+  std::unique_ptr<base::OS::MemoryMappedFile> file(
+      base::OS::MemoryMappedFile::open(PathFor(key).c_str(),
+                                       FileMode::kReadOnly));
+  if (!file) return {};
+  base::Vector<const uint8_t> entry{
+      static_cast<const uint8_t*>(file->memory()), file->size()};
+  if (!RecordLookup(key, entry, enabled_features, wire_bytes)) return {};
+  return file;
+}
+
+bool WasmDiskCache::RecordLookup(const std::string& key,
+                                 base::Vector<const uint8_t> entry,
+                                 const WasmFeatures& enabled_features,
+                                 base::Vector<const uint8_t> wire_bytes) {
+  bool valid = IsValidEntry(entry, enabled_features, wire_bytes);
+  base::MutexGuard guard(&mutex_);
+  if (valid) {
+    TouchLocked(key, entry.size());
+  } else {
+    // A corrupted entry, or a hash collision with a different module. Make
+    // room for the module that is about to be compiled.
+    base::OS::Remove(PathFor(key).c_str());
+    RemoveLocked(key);
+  }
+  // Rewriting the index on every lookup would make each cache hit pay for a
+  // file write. The LRU order only needs to survive the process, so defer it.
+  index_dirty_ = true;
+  return valid;
+}
+
+void WasmDiskCache::FlushIndex() {
+  base::MutexGuard guard(&mutex_);
+  if (index_dirty_) WriteIndexLocked();
+}
+
+size_t WasmDiskCache::size() const {
+  base::MutexGuard guard(&mutex_);
+  return total_size_;
+}
+
+size_t WasmDiskCache::entry_count() const {
+  base::MutexGuard guard(&mutex_);
+  return entries_.size();
+}
+
+std::string WasmDiskCache::PathFor(const std::string& key) const {
+  return directory_ + "/" + key + kEntrySuffix;
+}
+
+std::string WasmDiskCache::IndexPath() const {
+  return directory_ + "/" + kIndexFileName;
+}
+
+void WasmDiskCache::TouchLocked(const std::string& key, size_t size) {
+  RemoveLocked(key);
+  entries_.push_back({key, size});
+  total_size_ += size;
+}
+
+void WasmDiskCache::RemoveLocked(const std::string& key) {
+  auto it = std::find_if(
+      entries_.begin(), entries_.end(),
+      [&](const IndexEntry& entry) { return entry.key == key; });
+  if (it == entries_.end()) return;
+  total_size_ -= it->size;
+  entries_.erase(it);
+}
+
+void WasmDiskCache::EvictLocked() {
+  size_t evicted = 0;
+  while (total_size_ > max_size_ && evicted < entries_.size()) {
+    const IndexEntry& entry = entries_[evicted++];
+    base::OS::Remove(PathFor(entry.key).c_str());
+    total_size_ -= entry.size;
+  }
+  if (evicted == 0) return;
+  entries_.erase(entries_.begin(), entries_.begin() + evicted);
+  index_dirty_ = true;
+}
+
+void WasmDiskCache::ReadIndex() {
+  bool exists = false;
+  std::istringstream index(ReadFile(IndexPath().c_str(), &exists, false));
+  if (!exists) return;
+  base::MutexGuard guard(&mutex_);
+  std::string key;
+  size_t size;
+  while (index >> key >> size) TouchLocked(key, size);
+  EvictLocked();
+}
+
+void WasmDiskCache::WriteIndexLocked() {
+  std::ostringstream index;
+  for (const IndexEntry& entry : entries_) {
+    index << entry.key << " " << entry.size << "\n";
+  }
+  std::string contents = index.str();
+  WriteChars(IndexPath().c_str(), contents.data(),
+             static_cast<int>(contents.size()), false);
+  index_dirty_ = false;
+}
+
+}  // namespace wasm
+}  // namespace internal
+}  // namespace v8
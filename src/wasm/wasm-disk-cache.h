@@ -0,0 +1,165 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#if !V8_ENABLE_WEBASSEMBLY
+#error This header should only be included if WebAssembly is enabled.
+#endif  // !V8_ENABLE_WEBASSEMBLY
+
+#ifndef V8_WASM_WASM_DISK_CACHE_H_
+#define V8_WASM_WASM_DISK_CACHE_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/base/platform/mutex.h"
+#include "src/base/platform/platform.h"
+#include "src/base/vector.h"
+#include "src/handles/maybe-handles.h"
+#include "src/wasm/wasm-features.h"
+
+namespace v8 {
+namespace internal {
+
+class Isolate;
+class WasmModuleObject;
+
+namespace wasm {
+
+class NativeModule;
+
+// A persistent cache of serialized native modules, stored as one file per
+// module in a directory chosen by the embedder. This complements the
+// in-process {NativeModuleCache}: Modules compiled in an earlier process are
+// deserialized instead of being compiled again.
+//
+// Entries are keyed by a hash of the wire bytes, the enabled wasm features,
+// the flag hash, the supported CPU features and the V8 version. Each entry
+// also stores the enabled features and the full wire bytes, so hash collisions
+// are detected on lookup. A module is written in the background once its
+// baseline code is complete, and written again when top tier code is added
+// and, with dynamic tiering, after --wasm-disk-cache-store-delay.
+// The least recently used entries are evicted once the total size exceeds
+// the budget. The LRU order is kept in an index file in the same directory,
+// which is rewritten when entries are added and when the cache is destroyed.
+// Concurrent processes sharing a directory work, but may lose each other's
+// index updates; stale entries are then simply recompiled.
+class V8_EXPORT_PRIVATE WasmDiskCache
+    : public std::enable_shared_from_this<WasmDiskCache> {
+ public:
+  // The {directory} must exist. {max_size} is the size budget in bytes.
+  WasmDiskCache(std::string directory, size_t max_size);
+  WasmDiskCache(const WasmDiskCache&) = delete;
+  WasmDiskCache& operator=(const WasmDiskCache&) = delete;
+  ~WasmDiskCache();
+
+  // The contents of a valid entry, read by {Read}.
+  class CachedModule {
+   public:
+    explicit CachedModule(std::unique_ptr<base::OS::MemoryMappedFile> file)
+        : file_(std::move(file)) {}
+    explicit CachedModule(std::vector<uint8_t> serialized_module)
+        : serialized_module_(std::move(serialized_module)) {}
+
+    // Deserializes the module, or uses the {NativeModule} with the same
+    // {wire_bytes} if another compilation put one into the in-process cache
+    // in the meantime. Returns an empty handle if deserialization failed.
+    // Can only be called once.
+    MaybeHandle<WasmModuleObject> Deserialize(
+        Isolate* isolate, base::Vector<const uint8_t> wire_bytes);
+
+   private:
+    // Set for --wasm-lazy-deserialization, such that only the code of
+    // functions which actually get called is paged in.
+    std::unique_ptr<base::OS::MemoryMappedFile> file_;
+    std::vector<uint8_t> serialized_module_;
+  };
+
+  static std::string KeyFor(const WasmFeatures& enabled_features,
+                            base::Vector<const uint8_t> wire_bytes);
+
+  // Reads the entry for {wire_bytes} compiled with {enabled_features}. This
+  // does not touch the heap, so that the file access can happen on a
+  // background thread. Returns nullptr if the cache has no usable entry.
+  std::unique_ptr<CachedModule> Read(const WasmFeatures& enabled_features,
+                                     base::Vector<const uint8_t> wire_bytes);
+
+  // Reads and deserializes the module with the given {wire_bytes}. Returns an
+  // empty handle if the cache has no usable entry.
+  MaybeHandle<WasmModuleObject> Lookup(Isolate* isolate,
+                                       const WasmFeatures& enabled_features,
+                                       base::Vector<const uint8_t> wire_bytes);
+
+  // Stores {native_module} in the background once its baseline code is
+  // complete, and again after eager tier-up or, with dynamic tiering, after
+  // each chunk of tiered-up code and after --wasm-disk-cache-store-delay.
+  void Observe(const std::shared_ptr<NativeModule>& native_module);
+
+  // Serializes {native_module} and stores it in the cache. Can be called from
+  // any thread.
+  void Store(NativeModule* native_module);
+
+  // Low-level access to the entries, exposed for testing.
+  bool Put(const std::string& key, const WasmFeatures& enabled_features,
+           base::Vector<const uint8_t> wire_bytes,
+           base::Vector<const uint8_t> serialized_module);
+  bool Get(const std::string& key, const WasmFeatures& enabled_features,
+           base::Vector<const uint8_t> wire_bytes,
+           std::vector<uint8_t>* serialized_module);
+
+  // Writes the LRU order of lookups since the last write to the index file.
+  void FlushIndex();
+
+  size_t size() const;
+  size_t entry_count() const;
+
+ private:
+  struct IndexEntry {
+    std::string key;
+    size_t size;
+  };
+
+  std::string PathFor(const std::string& key) const;
+  std::string IndexPath() const;
+
+  // Maps the entry for {key} into memory. Returns nullptr if there is no valid
+  // entry for {wire_bytes}.
+  std::unique_ptr<base::OS::MemoryMappedFile> Map(
+      const std::string& key, const WasmFeatures& enabled_features,
+      base::Vector<const uint8_t> wire_bytes);
+  // Updates the in-memory index after a lookup of {key} found {entry}.
+  // Invalid entries are removed. Returns whether {entry} is valid. The index
+  // file is only written by {Put} and {FlushIndex}.
+  bool RecordLookup(const std::string& key, base::Vector<const uint8_t> entry,
+                    const WasmFeatures& enabled_features,
+                    base::Vector<const uint8_t> wire_bytes);
+
+  // Moves {key} to the most recently used position. Hold {mutex_}.
+  void TouchLocked(const std::string& key, size_t size);
+  // Removes {key} from the index. Hold {mutex_}.
+  void RemoveLocked(const std::string& key);
+  // Removes the least recently used entries until the total size fits the
+  // budget. Hold {mutex_}.
+  void EvictLocked();
+
+  void ReadIndex();
+  void WriteIndexLocked();
+
+  const std::string directory_;
+  const size_t max_size_;
+
+  mutable base::Mutex mutex_;
+  // Protected by {mutex_}: The entries in LRU order, least recently used
+  // first, their total size in bytes, and whether the index file is out of
+  // date.
+  std::vector<IndexEntry> entries_;
+  size_t total_size_ = 0;
+  bool index_dirty_ = false;
+};
+
+}  // namespace wasm
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_WASM_WASM_DISK_CACHE_H_
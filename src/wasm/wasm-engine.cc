@@ -27,8 +27,11 @@
 #include "src/wasm/module-instantiate.h"
 #include "src/wasm/streaming-decoder.h"
 #include "src/wasm/wasm-debug.h"
+#include "src/wasm/wasm-disk-cache.h"
+#include "src/wasm/wasm-import-wrapper-cache.h"
 #include "src/wasm/wasm-limits.h"
 #include "src/wasm/wasm-objects-inl.h"
+#include "src/wasm/wasm-tiering-feedback.h"
 
 #ifdef V8_ENABLE_WASM_GDB_REMOTE_DEBUGGING
 #include "src/base/platform/wrappers.h"
@@ -217,6 +220,15 @@ std::shared_ptr<NativeModule> NativeModuleCache::MaybeGetNativeModule(
   }
 }
 
+bool NativeModuleCache::Contains(ModuleOrigin origin,
+                                 base::Vector<const uint8_t> wire_bytes) {
+  if (!FLAG_wasm_native_module_cache_enabled) return false;
+  if (origin != kWasmOrigin) return false;
+  size_t prefix_hash = PrefixHash(wire_bytes);
+  base::MutexGuard lock(&mutex_);
+  return map_.count(Key{prefix_hash, wire_bytes}) != 0;
+}
+
 bool NativeModuleCache::GetStreamingCompilationOwnership(size_t prefix_hash) {
   base::MutexGuard lock(&mutex_);
   auto it = map_.lower_bound(Key{prefix_hash, {}});
@@ -439,7 +451,14 @@ struct WasmEngine::NativeModuleInfo {
   int8_t num_code_gcs_triggered = 0;
 };
 
-WasmEngine::WasmEngine() = default;
+WasmEngine::WasmEngine()
+    : shared_import_wrapper_cache_(
+          std::make_unique<SharedImportWrapperCache>()) {
+  if (FLAG_wasm_disk_cache_dir != nullptr) {
+    disk_cache_ = std::make_shared<WasmDiskCache>(
+        FLAG_wasm_disk_cache_dir, FLAG_wasm_disk_cache_max_size_mb * MB);
+  }
+}
 
 WasmEngine::~WasmEngine() {
 #ifdef V8_ENABLE_WASM_GDB_REMOTE_DEBUGGING
@@ -536,6 +555,16 @@ MaybeHandle<WasmModuleObject> WasmEngine::SyncCompile(
     const ModuleWireBytes& bytes) {
   int compilation_id = next_compilation_id_.fetch_add(1);
   TRACE_EVENT1("v8.wasm", "wasm.SyncCompile", "id", compilation_id);
+  // Modules that are cached in this process are cheaper to get from the
+  // in-process cache in {CompileToNativeModule}.
+  if (disk_cache_ &&
+      !IsNativeModuleCached(kWasmOrigin, bytes.module_bytes())) {
+    Handle<WasmModuleObject> module_object;
+    if (disk_cache_->Lookup(isolate, enabled, bytes.module_bytes())
+            .ToHandle(&module_object)) {
+      return module_object;
+    }
+  }
   v8::metrics::Recorder::ContextId context_id =
       isolate->GetOrRegisterRecorderContextId(isolate->native_context());
   ModuleResult result =
@@ -879,6 +908,32 @@ Handle<WasmModuleObject> WasmEngine::ImportNativeModule(
   return module_object;
 }
 
+bool WasmEngine::ImportTieringFeedback(base::Vector<const uint8_t> data) {
+  std::shared_ptr<const WasmTieringFeedback> feedback =
+      WasmTieringFeedback::Parse(data);
+  if (!feedback) return false;
+  base::MutexGuard guard(&mutex_);
+  tiering_feedback_[feedback->module_hash()] = std::move(feedback);
+  return true;
+}
+
+void WasmEngine::ApplyTieringFeedback(NativeModule* native_module) {
+  base::Vector<const uint8_t> wire_bytes = native_module->wire_bytes();
+  std::shared_ptr<const WasmTieringFeedback> feedback;
+  {
+    base::MutexGuard guard(&mutex_);
+    if (tiering_feedback_.empty()) return;
+    auto it =
+        tiering_feedback_.find(NativeModuleCache::WireBytesHash(wire_bytes));
+    if (it == tiering_feedback_.end()) return;
+    feedback = it->second;
+  }
+  if (!feedback->Matches(wire_bytes)) return;
+  TRACE_EVENT1("v8.wasm", "wasm.ApplyTieringFeedback", "num_hot_functions",
+               feedback->hot_functions().size());
+  feedback->ApplyTo(native_module->module(), wire_bytes);
+}
+
 std::shared_ptr<CompilationStatistics>
 WasmEngine::GetOrCreateTurboStatistics() {
   base::MutexGuard guard(&mutex_);
@@ -1219,6 +1274,11 @@ std::shared_ptr<NativeModule> WasmEngine::MaybeGetNativeModule(
   return native_module;
 }
 
+bool WasmEngine::IsNativeModuleCached(
+    ModuleOrigin origin, base::Vector<const uint8_t> wire_bytes) {
+  return native_module_cache_.Contains(origin, wire_bytes);
+}
+
 bool WasmEngine::UpdateNativeModuleCache(
     bool error, std::shared_ptr<NativeModule>* native_module,
     Isolate* isolate) {
@@ -47,7 +47,10 @@ class AsyncCompileJob;
 class ErrorThrower;
 struct ModuleWireBytes;
 class StreamingDecoder;
+class WasmDiskCache;
+class SharedImportWrapperCache;
 class WasmFeatures;
+class WasmTieringFeedback;
 
 class V8_EXPORT_PRIVATE CompilationResultResolver {
  public:
@@ -101,6 +104,7 @@ class NativeModuleCache {
 
   std::shared_ptr<NativeModule> MaybeGetNativeModule(
       ModuleOrigin origin, base::Vector<const uint8_t> wire_bytes);
+  bool Contains(ModuleOrigin origin, base::Vector<const uint8_t> wire_bytes);
   bool GetStreamingCompilationOwnership(size_t prefix_hash);
   void StreamingCompilationFailed(size_t prefix_hash);
   std::shared_ptr<NativeModule> Update(
@@ -222,6 +226,24 @@ class V8_EXPORT_PRIVATE WasmEngine {
 
   AccountingAllocator* allocator() { return &allocator_; }
 
+  // Makes tiering feedback that was exported via {WasmTieringFeedback::Export},
+  // possibly by an earlier process, available to later compilations of the
+  // same module. Returns false if {data} is invalid.
+  bool ImportTieringFeedback(base::Vector<const uint8_t> data);
+
+  // Applies imported tiering feedback for the wire bytes of {native_module},
+  // if there is any. Must be called before compilation starts.
+  void ApplyTieringFeedback(NativeModule* native_module);
+
+  // The persistent module cache, or nullptr if it is disabled. It is enabled
+  // via --wasm-disk-cache-dir.
+  WasmDiskCache* disk_cache() const { return disk_cache_.get(); }
+
+  // Compiled import wrappers, shared by all native modules.
+  SharedImportWrapperCache* shared_import_wrapper_cache() const {
+    return shared_import_wrapper_cache_.get();
+  }
+
   // Compilation statistics for TurboFan compilations. Returns a shared_ptr
   // so that background compilation jobs can hold on to it while the main thread
   // shuts down.
@@ -297,6 +319,13 @@ class V8_EXPORT_PRIVATE WasmEngine {
       ModuleOrigin origin, base::Vector<const uint8_t> wire_bytes,
       Isolate* isolate);
 
+  // Returns whether the {NativeModule} for these bytes exists or is being
+  // created. Unlike {MaybeGetNativeModule}, this never blocks and does not
+  // take ownership of the creation, so it can be used to skip more expensive
+  // lookups, e.g. in the {WasmDiskCache}. Can be called from any thread.
+  bool IsNativeModuleCached(ModuleOrigin origin,
+                            base::Vector<const uint8_t> wire_bytes);
+
   // Replace the temporary {nullopt} with the new native module, or
   // erase it if any error occurred. Wake up blocked threads waiting for this
   // module.
@@ -390,6 +419,11 @@ class V8_EXPORT_PRIVATE WasmEngine {
 
   AccountingAllocator allocator_;
 
+  // Shared with background tasks that store modules in the cache.
+  std::shared_ptr<WasmDiskCache> disk_cache_;
+
+  const std::unique_ptr<SharedImportWrapperCache> shared_import_wrapper_cache_;
+
 #ifdef V8_ENABLE_WASM_GDB_REMOTE_DEBUGGING
   // Implements a GDB-remote stub for WebAssembly debugging.
   std::unique_ptr<gdb_server::GdbServer> gdb_server_;
@@ -434,6 +468,10 @@ class V8_EXPORT_PRIVATE WasmEngine {
 
   NativeModuleCache native_module_cache_;
 
+  // Imported tiering feedback, by hash of the module's wire bytes.
+  std::unordered_map<size_t, std::shared_ptr<const WasmTieringFeedback>>
+      tiering_feedback_;
+
   // End of fields protected by {mutex_}.
   //////////////////////////////////////////////////////////////////////////////
 };
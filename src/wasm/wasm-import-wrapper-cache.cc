@@ -6,7 +6,11 @@
 
 #include <vector>
 
+#include "src/codegen/assembler.h"
+#include "src/codegen/reloc-info.h"
 #include "src/logging/counters.h"
+#include "src/wasm/compilation-environment.h"
+#include "src/wasm/function-compiler.h"
 #include "src/wasm/wasm-code-manager.h"
 
 namespace v8 {
@@ -56,6 +60,111 @@ WasmImportWrapperCache::~WasmImportWrapperCache() {
   WasmCode::DecrementRefCount(base::VectorOf(ptrs));
 }
 
+namespace {
+
+// Wrappers for reference types might depend on the types of the module.
+bool IsCacheableSignature(const FunctionSig* sig) {
+  for (ValueType type : sig->all()) {
+    if (!type.is_numeric()) return false;
+  }
+  return true;
+}
+
+// Relocations in {RelocInfo::kApplyMask} are applied relative to the buffer
+// the code was generated in, so code containing them cannot be copied to
+// another buffer. Wasm calls and stub calls are encoded as tags instead.
+bool CanBeCopied(const CodeDesc& desc) {
+  int mode_mask =
+      RelocInfo::kApplyMask & ~RelocInfo::ModeMask(RelocInfo::WASM_CALL);
+  return RelocIterator(desc, mode_mask).done();
+}
+
+// Copies the code and metadata of {result}. Only the instructions and the
+// relocation info at the end of the buffer are used when adding the code to a
+// native module, so the rest of the buffer is not copied.
+WasmCompilationResult CopyWrapper(const WasmCompilationResult& result) {
+  const CodeDesc& desc = result.code_desc;
+  WasmCompilationResult copy;
+  copy.instr_buffer = NewAssemblerBuffer(desc.buffer_size);
+  copy.code_desc = desc;
+  copy.code_desc.buffer = copy.instr_buffer->start();
+  copy.code_desc.origin = nullptr;
+  memcpy(copy.code_desc.buffer, desc.buffer, desc.instr_size);
+  int reloc_start = desc.buffer_size - desc.reloc_size;
+  memcpy(copy.code_desc.buffer + reloc_start, desc.buffer + reloc_start,
+         desc.reloc_size);
+  copy.frame_slot_count = result.frame_slot_count;
+  copy.tagged_parameter_slots = result.tagged_parameter_slots;
+  copy.source_positions =
+      base::OwnedVector<byte>::Of(result.source_positions.as_vector());
+  copy.protected_instructions_data = base::OwnedVector<byte>::Of(
+      result.protected_instructions_data.as_vector());
+  copy.func_index = result.func_index;
+  copy.result_tier = result.result_tier;
+  copy.kind = result.kind;
+  copy.for_debugging = result.for_debugging;
+  return copy;
+}
+
+}  // namespace
+
+size_t SharedImportWrapperCache::KeyHash::operator()(const Key& key) const {
+  size_t hash = base::hash_combine(static_cast<uint8_t>(key.kind),
+                                   key.return_count, key.expected_arity);
+  for (ValueType type : key.reps) hash = base::hash_combine(hash, type);
+  return hash;
+}
+
+SharedImportWrapperCache::SharedImportWrapperCache() = default;
+SharedImportWrapperCache::~SharedImportWrapperCache() = default;
+
+WasmCompilationResult SharedImportWrapperCache::GetOrCompile(
+    CompilationEnv* env, compiler::WasmImportCallKind kind,
+    const FunctionSig* sig, bool source_positions, int expected_arity,
+    Suspend suspend) {
+  if (!FLAG_wasm_shared_import_wrapper_cache || !IsCacheableSignature(sig)) {
+    return compiler::CompileWasmImportCallWrapper(
+        env, kind, sig, source_positions, expected_arity, suspend);
+  }
+  Key key{kind,
+          sig->return_count(),
+          std::vector<ValueType>(sig->all().begin(), sig->all().end()),
+          expected_arity,
+          suspend,
+          source_positions,
+          env->enabled_features.ToIntegral()};
+  {
+    base::MutexGuard guard(&mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+      ++num_hits_;
+      return CopyWrapper(*it->second);
+    }
+  }
+  // Compile without holding the lock. If another thread compiles the same
+  // wrapper concurrently, the first one to finish is kept.
+  WasmCompilationResult result = compiler::CompileWasmImportCallWrapper(
+      env, kind, sig, source_positions, expected_arity, suspend);
+  if (result.succeeded() && CanBeCopied(result.code_desc)) {
+    base::MutexGuard guard(&mutex_);
+    if (entries_.size() < kMaxEntries && entries_.count(key) == 0) {
+      entries_.emplace(std::move(key), std::make_unique<WasmCompilationResult>(
+                                           CopyWrapper(result)));
+    }
+  }
+  return result;
+}
+
+size_t SharedImportWrapperCache::size() const {
+  base::MutexGuard guard(&mutex_);
+  return entries_.size();
+}
+
+size_t SharedImportWrapperCache::num_hits() const {
+  base::MutexGuard guard(&mutex_);
+  return num_hits_;
+}
+
 }  // namespace wasm
 }  // namespace internal
 }  // namespace v8
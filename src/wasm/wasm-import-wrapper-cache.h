@@ -9,6 +9,10 @@
 #ifndef V8_WASM_WASM_IMPORT_WRAPPER_CACHE_H_
 #define V8_WASM_WASM_IMPORT_WRAPPER_CACHE_H_
 
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
 #include "src/base/platform/mutex.h"
 #include "src/compiler/wasm-compiler.h"
 
@@ -21,6 +25,8 @@ namespace wasm {
 
 class WasmCode;
 class WasmEngine;
+struct CompilationEnv;
+struct WasmCompilationResult;
 
 using FunctionSig = Signature<ValueType>;
 
@@ -37,8 +43,10 @@ class WasmImportWrapperCache {
                              : _expected_arity),
           suspend(_suspend) {}
 
+    // Signatures are compared structurally, such that different signature
+    // entries of the same module share their wrappers.
     bool operator==(const CacheKey& rhs) const {
-      return kind == rhs.kind && signature == rhs.signature &&
+      return kind == rhs.kind && *signature == *rhs.signature &&
              expected_arity == rhs.expected_arity && suspend == rhs.suspend;
     }
 
@@ -51,7 +59,8 @@ class WasmImportWrapperCache {
   class CacheKeyHash {
    public:
     size_t operator()(const CacheKey& key) const {
-      return base::hash_combine(static_cast<uint8_t>(key.kind), key.signature,
+      return base::hash_combine(static_cast<uint8_t>(key.kind),
+                                hash_value(*key.signature),
                                 key.expected_arity);
     }
   };
@@ -88,6 +97,61 @@ class WasmImportWrapperCache {
   std::unordered_map<CacheKey, WasmCode*, CacheKeyHash> entry_map_;
 };
 
+// A process-wide cache of compiled import wrappers, shared by all native
+// modules. The code of a wrapper only depends on the call kind and on the
+// signature, so modules with the same import signatures (e.g. repeated
+// instantiations of Emscripten output) compile each wrapper only once and copy
+// it into their own code space afterwards. Only wrappers for signatures of
+// numeric types are cached, others might depend on the types of the module.
+class SharedImportWrapperCache {
+ public:
+  SharedImportWrapperCache();
+  ~SharedImportWrapperCache();
+
+  // Returns a copy of the cached wrapper for these parameters, or compiles the
+  // wrapper and adds it to the cache. Thread-safe.
+  V8_EXPORT_PRIVATE WasmCompilationResult
+  GetOrCompile(CompilationEnv* env, compiler::WasmImportCallKind kind,
+               const FunctionSig* sig, bool source_positions,
+               int expected_arity, Suspend suspend);
+
+  V8_EXPORT_PRIVATE size_t size() const;
+  // Returns how many wrappers were copied from the cache so far.
+  V8_EXPORT_PRIVATE size_t num_hits() const;
+
+ private:
+  struct Key {
+    bool operator==(const Key& rhs) const {
+      return kind == rhs.kind && return_count == rhs.return_count &&
+             reps == rhs.reps && expected_arity == rhs.expected_arity &&
+             suspend == rhs.suspend &&
+             source_positions == rhs.source_positions &&
+             features == rhs.features;
+    }
+
+    compiler::WasmImportCallKind kind;
+    size_t return_count;
+    std::vector<ValueType> reps;
+    int expected_arity;
+    Suspend suspend;
+    bool source_positions;
+    int features;
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  // The number of wrappers is bounded by the number of distinct signatures
+  // that are used in practice; stop adding entries beyond this limit.
+  static constexpr size_t kMaxEntries = 1024;
+
+  mutable base::Mutex mutex_;
+  std::unordered_map<Key, std::unique_ptr<WasmCompilationResult>, KeyHash>
+      entries_;
+  size_t num_hits_ = 0;
+};
+
 }  // namespace wasm
 }  // namespace internal
 }  // namespace v8
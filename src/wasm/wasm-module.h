@@ -11,6 +11,7 @@
 
 #include <map>
 #include <memory>
+#include <set>
 
 #include "src/base/optional.h"
 #include "src/base/platform/wrappers.h"
@@ -390,7 +391,12 @@ struct FunctionTypeFeedback {
 };
 struct TypeFeedbackStorage {
   std::map<uint32_t, FunctionTypeFeedback> feedback_for_function;
-  // Accesses to {feedback_for_function} are guarded by this mutex.
+  // Functions which were hot in an earlier run (see {WasmTieringFeedback}).
+  // With dynamic tiering, they are compiled with TurboFan right away.
+  std::set<uint32_t> known_hot_functions;
+  // Accesses to {feedback_for_function} and {known_hot_functions} are guarded
+  // by this mutex. {known_hot_functions} is only written before compilation
+  // starts, so compilation can read it without holding the mutex.
   base::Mutex mutex;
 };
 
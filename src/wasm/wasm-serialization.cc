@@ -11,6 +11,7 @@
 #include "src/objects/objects.h"
 #include "src/runtime/runtime.h"
 #include "src/snapshot/code-serializer.h"
+#include "src/tracing/trace-event.h"
 #include "src/utils/ostreams.h"
 #include "src/utils/utils.h"
 #include "src/utils/version.h"
@@ -475,8 +476,14 @@ bool NativeModuleSerializer::Write(Writer* writer) {
 }
 
 WasmSerializer::WasmSerializer(NativeModule* native_module)
-    : native_module_(native_module),
-      code_table_(native_module->SnapshotCodeTable()) {}
+    : native_module_(native_module) {
+  // Functions which were not deserialized yet are missing in the code table.
+  if (LazilyDeserializedCode* lazily_deserialized_code =
+          native_module->lazily_deserialized_code()) {
+    lazily_deserialized_code->DeserializeAll(native_module);
+  }
+  code_table_ = native_module->SnapshotCodeTable();
+}
 
 size_t WasmSerializer::GetSerializedNativeModuleSize() const {
   NativeModuleSerializer serializer(native_module_,
@@ -545,7 +552,10 @@ class DeserializationQueue {
 
 class V8_EXPORT_PRIVATE NativeModuleDeserializer {
  public:
-  explicit NativeModuleDeserializer(NativeModule*);
+  // If {lazily_deserialized_code} is given, TurboFan code is recorded there
+  // instead of being copied into the code space.
+  explicit NativeModuleDeserializer(
+      NativeModule*, LazilyDeserializedCode* lazily_deserialized_code = nullptr);
   NativeModuleDeserializer(const NativeModuleDeserializer&) = delete;
   NativeModuleDeserializer& operator=(const NativeModuleDeserializer&) = delete;
 
@@ -559,6 +569,14 @@ class V8_EXPORT_PRIVATE NativeModuleDeserializer {
     return base::VectorOf(liftoff_functions_);
   }
 
+  base::Vector<const int> lazily_deserialized_functions() {
+    return base::VectorOf(lazily_deserialized_functions_);
+  }
+
+  // Deserializes and publishes the code of a single function that was skipped
+  // by {Read} before.
+  WasmCode* ReadSingleFunction(int fn_index, int code_size, Reader* reader);
+
  private:
   friend class DeserializeCodeTask;
 
@@ -568,6 +586,7 @@ class V8_EXPORT_PRIVATE NativeModuleDeserializer {
   void Publish(std::vector<DeserializationUnit> batch);
 
   NativeModule* const native_module_;
+  LazilyDeserializedCode* const lazily_deserialized_code_;
 #ifdef DEBUG
   bool read_called_ = false;
 #endif
@@ -578,6 +597,7 @@ class V8_EXPORT_PRIVATE NativeModuleDeserializer {
   NativeModule::JumpTablesRef current_jump_tables_;
   std::vector<int> lazy_functions_;
   std::vector<int> liftoff_functions_;
+  std::vector<int> lazily_deserialized_functions_;
 };
 
 class DeserializeCodeTask : public JobTask {
@@ -642,8 +662,11 @@ class DeserializeCodeTask : public JobTask {
   std::atomic<bool> publishing_{false};
 };
 
-NativeModuleDeserializer::NativeModuleDeserializer(NativeModule* native_module)
-    : native_module_(native_module) {}
+NativeModuleDeserializer::NativeModuleDeserializer(
+    NativeModule* native_module,
+    LazilyDeserializedCode* lazily_deserialized_code)
+    : native_module_(native_module),
+      lazily_deserialized_code_(lazily_deserialized_code) {}
 
 bool NativeModuleDeserializer::Read(Reader* reader) {
   DCHECK(!read_called_);
@@ -707,6 +730,7 @@ void NativeModuleDeserializer::ReadHeader(Reader* reader) {
 
 DeserializationUnit NativeModuleDeserializer::ReadCode(int fn_index,
                                                        Reader* reader) {
+  const byte* function_start = reader->current_location();
   uint8_t code_kind = reader->Read<uint8_t>();
   if (code_kind == kLazyFunction) {
     lazy_functions_.push_back(fn_index);
@@ -733,6 +757,17 @@ DeserializationUnit NativeModuleDeserializer::ReadCode(int fn_index,
 
   DCHECK(IsAligned(code_size, kCodeAlignment));
   DCHECK_GE(remaining_code_size_, code_size);
+  if (lazily_deserialized_code_) {
+    // Only remember where the code is, it gets copied on the first call.
+    size_t offset = static_cast<size_t>(
+        function_start - lazily_deserialized_code_->data().begin());
+    lazily_deserialized_code_->Add(fn_index, offset, code_size);
+    lazily_deserialized_functions_.push_back(fn_index);
+    reader->Skip(code_size + reloc_size + source_position_size +
+                 protected_instructions_size);
+    remaining_code_size_ -= code_size;
+    return {};
+  }
   if (current_code_space_.size() < static_cast<size_t>(code_size)) {
     // Allocate the next code space. Don't allocate more than 90% of
     // {kMaxCodeSpaceSize}, to leave some space for jump tables.
@@ -835,6 +870,85 @@ void NativeModuleDeserializer::Publish(std::vector<DeserializationUnit> batch) {
   }
 }
 
+WasmCode* NativeModuleDeserializer::ReadSingleFunction(int fn_index,
+                                                       int code_size,
+                                                       Reader* reader) {
+  DCHECK_NULL(lazily_deserialized_code_);
+  remaining_code_size_ = code_size;
+  DeserializationUnit unit = ReadCode(fn_index, reader);
+  DCHECK_NOT_NULL(unit.code);
+  CopyAndRelocate(unit);
+  WasmCode* code = native_module_->PublishCode(std::move(unit.code));
+  code->MaybePrint();
+  code->Validate();
+  return code;
+}
+
+LazilyDeserializedCode::LazilyDeserializedCode(
+    base::OwnedVector<const byte> data, uint32_t num_functions)
+    : owned_data_(std::move(data)),
+      data_(owned_data_.as_vector()),
+      entries_(num_functions) {}
+
+LazilyDeserializedCode::LazilyDeserializedCode(
+    std::unique_ptr<base::OS::MemoryMappedFile> file,
+    base::Vector<const byte> data, uint32_t num_functions)
+    : mapped_file_(std::move(file)), data_(data), entries_(num_functions) {}
+
+LazilyDeserializedCode::~LazilyDeserializedCode() = default;
+
+void LazilyDeserializedCode::Add(int func_index, size_t offset,
+                                 int code_size) {
+  DCHECK_LT(0, code_size);
+  DCHECK_EQ(0, entries_[func_index].code_size);
+  entries_[func_index] = {offset, code_size, false};
+  ++remaining_functions_;
+}
+
+WasmCode* LazilyDeserializedCode::Deserialize(NativeModule* native_module,
+                                              int func_index) {
+  TRACE_EVENT1("v8.wasm", "wasm.LazyDeserialization", "func_index",
+               func_index);
+  base::MutexGuard guard(&mutex_);
+  return DeserializeLocked(native_module, func_index);
+}
+
+void LazilyDeserializedCode::DeserializeAll(NativeModule* native_module) {
+  base::MutexGuard guard(&mutex_);
+  if (remaining_functions_ == 0) return;
+  TRACE_EVENT1("v8.wasm", "wasm.LazyDeserializationOfAllFunctions",
+               "num_functions", remaining_functions_);
+  CodeSpaceWriteScope code_space_write_scope(native_module);
+  WasmCodeRefScope code_ref_scope;
+  for (size_t func_index = 0; func_index < entries_.size(); ++func_index) {
+    DeserializeLocked(native_module, static_cast<int>(func_index));
+  }
+}
+
+size_t LazilyDeserializedCode::remaining_functions() const {
+  base::MutexGuard guard(&mutex_);
+  return remaining_functions_;
+}
+
+WasmCode* LazilyDeserializedCode::DeserializeLocked(
+    NativeModule* native_module, int func_index) {
+  Entry& entry = entries_[func_index];
+  if (entry.code_size == 0 || entry.deserialized) return nullptr;
+  NativeModuleDeserializer deserializer(native_module);
+  Reader reader(data_ + entry.offset);
+  WasmCode* code =
+      deserializer.ReadSingleFunction(func_index, entry.code_size, &reader);
+  entry.deserialized = true;
+  if (--remaining_functions_ == 0) {
+    // All code was copied into the code space, so the serialized module is not
+    // needed any more.
+    data_ = {};
+    owned_data_ = {};
+    mapped_file_.reset();
+  }
+  return code;
+}
+
 bool IsSupportedVersion(base::Vector<const byte> header) {
   if (header.size() < WasmSerializer::kHeaderSize) return false;
   byte current_version[WasmSerializer::kHeaderSize];
@@ -844,8 +958,11 @@ bool IsSupportedVersion(base::Vector<const byte> header) {
          0;
 }
 
-MaybeHandle<WasmModuleObject> DeserializeNativeModule(
+namespace {
+
+MaybeHandle<WasmModuleObject> DeserializeNativeModuleImpl(
     Isolate* isolate, base::Vector<const byte> data,
+    std::unique_ptr<base::OS::MemoryMappedFile> mapped_file,
     base::Vector<const byte> wire_bytes_vec,
     base::Vector<const char> source_url) {
   if (!IsWasmCodegenAllowed(isolate, isolate->native_context())) return {};
@@ -885,7 +1002,23 @@ MaybeHandle<WasmModuleObject> DeserializeNativeModule(
     shared_native_module->compilation_state()->set_compilation_id(-2);
     shared_native_module->SetWireBytes(std::move(owned_wire_bytes));
 
-    NativeModuleDeserializer deserializer(shared_native_module.get());
+    std::unique_ptr<LazilyDeserializedCode> lazily_deserialized_code;
+    if (FLAG_wasm_lazy_deserialization) {
+      // Keep the serialized module alive, such that code can be copied on the
+      // first call of each function. A memory-mapped file only gets paged in
+      // for the functions that are actually called.
+      uint32_t num_functions = shared_native_module->num_functions();
+      lazily_deserialized_code =
+          mapped_file ? std::make_unique<LazilyDeserializedCode>(
+                            std::move(mapped_file), data, num_functions)
+                      : std::make_unique<LazilyDeserializedCode>(
+                            base::OwnedVector<const byte>(
+                                base::OwnedVector<byte>::Of(data)),
+                            num_functions);
+      data = lazily_deserialized_code->data();
+    }
+    NativeModuleDeserializer deserializer(shared_native_module.get(),
+                                          lazily_deserialized_code.get());
     Reader reader(data + WasmSerializer::kHeaderSize);
     bool error = !deserializer.Read(&reader);
     if (error) {
@@ -893,8 +1026,13 @@ MaybeHandle<WasmModuleObject> DeserializeNativeModule(
                                            isolate);
       return {};
     }
+    if (lazily_deserialized_code) {
+      shared_native_module->set_lazily_deserialized_code(
+          std::move(lazily_deserialized_code));
+    }
     shared_native_module->compilation_state()->InitializeAfterDeserialization(
-        deserializer.lazy_functions(), deserializer.liftoff_functions());
+        deserializer.lazy_functions(), deserializer.liftoff_functions(),
+        deserializer.lazily_deserialized_functions());
     wasm_engine->UpdateNativeModuleCache(error, &shared_native_module, isolate);
   }
 
@@ -916,6 +1054,27 @@ MaybeHandle<WasmModuleObject> DeserializeNativeModule(
   return module_object;
 }
 
+}  // namespace
+
+MaybeHandle<WasmModuleObject> DeserializeNativeModule(
+    Isolate* isolate, base::Vector<const byte> data,
+    base::Vector<const byte> wire_bytes, base::Vector<const char> source_url) {
+  return DeserializeNativeModuleImpl(isolate, data, nullptr, wire_bytes,
+                                     source_url);
+}
+
+MaybeHandle<WasmModuleObject> DeserializeNativeModule(
+    Isolate* isolate, std::unique_ptr<base::OS::MemoryMappedFile> file,
+    size_t offset, base::Vector<const byte> wire_bytes,
+    base::Vector<const char> source_url) {
+  if (file->size() < offset) return {};
+  base::Vector<const byte> data{static_cast<const byte*>(file->memory()),
+                                file->size()};
+  data += offset;
+  return DeserializeNativeModuleImpl(isolate, data, std::move(file),
+                                     wire_bytes, source_url);
+}
+
 }  // namespace wasm
 }  // namespace internal
 }  // namespace v8
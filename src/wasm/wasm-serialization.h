@@ -9,6 +9,11 @@
 #ifndef V8_WASM_WASM_SERIALIZATION_H_
 #define V8_WASM_WASM_SERIALIZATION_H_
 
+#include <memory>
+#include <vector>
+
+#include "src/base/platform/mutex.h"
+#include "src/base/platform/platform.h"
 #include "src/wasm/wasm-code-manager.h"
 #include "src/wasm/wasm-objects.h"
 
@@ -52,6 +57,67 @@ class V8_EXPORT_PRIVATE WasmSerializer {
   std::vector<WasmCode*> code_table_;
 };
 
+// The serialized TurboFan code of functions which are only copied into the
+// code space and relocated when they are called for the first time (see
+// {--wasm-lazy-deserialization}). Their jump table slots point to the lazy
+// compile stub until then. The serialized module is kept alive for that, either
+// as a copy or as a memory-mapped file, until all functions were deserialized.
+class V8_EXPORT_PRIVATE LazilyDeserializedCode {
+ public:
+  LazilyDeserializedCode(base::OwnedVector<const byte> data,
+                         uint32_t num_functions);
+  LazilyDeserializedCode(std::unique_ptr<base::OS::MemoryMappedFile> file,
+                         base::Vector<const byte> data, uint32_t num_functions);
+  ~LazilyDeserializedCode();
+  LazilyDeserializedCode(const LazilyDeserializedCode&) = delete;
+  LazilyDeserializedCode& operator=(const LazilyDeserializedCode&) = delete;
+
+  // Returns whether the code of {func_index} is (or was) deserialized lazily.
+  // This does not change after deserialization of the module, so it can be
+  // called without synchronization.
+  bool HasFunction(int func_index) const {
+    return entries_[func_index].code_size != 0;
+  }
+
+  // Copies the code of {func_index} into the code space, relocates and
+  // publishes it. Returns nullptr if this happened before already.
+  // Requires a {CodeSpaceWriteScope} and a {WasmCodeRefScope}.
+  WasmCode* Deserialize(NativeModule* native_module, int func_index);
+
+  // Deserializes all remaining functions, e.g. before the module gets
+  // serialized again.
+  void DeserializeAll(NativeModule* native_module);
+
+  size_t remaining_functions() const;
+
+  // The serialized module. Only valid while functions remain to be
+  // deserialized.
+  base::Vector<const byte> data() const { return data_; }
+
+ private:
+  friend class NativeModuleDeserializer;
+
+  struct Entry {
+    // Offset of the serialized function in {data_}.
+    size_t offset = 0;
+    // Zero for functions that are not deserialized lazily.
+    int code_size = 0;
+    bool deserialized = false;
+  };
+
+  void Add(int func_index, size_t offset, int code_size);
+  WasmCode* DeserializeLocked(NativeModule* native_module, int func_index);
+
+  mutable base::Mutex mutex_;
+  // Protected by {mutex_} after deserialization of the module. The backing
+  // store is released once {remaining_functions_} drops to zero.
+  base::OwnedVector<const byte> owned_data_;
+  std::unique_ptr<base::OS::MemoryMappedFile> mapped_file_;
+  base::Vector<const byte> data_;
+  std::vector<Entry> entries_;
+  size_t remaining_functions_ = 0;
+};
+
 // Support for deserializing WebAssembly {NativeModule} objects.
 // Checks the version header of the data against the current version.
 bool IsSupportedVersion(base::Vector<const byte> data);
@@ -61,6 +127,13 @@ V8_EXPORT_PRIVATE MaybeHandle<WasmModuleObject> DeserializeNativeModule(
     Isolate*, base::Vector<const byte> data,
     base::Vector<const byte> wire_bytes, base::Vector<const char> source_url);
 
+// Same as above, for a serialized module at {offset} in a memory-mapped
+// {file}. With {--wasm-lazy-deserialization}, the returned module keeps the
+// mapping alive instead of copying the serialized module.
+V8_EXPORT_PRIVATE MaybeHandle<WasmModuleObject> DeserializeNativeModule(
+    Isolate*, std::unique_ptr<base::OS::MemoryMappedFile> file, size_t offset,
+    base::Vector<const byte> wire_bytes, base::Vector<const char> source_url);
+
 }  // namespace wasm
 }  // namespace internal
 }  // namespace v8
@@ -0,0 +1,283 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/wasm/wasm-tiering-feedback.h"
+
+#include <cstring>
+
+#include "src/base/platform/mutex.h"
+#include "src/flags/flags.h"
+#include "src/utils/version.h"
+#include "src/wasm/function-body-decoder.h"
+#include "src/wasm/wasm-code-manager.h"
+#include "src/wasm/wasm-constants.h"
+#include "src/wasm/wasm-engine.h"
+#include "src/wasm/wasm-module.h"
+#include "src/zone/accounting-allocator.h"
+
+namespace v8 {
+namespace internal {
+namespace wasm {
+
+namespace {
+
+// The serialized feedback starts with this header, followed by the number of
+// hot functions. Each function is stored as its index, the number of call
+// sites, and for each call site the number of cases followed by pairs of
+// target function index and call count. The call sites are followed by the
+// number of call targets and the targets.
+constexpr uint32_t kMagicNumber = 0x43465457;  // "WTFC"
+
+class FeedbackWriter {
+ public:
+  template <typename T>
+  void Write(T value) {
+    size_t offset = buffer_.size();
+    buffer_.resize(offset + sizeof(T));
+    memcpy(buffer_.data() + offset, &value, sizeof(T));
+  }
+
+  template <typename T>
+  void WriteAt(size_t offset, T value) {
+    DCHECK_LE(offset + sizeof(T), buffer_.size());
+    memcpy(buffer_.data() + offset, &value, sizeof(T));
+  }
+
+  size_t offset() const { return buffer_.size(); }
+
+  base::OwnedVector<uint8_t> Finish() {
+    return base::OwnedVector<uint8_t>::Of(buffer_);
+  }
+
+ private:
+  std::vector<uint8_t> buffer_;
+};
+
+class FeedbackReader {
+ public:
+  explicit FeedbackReader(base::Vector<const uint8_t> data) : data_(data) {}
+
+  // Returns 0 and marks the reader as failed if the data is exhausted.
+  template <typename T>
+  T Read() {
+    if (failed_ || data_.size() - pos_ < sizeof(T)) {
+      failed_ = true;
+      return T{0};
+    }
+    T value;
+    memcpy(&value, data_.begin() + pos_, sizeof(T));
+    pos_ += sizeof(T);
+    return value;
+  }
+
+  // Reads a count of entries of {entry_size} bytes each, and fails if the
+  // remaining data cannot hold that many entries.
+  uint32_t ReadCount(size_t entry_size) {
+    uint32_t count = Read<uint32_t>();
+    if (count > (data_.size() - pos_) / entry_size) failed_ = true;
+    return failed_ ? 0 : count;
+  }
+
+  bool failed() const { return failed_; }
+  bool at_end() const { return pos_ == data_.size(); }
+
+ private:
+  const base::Vector<const uint8_t> data_;
+  size_t pos_ = 0;
+  bool failed_ = false;
+};
+
+}  // namespace
+
+// static
+base::OwnedVector<uint8_t> WasmTieringFeedback::Export(
+    const NativeModule* native_module) {
+  return Export(native_module->module(), native_module->wire_bytes());
+}
+
+// static
+base::OwnedVector<uint8_t> WasmTieringFeedback::Export(
+    const WasmModule* module, base::Vector<const uint8_t> wire_bytes) {
+  FeedbackWriter writer;
+  writer.Write(kMagicNumber);
+  writer.Write(Version::Hash());
+  writer.Write(FlagList::Hash());
+  writer.Write(
+      static_cast<uint64_t>(NativeModuleCache::WireBytesHash(wire_bytes)));
+  writer.Write(static_cast<uint32_t>(wire_bytes.size()));
+  size_t num_functions_offset = writer.offset();
+  writer.Write(uint32_t{0});
+
+  uint32_t num_hot_functions = 0;
+  {
+    TypeFeedbackStorage& type_feedback = module->type_feedback;
+    base::MutexGuard mutex_guard(&type_feedback.mutex);
+    for (const auto& entry : type_feedback.feedback_for_function) {
+      uint32_t func_index = entry.first;
+      const FunctionTypeFeedback& feedback = entry.second;
+      // Functions that were compiled with TurboFan right away because of
+      // imported feedback never trigger tier-up, but are still hot.
+      if (feedback.tierup_priority == 0 &&
+          type_feedback.known_hot_functions.count(func_index) == 0) {
+        continue;
+      }
+      ++num_hot_functions;
+      writer.Write(func_index);
+      writer.Write(static_cast<uint32_t>(feedback.feedback_vector.size()));
+      for (const CallSiteFeedback& call_site : feedback.feedback_vector) {
+        int num_cases = call_site.num_cases();
+        writer.Write(static_cast<uint32_t>(num_cases));
+        for (int i = 0; i < num_cases; ++i) {
+          writer.Write(static_cast<uint32_t>(call_site.function_index(i)));
+          writer.Write(static_cast<int32_t>(call_site.call_count(i)));
+        }
+      }
+      writer.Write(static_cast<uint32_t>(feedback.call_targets.size()));
+      for (uint32_t target : feedback.call_targets) writer.Write(target);
+    }
+  }
+  if (num_hot_functions == 0) return {};
+  writer.WriteAt(num_functions_offset, num_hot_functions);
+  return writer.Finish();
+}
+
+// static
+std::unique_ptr<WasmTieringFeedback> WasmTieringFeedback::Parse(
+    base::Vector<const uint8_t> data) {
+  FeedbackReader reader(data);
+  if (reader.Read<uint32_t>() != kMagicNumber ||
+      reader.Read<uint32_t>() != Version::Hash() ||
+      reader.Read<uint32_t>() != FlagList::Hash()) {
+    return {};
+  }
+  auto feedback = std::make_unique<WasmTieringFeedback>();
+  feedback->module_hash_ = static_cast<size_t>(reader.Read<uint64_t>());
+  feedback->module_size_ = reader.Read<uint32_t>();
+
+  constexpr size_t kMinFunctionSize = 3 * sizeof(uint32_t);
+  constexpr size_t kCaseSize = sizeof(uint32_t) + sizeof(int32_t);
+  uint32_t num_functions = reader.ReadCount(kMinFunctionSize);
+  feedback->hot_functions_.resize(num_functions);
+  for (FunctionFeedback& function : feedback->hot_functions_) {
+    function.function_index = reader.Read<uint32_t>();
+    uint32_t num_call_sites = reader.ReadCount(sizeof(uint32_t));
+    function.call_sites.resize(num_call_sites);
+    for (std::vector<CallCase>& call_site : function.call_sites) {
+      uint32_t num_cases = reader.ReadCount(kCaseSize);
+      if (num_cases > static_cast<uint32_t>(kMaxPolymorphism)) return {};
+      call_site.resize(num_cases);
+      for (CallCase& call_case : call_site) {
+        call_case.function_index = reader.Read<uint32_t>();
+        call_case.call_count = reader.Read<int32_t>();
+      }
+    }
+    uint32_t num_call_targets = reader.ReadCount(sizeof(uint32_t));
+    function.call_targets.resize(num_call_targets);
+    for (uint32_t& target : function.call_targets) {
+      target = reader.Read<uint32_t>();
+    }
+    if (reader.failed()) return {};
+  }
+  if (reader.failed() || !reader.at_end()) return {};
+  return feedback;
+}
+
+bool WasmTieringFeedback::Matches(
+    base::Vector<const uint8_t> wire_bytes) const {
+  return module_size_ == wire_bytes.size() &&
+         module_hash_ == NativeModuleCache::WireBytesHash(wire_bytes);
+}
+
+namespace {
+
+bool IsMonomorphicCallTo(const std::vector<WasmTieringFeedback::CallCase>& site,
+                         uint32_t target) {
+  return site.size() == 1 && site[0].function_index == target;
+}
+
+}  // namespace
+
+bool WasmTieringFeedback::IsValidFor(const WasmModule* module,
+                                     base::Vector<const uint8_t> wire_bytes,
+                                     const FunctionFeedback& function) {
+  // Compilation reads one entry of the feedback vector per call instruction
+  // that collects feedback, so the feedback has to have the same shape as the
+  // function body.
+  const WireBytesRef code = module->functions[function.function_index].code;
+  if (code.end_offset() > wire_bytes.size()) return false;
+  std::vector<uint32_t> targets;
+  AccountingAllocator allocator;
+  if (!CollectCallTargets(&allocator, module,
+                          wire_bytes.begin() + code.offset(),
+                          wire_bytes.begin() + code.end_offset(), &targets)) {
+    return false;
+  }
+  if (function.call_targets != targets ||
+      function.call_sites.size() != targets.size()) {
+    return false;
+  }
+  uint32_t start = module->num_imported_functions;
+  uint32_t end = start + module->num_declared_functions;
+  for (size_t i = 0; i < targets.size(); ++i) {
+    const std::vector<CallCase>& call_site = function.call_sites[i];
+    if (targets[i] != FunctionTypeFeedback::kNonDirectCall) {
+      // Direct calls, including calls to imported functions, always have
+      // monomorphic feedback with their call count.
+      if (!IsMonomorphicCallTo(call_site, targets[i])) return false;
+      continue;
+    }
+    // Only declared functions can be inlined at call_ref sites.
+    for (const CallCase& call_case : call_site) {
+      if (call_case.function_index < start || call_case.function_index >= end) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void WasmTieringFeedback::ApplyTo(
+    const WasmModule* module, base::Vector<const uint8_t> wire_bytes) const {
+  uint32_t start = module->num_imported_functions;
+  uint32_t end = start + module->num_declared_functions;
+  TypeFeedbackStorage& type_feedback = module->type_feedback;
+  base::MutexGuard mutex_guard(&type_feedback.mutex);
+  for (const FunctionFeedback& function : hot_functions_) {
+    uint32_t func_index = function.function_index;
+    if (func_index < start || func_index >= end) continue;
+    type_feedback.known_hot_functions.insert(func_index);
+    // The function is still compiled with TurboFan right away if its call
+    // feedback does not fit, but without feedback.
+    if (!IsValidFor(module, wire_bytes, function)) continue;
+    std::vector<CallSiteFeedback> feedback_vector;
+    feedback_vector.reserve(function.call_sites.size());
+    for (const std::vector<CallCase>& call_site : function.call_sites) {
+      if (call_site.empty()) {
+        feedback_vector.emplace_back();
+      } else if (call_site.size() == 1) {
+        feedback_vector.emplace_back(
+            static_cast<int>(call_site[0].function_index),
+            call_site[0].call_count);
+      } else {
+        int num_cases = static_cast<int>(call_site.size());
+        CallSiteFeedback::PolymorphicCase* polymorphic =
+            new CallSiteFeedback::PolymorphicCase[num_cases];
+        for (int i = 0; i < num_cases; ++i) {
+          polymorphic[i].function_index =
+              static_cast<int>(call_site[i].function_index);
+          polymorphic[i].absolute_call_frequency = call_site[i].call_count;
+        }
+        feedback_vector.emplace_back(polymorphic, num_cases);
+      }
+    }
+    FunctionTypeFeedback& function_feedback =
+        type_feedback.feedback_for_function[func_index];
+    function_feedback.feedback_vector = std::move(feedback_vector);
+    function_feedback.call_targets = function.call_targets;
+  }
+}
+
+}  // namespace wasm
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,87 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#if !V8_ENABLE_WEBASSEMBLY
+#error This header should only be included if WebAssembly is enabled.
+#endif  // !V8_ENABLE_WEBASSEMBLY
+
+#ifndef V8_WASM_WASM_TIERING_FEEDBACK_H_
+#define V8_WASM_WASM_TIERING_FEEDBACK_H_
+
+#include <memory>
+#include <vector>
+
+#include "src/base/vector.h"
+
+namespace v8 {
+namespace internal {
+namespace wasm {
+
+class NativeModule;
+struct WasmModule;
+
+// The tiering decisions and call target feedback that dynamic tiering and
+// speculative inlining collected for a module. It can be exported at the end
+// of one run and imported into the next one. Modules with the same wire bytes
+// then compile the functions that were hot with TurboFan right away, using the
+// recorded call targets for inlining, instead of warming up in Liftoff first.
+class V8_EXPORT_PRIVATE WasmTieringFeedback {
+ public:
+  struct CallCase {
+    uint32_t function_index;
+    int32_t call_count;
+  };
+
+  struct FunctionFeedback {
+    uint32_t function_index;
+    // The observed targets of each call site of the function, in the order of
+    // the call sites. Empty for call sites without feedback.
+    std::vector<std::vector<CallCase>> call_sites;
+    // The static target of each feedback-collecting call instruction, or
+    // {FunctionTypeFeedback::kNonDirectCall}. See
+    // {FunctionTypeFeedback::call_targets}.
+    std::vector<uint32_t> call_targets;
+  };
+
+  // Returns the serialized feedback for {native_module}, or an empty vector if
+  // no function of it became hot yet.
+  static base::OwnedVector<uint8_t> Export(const NativeModule* native_module);
+  static base::OwnedVector<uint8_t> Export(
+      const WasmModule* module, base::Vector<const uint8_t> wire_bytes);
+
+  // Parses feedback created by {Export}. Returns nullptr if {data} is invalid,
+  // or was created by a different V8 version.
+  static std::unique_ptr<WasmTieringFeedback> Parse(
+      base::Vector<const uint8_t> data);
+
+  // Returns whether the feedback belongs to a module with these wire bytes.
+  bool Matches(base::Vector<const uint8_t> wire_bytes) const;
+
+  // Records the hot functions and their call targets in {module}, which has
+  // the given {wire_bytes}. Call feedback that does not match the call
+  // instructions of its function is dropped. Must be called before
+  // compilation of the module starts.
+  void ApplyTo(const WasmModule* module,
+               base::Vector<const uint8_t> wire_bytes) const;
+
+  size_t module_hash() const { return module_hash_; }
+  const std::vector<FunctionFeedback>& hot_functions() const {
+    return hot_functions_;
+  }
+
+ private:
+  static bool IsValidFor(const WasmModule* module,
+                         base::Vector<const uint8_t> wire_bytes,
+                         const FunctionFeedback& function);
+
+  size_t module_hash_ = 0;
+  uint32_t module_size_ = 0;
+  std::vector<FunctionFeedback> hot_functions_;
+};
+
+}  // namespace wasm
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_WASM_WASM_TIERING_FEEDBACK_H_
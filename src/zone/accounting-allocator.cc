@@ -10,6 +10,7 @@
 #include "src/base/logging.h"
 #include "src/base/macros.h"
 #include "src/base/platform/wrappers.h"
+#include "src/flags/flags.h"
 #include "src/utils/allocation.h"
 #include "src/zone/zone-compression.h"
 #include "src/zone/zone-segment.h"
@@ -26,6 +27,10 @@ namespace {
 
 static constexpr size_t kZonePageSize = 256 * KB;
 
+// The smallest pooled segment size. This matches the minimum segment size of
+// zones, so that the first segment of every zone can be served from the pool.
+static constexpr size_t kMinPooledSegmentSize = 8 * KB;
+
 VirtualMemory ReserveAddressSpace(v8::PageAllocator* platform_allocator) {
   DCHECK(IsAligned(ZoneCompression::kReservationSize,
                    platform_allocator->AllocatePageSize()));
@@ -68,7 +73,10 @@ std::unique_ptr<v8::base::BoundedPageAllocator> CreateBoundedAllocator(
 }  // namespace
 
 AccountingAllocator::AccountingAllocator()
-    : zone_backing_malloc_(
+    : segment_pool_max_size_(FLAG_zone_segment_pool
+                                 ? FLAG_zone_segment_pool_max_size_kb * KB
+                                 : 0),
+      zone_backing_malloc_(
           V8::GetCurrentPlatform()->GetZoneBackingAllocator()->GetMallocFn()),
       zone_backing_free_(
           V8::GetCurrentPlatform()->GetZoneBackingAllocator()->GetFreeFn()) {
@@ -81,18 +89,91 @@ AccountingAllocator::AccountingAllocator()
   }
 }
 
-AccountingAllocator::~AccountingAllocator() = default;
+AccountingAllocator::~AccountingAllocator() { TrimSegmentPool(); }
+
+// static
+int AccountingAllocator::SegmentPoolSizeClass(size_t bytes) {
+  if (bytes < kMinPooledSegmentSize) return -1;
+  for (int size_class = 0;
+       size_class < static_cast<int>(kSegmentPoolSizeClasses); ++size_class) {
+    if (bytes <= SegmentPoolClassSize(size_class)) return size_class;
+  }
+  return -1;
+}
+
+// static
+size_t AccountingAllocator::SegmentPoolClassSize(int size_class) {
+  DCHECK_LE(0, size_class);
+  DCHECK_LT(size_class, static_cast<int>(kSegmentPoolSizeClasses));
+  return kMinPooledSegmentSize << size_class;
+}
+
+Segment* AccountingAllocator::TryTakeFromPool(int size_class) {
+  base::MutexGuard guard(&segment_pool_mutex_);
+  Segment* segment = segment_pool_[size_class];
+  if (segment == nullptr) return nullptr;
+  segment_pool_[size_class] = segment->next();
+  pooled_memory_usage_.fetch_sub(SegmentPoolClassSize(size_class),
+                                 std::memory_order_relaxed);
+  return segment;
+}
+
+bool AccountingAllocator::TryAddToPool(Segment* segment, int size_class) {
+  size_t segment_size = SegmentPoolClassSize(size_class);
+  base::MutexGuard guard(&segment_pool_mutex_);
+  size_t pooled = pooled_memory_usage_.load(std::memory_order_relaxed);
+  if (pooled + segment_size > segment_pool_max_size_) return false;
+  // The header was zapped already; only the link to the next pooled segment
+  // is meaningful from here on.
+  segment->set_next(segment_pool_[size_class]);
+  segment_pool_[size_class] = segment;
+  pooled_memory_usage_.store(pooled + segment_size, std::memory_order_relaxed);
+  return true;
+}
+
+void AccountingAllocator::TrimSegmentPool() {
+  Segment* lists[kSegmentPoolSizeClasses];
+  {
+    base::MutexGuard guard(&segment_pool_mutex_);
+    for (size_t i = 0; i < kSegmentPoolSizeClasses; ++i) {
+      lists[i] = segment_pool_[i];
+      segment_pool_[i] = nullptr;
+    }
+    pooled_memory_usage_.store(0, std::memory_order_relaxed);
+  }
+  // Free outside of the lock to not block concurrent zone allocations.
+  for (Segment* segment : lists) {
+    while (segment != nullptr) {
+      Segment* next = segment->next();
+      zone_backing_free_(segment);
+      segment = next;
+    }
+  }
+}
 
 Segment* AccountingAllocator::AllocateSegment(size_t bytes,
                                               bool supports_compression) {
-  void* memory;
+  void* memory = nullptr;
   if (COMPRESS_ZONES_BOOL && supports_compression) {
     bytes = RoundUp(bytes, kZonePageSize);
     memory = AllocatePages(bounded_page_allocator_.get(), nullptr, bytes,
                            kZonePageSize, PageAllocator::kReadWrite);
 
   } else {
-    memory = AllocWithRetry(bytes, zone_backing_malloc_);
+    int size_class =
+        segment_pool_max_size_ > 0 ? SegmentPoolSizeClass(bytes) : -1;
+    if (size_class >= 0) {
+      // Round up to the size class so that the segment can be pooled once it
+      // is returned.
+      bytes = SegmentPoolClassSize(size_class);
+      memory = TryTakeFromPool(size_class);
+      if (memory != nullptr) {
+        segment_pool_hits_.fetch_add(1, std::memory_order_relaxed);
+      } else {
+        segment_pool_misses_.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+    if (memory == nullptr) memory = AllocWithRetry(bytes, zone_backing_malloc_);
   }
   if (memory == nullptr) return nullptr;
 
@@ -115,9 +196,17 @@ void AccountingAllocator::ReturnSegment(Segment* segment,
   segment->ZapHeader();
   if (COMPRESS_ZONES_BOOL && supports_compression) {
     FreePages(bounded_page_allocator_.get(), segment, segment_size);
-  } else {
-    zone_backing_free_(segment);
+    return;
+  }
+  // Only segments that were allocated with the exact size of a size class
+  // are pooled, so that a pooled segment can serve any request of its class.
+  int size_class =
+      segment_pool_max_size_ > 0 ? SegmentPoolSizeClass(segment_size) : -1;
+  if (size_class >= 0 && SegmentPoolClassSize(size_class) == segment_size &&
+      TryAddToPool(segment, size_class)) {
+    return;
   }
+  zone_backing_free_(segment);
 }
 
 }  // namespace internal
@@ -10,6 +10,7 @@
 
 #include "include/v8-platform.h"
 #include "src/base/macros.h"
+#include "src/base/platform/mutex.h"
 #include "src/logging/tracing-flags.h"
 
 namespace v8 {
@@ -46,6 +47,25 @@ class V8_EXPORT_PRIVATE AccountingAllocator {
     return max_memory_usage_.load(std::memory_order_relaxed);
   }
 
+  // Returns the number of bytes held by segments in the pool. These are not
+  // included in {GetCurrentMemoryUsage}.
+  size_t GetPooledMemoryUsage() const {
+    return pooled_memory_usage_.load(std::memory_order_relaxed);
+  }
+
+  // The number of segment allocations that were served from the pool and the
+  // number that had to go to the system allocator.
+  size_t segment_pool_hits() const {
+    return segment_pool_hits_.load(std::memory_order_relaxed);
+  }
+  size_t segment_pool_misses() const {
+    return segment_pool_misses_.load(std::memory_order_relaxed);
+  }
+
+  // Releases all pooled segments to the system allocator, e.g. on memory
+  // pressure. Safe to call from any thread.
+  void TrimSegmentPool();
+
   void TraceZoneCreation(const Zone* zone) {
     if (V8_LIKELY(!TracingFlags::is_zone_stats_enabled())) return;
     TraceZoneCreationImpl(zone);
@@ -67,9 +87,33 @@ class V8_EXPORT_PRIVATE AccountingAllocator {
   virtual void TraceAllocateSegmentImpl(Segment* segment) {}
 
  private:
+  // Segments are pooled per size class: the zone's minimum segment size and
+  // its power-of-two multiples up to the maximum segment size. Larger
+  // segments and compressed zone pages are never pooled.
+  static constexpr size_t kSegmentPoolSizeClasses = 3;
+
+  // Returns the size class for a segment of {bytes}, or -1 if such segments
+  // are not pooled.
+  static int SegmentPoolSizeClass(size_t bytes);
+  static size_t SegmentPoolClassSize(int size_class);
+
+  Segment* TryTakeFromPool(int size_class);
+  bool TryAddToPool(Segment* segment, int size_class);
+
   std::atomic<size_t> current_memory_usage_{0};
   std::atomic<size_t> max_memory_usage_{0};
 
+  // Freed segments are kept in singly-linked free lists and reused by later
+  // zones instead of going through malloc and free again. The pool is shared
+  // by all threads using this allocator, since zones are routinely created on
+  // a background thread and destroyed on the main thread.
+  base::Mutex segment_pool_mutex_;
+  Segment* segment_pool_[kSegmentPoolSizeClasses] = {};
+  const size_t segment_pool_max_size_;
+  std::atomic<size_t> pooled_memory_usage_{0};
+  std::atomic<size_t> segment_pool_hits_{0};
+  std::atomic<size_t> segment_pool_misses_{0};
+
   std::unique_ptr<VirtualMemory> reserved_area_;
   std::unique_ptr<base::BoundedPageAllocator> bounded_page_allocator_;
 
@@ -37,6 +37,7 @@
 #include "src/codegen/compiler.h"
 #include "src/codegen/macro-assembler-inl.h"
 #include "src/codegen/script-details.h"
+#include "src/codegen/shared-compilation-cache.h"
 #include "src/common/assert-scope.h"
 #include "src/debug/debug.h"
 #include "src/heap/heap-inl.h"
@@ -2663,6 +2664,100 @@ TEST(CodeSerializerIsolatesEager) {
   isolate2->Dispose();
 }
 
+TEST(SharedCompilationCacheIsolates) {
+  bool prev_shared_compilation_cache = FLAG_shared_compilation_cache;
+  FLAG_shared_compilation_cache = true;
+  SharedCompilationCache* shared_cache = SharedCompilationCache::Get();
+  shared_cache->Clear();
+  const char* js_source = "function f() { return 'abc'; }; f() + 'def'";
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  for (int i = 0; i < 2; ++i) {
+    v8::Isolate* isolate = v8::Isolate::New(create_params);
+    {
+      v8::Isolate::Scope iscope(isolate);
+      v8::HandleScope scope(isolate);
+      v8::Local<v8::Context> context = v8::Context::New(isolate);
+      v8::Context::Scope context_scope(context);
+
+      v8::Local<v8::String> source_str = v8_str(js_source);
+      v8::ScriptOrigin origin(isolate, v8_str("test"));
+      v8::ScriptCompiler::Source source(source_str, origin);
+      v8::Local<v8::UnboundScript> script;
+      {
+        // The second isolate deserializes the script compiled by the first.
+        base::Optional<DisallowCompilation> no_compile;
+        if (i > 0) no_compile.emplace(reinterpret_cast<Isolate*>(isolate));
+        script = v8::ScriptCompiler::CompileUnboundScript(isolate, &source)
+                     .ToLocalChecked();
+      }
+      // The script is serialized by a task.
+      EmptyMessageQueues(isolate);
+      CHECK_EQ(1u, shared_cache->entry_count());
+      v8::Local<v8::Value> result =
+          script->BindToCurrentContext()->Run(context).ToLocalChecked();
+      CHECK(result->ToString(context)
+                .ToLocalChecked()
+                ->Equals(context, v8_str("abcdef"))
+                .FromJust());
+    }
+    isolate->Dispose();
+  }
+  shared_cache->Clear();
+
+  // Restore the flags.
+  FLAG_shared_compilation_cache = prev_shared_compilation_cache;
+}
+
+TEST(SharedCompilationCacheEviction) {
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  HandleScope scope(isolate);
+  const char* sources[] = {"var a = 1;", "var b = 2;", "var c = 3;"};
+
+  std::vector<Handle<String>> source_strings;
+  std::vector<Handle<SharedFunctionInfo>> toplevels;
+  for (const char* source : sources) {
+    source_strings.push_back(isolate->factory()
+                                 ->NewStringFromUtf8(base::CStrVector(source))
+                                 .ToHandleChecked());
+    toplevels.push_back(CompileScript(isolate, source_strings.back(),
+                                      ScriptDetails(), nullptr,
+                                      ScriptCompiler::kNoCompileOptions));
+  }
+
+  // The entries have about the same size. A budget for two and a half of
+  // them keeps the two most recently used ones.
+  SharedCompilationCache probe(1 * MB);
+  probe.Put(isolate, source_strings[0], ScriptDetails(), toplevels[0]);
+  EmptyMessageQueues(CcTest::isolate());
+  CHECK_EQ(1u, probe.entry_count());
+  size_t max_size = 2 * probe.size() + probe.size() / 2;
+
+  SharedCompilationCache cache(max_size);
+  for (size_t i = 0; i < toplevels.size(); ++i) {
+    cache.Put(isolate, source_strings[i], ScriptDetails(), toplevels[i]);
+  }
+  EmptyMessageQueues(CcTest::isolate());
+  CHECK_EQ(2u, cache.entry_count());
+  CHECK_LE(cache.size(), max_size);
+  CHECK(cache.Lookup(isolate, source_strings[0], ScriptDetails()).is_null());
+  CHECK(!cache.Lookup(isolate, source_strings[2], ScriptDetails()).is_null());
+
+  // Scripts with host-defined options are not cached, since the cached data
+  // does not include the options.
+  ScriptDetails with_options;
+  Handle<FixedArray> options = isolate->factory()->NewFixedArray(1);
+  options->set(0, Smi::FromInt(42));
+  with_options.host_defined_options = options;
+  SharedCompilationCache no_options_cache(1 * MB);
+  no_options_cache.Put(isolate, source_strings[0], with_options,
+                       toplevels[0]);
+  EmptyMessageQueues(CcTest::isolate());
+  CHECK_EQ(0u, no_options_cache.entry_count());
+}
+
 TEST(CodeSerializerAfterExecute) {
   // We test that no compilations happen when running this code. Forcing
   // to always optimize breaks this test.
@@ -1556,6 +1556,51 @@ STREAM_TEST(TierDownWithError) {
   tester.RunCompilerTasks();
 }
 
+// Lazily compiled functions are validated on background threads while the
+// module is streamed in.
+STREAM_TEST(TestLazyFunctionsAreValidated) {
+  FlagScope<bool> lazy_compilation(&i::FLAG_wasm_lazy_compilation, true);
+  FlagScope<bool> no_lazy_validation(&i::FLAG_wasm_lazy_validation, false);
+  for (bool valid : {true, false}) {
+    StreamTester tester(isolate);
+    Zone* zone = tester.zone();
+
+    ZoneBuffer buffer(zone);
+    {
+      TestSignatures sigs;
+      WasmModuleBuilder builder(zone);
+      for (int i = 0; i < 20; ++i) {
+        WasmFunctionBuilder* f = builder.AddFunction(sigs.i_v());
+        // Type error at i32.add in the last function.
+        if (!valid && i == 19) {
+          f->Emit(kExprI32Add);
+        } else {
+          f->EmitI32Const(i);
+        }
+        f->Emit(kExprEnd);
+      }
+      builder.WriteTo(&buffer);
+    }
+
+    // Deliver the module in small chunks, so that validation overlaps with
+    // streaming.
+    constexpr size_t kChunkSize = 7;
+    for (size_t offset = 0; offset < buffer.size(); offset += kChunkSize) {
+      tester.OnBytesReceived(buffer.begin() + offset,
+                             std::min(kChunkSize, buffer.size() - offset));
+      tester.RunCompilerTasks();
+    }
+    tester.FinishStream();
+    tester.RunCompilerTasks();
+
+    if (valid) {
+      CHECK(tester.IsPromiseFulfilled());
+    } else {
+      CHECK(tester.IsPromiseRejected());
+    }
+  }
+}
+
 STREAM_TEST(Regress1334651) {
   StreamTester tester(isolate);
 
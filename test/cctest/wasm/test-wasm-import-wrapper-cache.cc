@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "include/v8-function.h"
+#include "src/api/api-inl.h"
 #include "src/compiler/wasm-compiler.h"
 #include "src/wasm/function-compiler.h"
 #include "src/wasm/module-compiler.h"
@@ -11,7 +13,9 @@
 #include "src/wasm/wasm-module.h"
 
 #include "test/cctest/cctest.h"
+#include "test/cctest/wasm/wasm-run-utils.h"
 #include "test/common/wasm/test-signatures.h"
+#include "test/common/wasm/wasm-macro-gen.h"
 
 namespace v8 {
 namespace internal {
@@ -144,6 +148,103 @@ TEST(CacheHitMissSig) {
   CHECK_EQ(c2, c4);
 }
 
+TEST(CacheHitEqualSig) {
+  Isolate* isolate = CcTest::InitIsolateOnce();
+  auto module = NewModule(isolate);
+  TestSignatures sigs;
+  WasmCodeRefScope wasm_code_ref_scope;
+  WasmImportWrapperCache::ModificationScope cache_scope(
+      module->import_wrapper_cache());
+
+  auto kind = compiler::WasmImportCallKind::kJSFunctionArityMatch;
+  auto sig1 = sigs.i_i();
+  // A different signature object with the same types.
+  FunctionSig sig2(sig1->return_count(), sig1->parameter_count(),
+                   sig1->all().begin());
+  CHECK_NE(sig1, &sig2);
+  int expected_arity = static_cast<int>(sig1->parameter_count());
+
+  WasmCode* c1 =
+      CompileImportWrapper(module.get(), isolate->counters(), kind, sig1,
+                           expected_arity, kNoSuspend, &cache_scope);
+
+  CHECK_NOT_NULL(c1);
+
+  WasmCode* c2 = cache_scope[{kind, &sig2, expected_arity, kNoSuspend}];
+
+  CHECK_EQ(c1, c2);
+}
+
+TEST(SharedCacheHit) {
+  Isolate* isolate = CcTest::InitIsolateOnce();
+  auto module1 = NewModule(isolate);
+  auto module2 = NewModule(isolate);
+  TestSignatures sigs;
+  WasmCodeRefScope wasm_code_ref_scope;
+  SharedImportWrapperCache* shared_cache =
+      GetWasmEngine()->shared_import_wrapper_cache();
+
+  auto kind = compiler::WasmImportCallKind::kJSFunctionArityMismatch;
+  auto sig = sigs.l_ll();
+  int expected_arity = 1;
+
+  WasmCode* c1;
+  {
+    WasmImportWrapperCache::ModificationScope cache_scope(
+        module1->import_wrapper_cache());
+    c1 = CompileImportWrapper(module1.get(), isolate->counters(), kind, sig,
+                              expected_arity, kNoSuspend, &cache_scope);
+  }
+  size_t shared_cache_size = shared_cache->size();
+  size_t shared_cache_hits = shared_cache->num_hits();
+
+  WasmCode* c2;
+  {
+    WasmImportWrapperCache::ModificationScope cache_scope(
+        module2->import_wrapper_cache());
+    c2 = CompileImportWrapper(module2.get(), isolate->counters(), kind, sig,
+                              expected_arity, kNoSuspend, &cache_scope);
+  }
+
+  // The second module got a copy of the wrapper of the first module.
+  CHECK_EQ(shared_cache_size, shared_cache->size());
+  CHECK_EQ(shared_cache_hits + 1, shared_cache->num_hits());
+  CHECK_NE(c1, c2);
+  CHECK_EQ(module1.get(), c1->native_module());
+  CHECK_EQ(module2.get(), c2->native_module());
+  CHECK_EQ(WasmCode::Kind::kWasmToJsWrapper, c2->kind());
+  CHECK_EQ(c1->instructions().size(), c2->instructions().size());
+}
+
+TEST(SharedCacheHitCallThroughCopy) {
+  Isolate* isolate = CcTest::InitIsolateOnce();
+  HandleScope scope(isolate);
+  TestSignatures sigs;
+  SharedImportWrapperCache* shared_cache =
+      GetWasmEngine()->shared_import_wrapper_cache();
+  const char* source = "(function(a, b) { return a - b; })";
+  Handle<JSFunction> js_function =
+      Handle<JSFunction>::cast(v8::Utils::OpenHandle(
+          *v8::Local<v8::Function>::Cast(CompileRun(source))));
+  ManuallyImportedJSFunction import = {sigs.i_ii(), js_function};
+
+  // Both modules call the imported function through their own wrapper.
+  WasmRunner<int32_t, int32_t, int32_t> r1(TestExecutionTier::kTurbofan,
+                                           &import);
+  BUILD(r1, WASM_CALL_FUNCTION(0, WASM_LOCAL_GET(0), WASM_LOCAL_GET(1)));
+  size_t shared_cache_hits = shared_cache->num_hits();
+
+  // The second module gets a copy of the wrapper from the shared cache.
+  WasmRunner<int32_t, int32_t, int32_t> r2(TestExecutionTier::kTurbofan,
+                                           &import);
+  BUILD(r2, WASM_CALL_FUNCTION(0, WASM_LOCAL_GET(1), WASM_LOCAL_GET(0)));
+  CHECK_EQ(shared_cache_hits + 1, shared_cache->num_hits());
+
+  CHECK_EQ(7, r1.Call(10, 3));
+  CHECK_EQ(-7, r2.Call(10, 3));
+  CHECK_EQ(42, r2.Call(-2, 40));
+}
+
 }  // namespace test_wasm_import_wrapper_cache
 }  // namespace wasm
 }  // namespace internal
@@ -5,12 +5,18 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if V8_OS_POSIX
+#include <dirent.h>
+#include <unistd.h>
+#endif  // V8_OS_POSIX
+
 #include "include/v8-wasm.h"
 #include "src/api/api-inl.h"
 #include "src/objects/objects-inl.h"
 #include "src/snapshot/code-serializer.h"
 #include "src/utils/version.h"
 #include "src/wasm/module-decoder.h"
+#include "src/wasm/wasm-disk-cache.h"
 #include "src/wasm/wasm-engine.h"
 #include "src/wasm/wasm-module-builder.h"
 #include "src/wasm/wasm-module.h"
@@ -334,6 +340,54 @@ TEST(TierDownAfterDeserialization) {
   CHECK_EQ(ExecutionTier::kLiftoff, liftoff_code->tier());
 }
 
+TEST(DeserializeLazily) {
+  FlagScope<bool> lazy_deserialization(&FLAG_wasm_lazy_deserialization, true);
+  WasmSerializationTest test;
+  {
+    HandleScope scope(CcTest::i_isolate());
+    Handle<WasmModuleObject> module_object;
+    CHECK(test.Deserialize().ToHandle(&module_object));
+    NativeModule* native_module = module_object->native_module();
+    LazilyDeserializedCode* lazily_deserialized_code =
+        native_module->lazily_deserialized_code();
+    CHECK_NOT_NULL(lazily_deserialized_code);
+    CHECK(lazily_deserialized_code->HasFunction(0));
+    CHECK_EQ(size_t{1}, lazily_deserialized_code->remaining_functions());
+    {
+      WasmCodeRefScope code_ref_scope;
+      CHECK_NULL(native_module->GetCode(0));
+    }
+
+    // The first call copies the TurboFan code into the code space.
+    test.DeserializeAndRun();
+    CHECK_EQ(size_t{0}, lazily_deserialized_code->remaining_functions());
+    WasmCodeRefScope code_ref_scope;
+    WasmCode* code = native_module->GetCode(0);
+    CHECK_NOT_NULL(code);
+    CHECK_EQ(ExecutionTier::kTurbofan, code->tier());
+  }
+  test.CollectGarbage();
+}
+
+TEST(SerializeAfterLazyDeserialization) {
+  FlagScope<bool> lazy_deserialization(&FLAG_wasm_lazy_deserialization, true);
+  WasmSerializationTest test;
+  {
+    HandleScope scope(CcTest::i_isolate());
+    Handle<WasmModuleObject> module_object;
+    CHECK(test.Deserialize().ToHandle(&module_object));
+    NativeModule* native_module = module_object->native_module();
+    // Serialization has to deserialize all remaining functions first.
+    WasmSerializer wasm_serializer(native_module);
+    CHECK_EQ(size_t{0},
+             native_module->lazily_deserialized_code()->remaining_functions());
+    size_t buffer_size = wasm_serializer.GetSerializedNativeModuleSize();
+    std::unique_ptr<uint8_t[]> buffer(new uint8_t[buffer_size]);
+    CHECK(wasm_serializer.SerializeNativeModule({buffer.get(), buffer_size}));
+  }
+  test.CollectGarbage();
+}
+
 TEST(SerializeLiftoffModuleFails) {
   // Make sure that no function is tiered up to TurboFan.
   if (!FLAG_liftoff) return;
@@ -364,4 +418,55 @@ TEST(SerializeLiftoffModuleFails) {
   CHECK(!wasm_serializer.SerializeNativeModule({buffer.get(), buffer_size}));
 }
 
+#if V8_OS_POSIX
+TEST(DiskCacheStoresModuleBelowCachingThreshold) {
+  // With dynamic tiering and without Liftoff, all code is top tier code from
+  // the start, but no chunk of --wasm-caching-threshold bytes is finished.
+  FlagScope<bool> no_liftoff(&FLAG_liftoff, false);
+  FlagScope<bool> dynamic_tiering(&FLAG_wasm_dynamic_tiering, true);
+  v8::internal::AccountingAllocator allocator;
+  Zone zone(&allocator, "test_zone");
+
+  std::string pattern = "/tmp/wasm-disk-cache-XXXXXX";
+  std::vector<char> directory(pattern.begin(), pattern.end());
+  directory.push_back('\0');
+  CHECK_NOT_NULL(mkdtemp(directory.data()));
+  auto cache = std::make_shared<WasmDiskCache>(directory.data(), MB);
+
+  CcTest::InitIsolateOnce();
+  Isolate* isolate = CcTest::i_isolate();
+  HandleScope scope(isolate);
+  ZoneBuffer wire_bytes_buffer(&zone);
+  WasmSerializationTest::BuildWireBytes(&zone, &wire_bytes_buffer);
+  base::Vector<const uint8_t> wire_bytes{
+      wire_bytes_buffer.begin(), wire_bytes_buffer.size()};
+
+  ErrorThrower thrower(isolate, "Test");
+  WasmFeatures enabled_features = WasmFeatures::FromIsolate(isolate);
+  Handle<WasmModuleObject> module_object =
+      GetWasmEngine()
+          ->SyncCompile(isolate, enabled_features, &thrower,
+                        ModuleWireBytes(wire_bytes))
+          .ToHandleChecked();
+  // Baseline compilation finished already, so the module is stored right
+  // away, in the background.
+  cache->Observe(module_object->shared_native_module());
+  while (cache->entry_count() == 0) {
+    base::OS::Sleep(base::TimeDelta::FromMilliseconds(1));
+  }
+  CHECK(!cache->Lookup(isolate, enabled_features, wire_bytes).is_null());
+
+  cache.reset();
+  DIR* dir = opendir(directory.data());
+  CHECK_NOT_NULL(dir);
+  while (dirent* entry = readdir(dir)) {
+    std::string name = entry->d_name;
+    if (name == "." || name == "..") continue;
+    base::OS::Remove((std::string(directory.data()) + "/" + name).c_str());
+  }
+  closedir(dir);
+  rmdir(directory.data());
+}
+#endif  // V8_OS_POSIX
+
 }  // namespace v8::internal::wasm
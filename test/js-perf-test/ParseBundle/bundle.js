@@ -0,0 +1,231 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// A bundle in the style of the output of common JavaScript bundlers: a table
+// of module factories, mostly ASCII, which are never run.
+
+var __bundle_modules = {
+  './src/util/strings.js': function(module, exports, __require) {
+    'use strict';
+    function padStart(string, length, fill) {
+      string = String(string);
+      if (fill === undefined) fill = ' ';
+      while (string.length < length) string = fill + string;
+      return string;
+    }
+    function escapeHtml(text) {
+      return String(text)
+          .replace(/&/g, '&amp;')
+          .replace(/</g, '&lt;')
+          .replace(/>/g, '&gt;')
+          .replace(/"/g, '&quot;')
+          .replace(/'/g, '&#39;');
+    }
+    function camelCase(name) {
+      return name.replace(/[-_]+([a-z])/g, function(_, c) {
+        return c.toUpperCase();
+      });
+    }
+    exports.padStart = padStart;
+    exports.escapeHtml = escapeHtml;
+    exports.camelCase = camelCase;
+  },
+
+  './src/util/collections.js': function(module, exports, __require) {
+    'use strict';
+    class LruCache {
+      constructor(capacity) {
+        this.capacity = capacity;
+        this.map = new Map();
+      }
+      get(key) {
+        if (!this.map.has(key)) return undefined;
+        const value = this.map.get(key);
+        this.map.delete(key);
+        this.map.set(key, value);
+        return value;
+      }
+      set(key, value) {
+        this.map.delete(key);
+        this.map.set(key, value);
+        if (this.map.size > this.capacity) {
+          this.map.delete(this.map.keys().next().value);
+        }
+      }
+    }
+    function groupBy(items, keyFn) {
+      const groups = Object.create(null);
+      for (const item of items) {
+        const key = keyFn(item);
+        (groups[key] || (groups[key] = [])).push(item);
+      }
+      return groups;
+    }
+    function chunk(items, size) {
+      const result = [];
+      for (let i = 0; i < items.length; i += size) {
+        result.push(items.slice(i, i + size));
+      }
+      return result;
+    }
+    exports.LruCache = LruCache;
+    exports.groupBy = groupBy;
+    exports.chunk = chunk;
+  },
+
+  './src/i18n/messages.js': function(module, exports, __require) {
+    'use strict';
+    // Occasional non-ASCII characters, as in most real-world bundles.
+    const messages = {
+      en: {greeting: 'Hello', farewell: 'Goodbye', price: 'Price: $'},
+      de: {greeting: 'Grüß Gott', farewell: 'Tschüss', price: 'Preis: €'},
+      fr: {greeting: 'Bonjour', farewell: 'Au revoir', price: 'Prix : €'},
+    };
+    function format(locale, key, args) {
+      const table = messages[locale] || messages.en;
+      let message = table[key] || key;
+      if (args) {
+        for (const name of Object.keys(args)) {
+          message = message.split('{' + name + '}').join(String(args[name]));
+        }
+      }
+      return message;
+    }
+    exports.format = format;
+  },
+
+  './src/events/emitter.js': function(module, exports, __require) {
+    'use strict';
+    class Emitter {
+      constructor() {
+        this.listeners = new Map();
+      }
+      on(type, listener) {
+        let list = this.listeners.get(type);
+        if (!list) this.listeners.set(type, list = []);
+        list.push(listener);
+        return () => this.off(type, listener);
+      }
+      off(type, listener) {
+        const list = this.listeners.get(type);
+        if (!list) return;
+        const index = list.indexOf(listener);
+        if (index >= 0) list.splice(index, 1);
+      }
+      emit(type, ...args) {
+        const list = this.listeners.get(type);
+        if (!list) return false;
+        for (const listener of list.slice()) listener.apply(this, args);
+        return true;
+      }
+    }
+    exports.Emitter = Emitter;
+  },
+
+  './src/net/request.js': function(module, exports, __require) {
+    'use strict';
+    const {Emitter} = __require('./src/events/emitter.js');
+    const {LruCache} = __require('./src/util/collections.js');
+    const cache = new LruCache(64);
+    class Request extends Emitter {
+      constructor(url, options = {}) {
+        super();
+        this.url = url;
+        this.method = options.method || 'GET';
+        this.headers = Object.assign({}, options.headers);
+        this.retries = options.retries !== undefined ? options.retries : 3;
+      }
+      async send(body) {
+        const cached = this.method === 'GET' && cache.get(this.url);
+        if (cached) return cached;
+        let lastError;
+        for (let attempt = 0; attempt <= this.retries; attempt++) {
+          try {
+            const response = await this.transport(body);
+            if (this.method === 'GET') cache.set(this.url, response);
+            this.emit('load', response);
+            return response;
+          } catch (e) {
+            lastError = e;
+            this.emit('retry', attempt, e);
+          }
+        }
+        this.emit('error', lastError);
+        throw lastError;
+      }
+      transport(body) {
+        return Promise.reject(new Error('No transport for ' + this.url));
+      }
+    }
+    exports.Request = Request;
+  },
+
+  './src/ui/render.js': function(module, exports, __require) {
+    'use strict';
+    const {escapeHtml, camelCase} = __require('./src/util/strings.js');
+    function attributes(props) {
+      return Object.keys(props)
+          .filter((name) => props[name] !== false && props[name] != null)
+          .map((name) => {
+            const value = props[name] === true ? '' : props[name];
+            return ' ' + name + '="' + escapeHtml(value) + '"';
+          })
+          .join('');
+    }
+    function h(tag, props, ...children) {
+      return {tag, props: props || {}, children: children.flat()};
+    }
+    function renderToString(node) {
+      if (node == null || node === false) return '';
+      if (typeof node !== 'object') return escapeHtml(node);
+      const open = '<' + node.tag + attributes(node.props) + '>';
+      const inner = node.children.map(renderToString).join('');
+      return open + inner + '</' + node.tag + '>';
+    }
+    function styleObject(css) {
+      const style = {};
+      for (const declaration of css.split(';')) {
+        const [name, value] = declaration.split(':');
+        if (value !== undefined) style[camelCase(name.trim())] = value.trim();
+      }
+      return style;
+    }
+    exports.h = h;
+    exports.renderToString = renderToString;
+    exports.styleObject = styleObject;
+  },
+
+  './src/app.js': function(module, exports, __require) {
+    'use strict';
+    const {h, renderToString} = __require('./src/ui/render.js');
+    const {format} = __require('./src/i18n/messages.js');
+    const {Request} = __require('./src/net/request.js');
+    const {groupBy, chunk} = __require('./src/util/collections.js');
+    function ProductList({products, locale}) {
+      const byCategory = groupBy(products, (p) => p.category);
+      return h('div', {class: 'products'},
+          Object.keys(byCategory).sort().map((category) =>
+              h('section', {'data-category': category},
+                  h('h2', null, category),
+                  chunk(byCategory[category], 3).map((row) =>
+                      h('div', {class: 'row'}, row.map((product) =>
+                          h('article', {id: 'product-' + product.id},
+                              h('h3', null, product.name),
+                              h('p', null, format(locale, 'price') +
+                                               product.price.toFixed(2)))))))));
+    }
+    async function main(locale) {
+      const request = new Request('/api/products?locale=' + locale);
+      const products = await request.send();
+      return renderToString(ProductList({products, locale}));
+    }
+    exports.main = main;
+  },
+};
+
+function __require(name) {
+  const module = {exports: {}};
+  __bundle_modules[name](module, module.exports, __require);
+  return module.exports;
+}
@@ -0,0 +1,36 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures parsing of a bundle streamed in as UTF-8, the way a browser loads
+// scripts. Run with --streaming-compile --no-compilation-cache.
+
+d8.file.execute('../base.js');
+
+new BenchmarkSuite('StreamAsciiBundle', [1000], [
+  new Benchmark('StreamAsciiBundle', false, true, 20, Run),
+]);
+
+function Run() {
+  // The bundle only defines functions, which are preparsed but not run.
+  d8.file.execute('bundle.js');
+}
+
+var success = true;
+
+function PrintResult(name, result) {
+  print(name + '-ParseBundle(Score): ' + result);
+}
+
+
+function PrintError(name, error) {
+  PrintResult(name, error);
+  success = false;
+}
+
+
+BenchmarkSuite.config.doWarmup = undefined;
+BenchmarkSuite.config.doDeterministic = undefined;
+
+BenchmarkSuite.RunSuites({ NotifyResult: PrintResult,
+                           NotifyError: PrintError });
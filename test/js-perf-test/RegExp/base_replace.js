@@ -43,11 +43,18 @@ function Replace4Setup() {
   str = createHaystack();
 }
 
+function Replace5Setup() {
+  re = /z/g;
+  str = createHaystack();
+}
+
 var benchmarks = [ [ StringReplace1, Replace1Setup],
                    [ StringReplace1, Replace2Setup],
                    [ StringReplace2, Replace1Setup],
                    [ StringReplace2, Replace2Setup],
                    [ StringReplace3, Replace3Setup],
+                   [ StringReplace2, Replace4Setup],
+                   [ StringReplace2, Replace5Setup],
                    [ StringReplace3, Replace4Setup],
                    [ FunctionReplace1, Replace3Setup],
                    [ FunctionReplace1, Replace4Setup],
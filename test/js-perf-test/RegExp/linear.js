@@ -0,0 +1,57 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+d8.file.execute("base.js");
+
+// Searches with the experimental linear-time engine, which runs a lazily
+// built DFA unless --no-experimental-regexp-engine-lazy-dfa is passed.
+
+var str;
+var re;
+
+function createLongHaystack() {
+  let s = "The quick brown fox jumps over the lazy dog. ";
+  for (let i = 0; i < 6; i++) s += s;
+  return s;
+}
+
+function Exec() {
+  re.exec(str);
+}
+
+function Test() {
+  re.test(str);
+}
+
+function Replace() {
+  str.replace(re, "");
+}
+
+function Linear1Setup() {
+  re = new RegExp("[xz]y", "l");
+  str = createLongHaystack();
+}
+
+function Linear2Setup() {
+  re = new RegExp("(?:a|b|c)+d", "l");
+  str = createLongHaystack();
+}
+
+function Linear3Setup() {
+  re = new RegExp("(\\w+) (\\w+)$", "l");
+  str = createLongHaystack();
+}
+
+function Linear4Setup() {
+  re = new RegExp("o[gx]", "gl");
+  str = createLongHaystack();
+}
+
+var benchmarks = [ [Exec, Linear1Setup],
+                   [Test, Linear2Setup],
+                   [Exec, Linear3Setup],
+                   [Replace, Linear4Setup],
+                 ];
+
+createBenchmarkSuite("Linear");
@@ -0,0 +1,80 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Patterns as used for grepping through server logs. Most lines don't match,
+// and the interesting part of a line is preceded by a fixed literal.
+
+function createLogLines() {
+  const levels = ["INFO", "INFO", "INFO", "DEBUG", "INFO", "WARN", "INFO"];
+  const paths = ["/", "/index.html", "/api/v1/items", "/static/app.js",
+                 "/api/v1/login", "/favicon.ico"];
+  const lines = [];
+  for (let i = 0; i < 200; i++) {
+    const time = "2022-06-" + (10 + i % 20) + "T12:" + (10 + i % 50) + ":" +
+                 (10 + i % 49) + "." + (100 + i) + "Z";
+    const level = i % 37 == 0 ? "ERROR" : levels[i % levels.length];
+    lines.push(time + " " + level + " [worker-" + (i % 8) + "] request " +
+               "method=GET path=" + paths[i % paths.length] + " user=user" +
+               (i % 13) + " status=" + (i % 23 == 0 ? 503 : 200) +
+               " duration=" + (i * 7 % 300) + "ms");
+    lines.push("10.0." + (i % 4) + "." + (i % 250) + " - - [10/Jun/2022:12:" +
+               (10 + i % 50) + ":00 +0000] \"GET " + paths[i % paths.length] +
+               " HTTP/1.1\" " + (i % 31 == 0 ? 502 : 200) + " " + (i * 113) +
+               " \"-\" \"Mozilla/5.0 (X11; Linux x86_64)\"");
+  }
+  return lines;
+}
+
+const logLines = createLogLines();
+const logText = logLines.join("\n");
+let logMatches;
+
+const errorUserRe = /ERROR.*user=(\w+)/;
+function ErrorUserPerLine() {
+  logMatches = 0;
+  for (const line of logLines) {
+    if (errorUserRe.exec(line) !== null) logMatches++;
+  }
+}
+
+const serverErrorRe = /" 5\d\d (\d+) "/;
+function ServerErrorPerLine() {
+  logMatches = 0;
+  for (const line of logLines) {
+    if (serverErrorRe.test(line)) logMatches++;
+  }
+}
+
+const slowRequestRe = /duration=(\d\d\d)ms$/;
+function SlowRequestPerLine() {
+  logMatches = 0;
+  for (const line of logLines) {
+    if (slowRequestRe.test(line)) logMatches++;
+  }
+}
+
+const warnTimeRe = /(\d{4}-\d\d-\d\d)T[\d:.]+Z WARN /g;
+function WarnTimestampsInText() {
+  logMatches = logText.match(warnTimeRe);
+}
+
+const loginRe = /path=\/api\/v1\/login user=(\w+) status=(\d+)/g;
+function LoginsInText() {
+  logMatches = [...logText.matchAll(loginRe)];
+}
+
+const unavailableRe = /\[worker-(\d)\][^\n]*status=503/g;
+function UnavailableReplaceInText() {
+  logMatches = logText.replace(unavailableRe, "[worker-$1] <unavailable>");
+}
+
+var benchmarks = [ [ErrorUserPerLine, () => {}],
+                   [ServerErrorPerLine, () => {}],
+                   [SlowRequestPerLine, () => {}],
+                   [WarnTimestampsInText, () => {}],
+                   [LoginsInText, () => {}],
+                   [UnavailableReplaceInText, () => {}],
+                 ];
+
+createBenchmarkSuite("LogPatterns");
@@ -10,6 +10,7 @@ d8.file.execute('exec.js');
 d8.file.execute('flags.js');
 d8.file.execute('inline_test.js')
 d8.file.execute('complex_case_test.js');
+d8.file.execute('log_patterns.js');
 d8.file.execute('case_test.js');
 d8.file.execute('match.js');
 d8.file.execute('replace.js');
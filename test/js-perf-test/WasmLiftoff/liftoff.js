@@ -0,0 +1,112 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures the speed of Liftoff code with hot loops, and the speed of Liftoff
+// compilation itself. Run with --liftoff-only.
+
+new BenchmarkSuite('LoopCode', [1000], [
+  new Benchmark('LoopCode', false, false, 0, RunLoop, SetUpLoop),
+]);
+
+new BenchmarkSuite('Compile', [1000], [
+  new Benchmark('Compile', false, false, 0, Compile),
+]);
+
+function uleb(value) {
+  const bytes = [];
+  do {
+    let b = value & 0x7f;
+    value >>>= 7;
+    if (value != 0) b |= 0x80;
+    bytes.push(b);
+  } while (value != 0);
+  return bytes;
+}
+
+function sleb(value) {
+  const bytes = [];
+  while (true) {
+    const b = value & 0x7f;
+    value >>= 7;
+    if ((value == 0 && (b & 0x40) == 0) || (value == -1 && (b & 0x40) != 0)) {
+      bytes.push(b);
+      return bytes;
+    }
+    bytes.push(b | 0x80);
+  }
+}
+
+function section(id, contents) {
+  return [id, ...uleb(contents.length), ...contents];
+}
+
+function vec(items) {
+  return [...uleb(items.length), ...[].concat(...items)];
+}
+
+// (func (param $n i32) (result i32) (local $acc i32) (local $i i32)
+//                                   (local $x i32) (local $y i32)
+// A loop with several live locals and a memory access per iteration.
+function LoopBody() {
+  const kN = 0, kAcc = 1, kI = 2, kX = 3, kY = 4;
+  const code = [
+    0x01, 0x04, 0x7f,                    // 4 locals of type i32
+    0x03, 0x40,                          // loop
+    0x20, kI, 0x41, 2, 0x74,             //   i << 2
+    0x41, ...sleb(0xfffc), 0x71,         //   & 0xfffc
+    0x28, 2, 0,                          //   i32.load
+    0x21, kX,                            //   local.set $x
+    0x20, kX, 0x41, 3, 0x6c,             //   x * 3
+    0x20, kI, 0x6a, 0x21, kY,            //   y = ... + i
+    0x20, kAcc, 0x20, kY, 0x73,          //   acc ^ y
+    0x21, kAcc,                          //   local.set $acc
+    0x20, kI, 0x41, 1, 0x6a, 0x22, kI,   //   local.tee $i (i + 1)
+    0x20, kN, 0x49,                      //   i < n
+    0x0d, 0,                             //   br_if 0
+    0x0b,                                // end
+    0x20, kAcc,                          // local.get $acc
+    0x0b,                                // end
+  ];
+  return [...uleb(code.length), ...code];
+}
+
+function ModuleBytes(num_functions, name) {
+  const functions = [];
+  const bodies = [];
+  for (let i = 0; i < num_functions; ++i) {
+    functions.push([0]);
+    bodies.push(LoopBody());
+  }
+  const export_name = [...'main'].map(c => c.charCodeAt(0));
+  // Identical modules are cached; the custom section makes each one unique.
+  const custom = [...uleb(name.length), ...[...name].map(c => c.charCodeAt(0))];
+  return new Uint8Array([
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,  // header
+    ...section(1, vec([[0x60, 1, 0x7f, 1, 0x7f]])),  // (i32) -> i32
+    ...section(3, vec(functions)),
+    ...section(5, vec([[0, 1]])),                    // memory of one page
+    ...section(7, vec([[...uleb(export_name.length), ...export_name, 0, 0]])),
+    ...section(10, vec(bodies)),
+    ...section(0, custom),
+  ]);
+}
+
+let loop_function;
+let loop_result;
+
+function SetUpLoop() {
+  const instance =
+      new WebAssembly.Instance(new WebAssembly.Module(ModuleBytes(1, 'loop')));
+  loop_function = instance.exports.main;
+}
+
+function RunLoop() {
+  loop_result = loop_function(10000);
+}
+
+let compile_count = 0;
+
+function Compile() {
+  new WebAssembly.Module(ModuleBytes(100, 'compile' + compile_count++));
+}
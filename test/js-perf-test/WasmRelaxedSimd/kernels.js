@@ -0,0 +1,131 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures relaxed SIMD kernels: an int8 dot product as used by quantized ML
+// inference, and a fused multiply-add over float pixels as used by image
+// filters. Run with --experimental-wasm-relaxed-simd.
+
+new BenchmarkSuite('DotProduct', [1000], [
+  new Benchmark('DotProduct', false, false, 0, RunDot, SetUp),
+]);
+
+new BenchmarkSuite('MultiplyAdd', [1000], [
+  new Benchmark('MultiplyAdd', false, false, 0, RunMultiplyAdd, SetUp),
+]);
+
+// The int8 inputs of the dot product live in the first page, the float
+// pixels in the second one.
+const kPageSize = 65536;
+const kHalfPage = kPageSize / 2;
+
+function uleb(value) {
+  const bytes = [];
+  do {
+    let b = value & 0x7f;
+    value >>>= 7;
+    if (value != 0) b |= 0x80;
+    bytes.push(b);
+  } while (value != 0);
+  return bytes;
+}
+
+function section(id, contents) {
+  return [id, ...uleb(contents.length), ...contents];
+}
+
+function vec(items) {
+  return [...uleb(items.length), ...[].concat(...items)];
+}
+
+function name(string) {
+  return [...uleb(string.length), ...[...string].map(c => c.charCodeAt(0))];
+}
+
+function body(code) {
+  return [...uleb(code.length), ...code];
+}
+
+const kN = 0, kI = 1, kAcc = 2;
+const kLocals = [0x02, 0x01, 0x7f, 0x01, 0x7b];  // i32 $i, v128 $acc
+const kIncrementAndLoop = [
+  0x20, kI, 0x41, 16, 0x6a, 0x22, kI,            //   local.tee $i (i + 16)
+  0x20, kN, 0x49,                                //   i < n
+  0x0d, 0,                                       //   br_if 0
+  0x0b,                                          // end
+];
+
+// (func (param $n i32) (result i32)
+// Sums the products of the int8 lanes at [0, n) and the int7 lanes at
+// [32768, 32768 + n).
+const kDotBody = body([
+  ...kLocals,
+  0x03, 0x40,                                    // loop
+  0x20, kI, 0xfd, 0x00, 4, 0,                    //   v128.load
+  0x20, kI, 0xfd, 0x00, 4, ...uleb(kHalfPage),   //   v128.load
+  0x20, kAcc,
+  0xfd, 0x93, 0x02,                              // i32x4.dot_i8x16_i7x16_add_s
+  0x21, kAcc,                                    //   local.set $acc
+  ...kIncrementAndLoop,
+  0x20, kAcc, 0xfd, 0x1b, 0,                     // i32x4.extract_lane 0
+  0x20, kAcc, 0xfd, 0x1b, 1, 0x6a,
+  0x20, kAcc, 0xfd, 0x1b, 2, 0x6a,
+  0x20, kAcc, 0xfd, 0x1b, 3, 0x6a,
+  0x0b,                                          // end
+]);
+
+// (func (param $n i32) (result f32)
+// Accumulates half of each of the float pixels at [65536, 65536 + n).
+const kMultiplyAddBody = body([
+  ...kLocals,
+  0x03, 0x40,                                    // loop
+  0x20, kAcc,
+  0x20, kI, 0xfd, 0x00, 4, ...uleb(kPageSize),   //   v128.load
+  0x43, 0x00, 0x00, 0x00, 0x3f, 0xfd, 0x13,      //   f32x4.splat 0.5
+  0xfd, 0x85, 0x02,                              //   f32x4.qfma
+  0x21, kAcc,                                    //   local.set $acc
+  ...kIncrementAndLoop,
+  0x20, kAcc, 0xfd, 0x1f, 0,                     // f32x4.extract_lane 0
+  0x0b,                                          // end
+]);
+
+const kModuleBytes = new Uint8Array([
+  0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,  // header
+  ...section(1, vec([[0x60, 1, 0x7f, 1, 0x7f],       // (i32) -> i32
+                     [0x60, 1, 0x7f, 1, 0x7d]])),    // (i32) -> f32
+  ...section(3, vec([[0], [1]])),
+  ...section(5, vec([[0, 2]])),                      // memory of two pages
+  ...section(7, vec([[...name('dot'), 0, 0],
+                     [...name('madd'), 0, 1],
+                     [...name('memory'), 2, 0]])),
+  ...section(10, vec([kDotBody, kMultiplyAddBody])),
+]);
+
+let dot;
+let multiply_add;
+let result;
+
+function SetUp() {
+  const instance =
+      new WebAssembly.Instance(new WebAssembly.Module(kModuleBytes));
+  dot = instance.exports.dot;
+  multiply_add = instance.exports.madd;
+  const bytes = new Uint8Array(instance.exports.memory.buffer, 0, kPageSize);
+  for (let i = 0; i < kHalfPage; ++i) {
+    bytes[i] = (i * 37) & 0xff;
+    bytes[kHalfPage + i] = (i * 11) & 0x7f;
+  }
+  const pixels = new Float32Array(
+      instance.exports.memory.buffer, kPageSize, kPageSize / 4);
+  for (let i = 0; i < pixels.length; ++i) {
+    pixels[i] = (i & 0xff) / 255;
+  }
+}
+
+function RunDot() {
+  result = dot(kHalfPage);
+}
+
+function RunMultiplyAdd() {
+  result = multiply_add(kPageSize);
+}
@@ -0,0 +1,26 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo-huge-graph-node-limit=1
+// Flags: --trace-turbo-huge-graphs --no-concurrent-recompilation
+// Flags: --turbo-loop-peeling --turbo-escape --turbo-store-elimination
+// Flags: --turbo-splitting
+
+// With a node limit of 1, every graph is considered huge. Only the JS
+// function is traced; the builtins it calls were compiled ahead of time.
+
+function sumPoints(n) {
+  let sum = 0;
+  for (let i = 0; i < n; i++) {
+    const point = {x: i, y: 2 * i};
+    point.x = point.x + 1;
+    sum += point.x + point.y;
+  }
+  return sum;
+}
+
+%PrepareFunctionForOptimization(sumPoints);
+sumPoints(4);
+%OptimizeFunctionOnNextCall(sumPoints);
+print(sumPoints(4));
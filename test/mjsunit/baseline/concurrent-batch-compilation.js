@@ -0,0 +1,47 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --sparkplug --no-always-sparkplug --allow-natives-syntax
+// Flags: --baseline-batch-compilation --baseline-batch-compilation-threshold=200
+// Flags: --concurrent-sparkplug-functions-per-job=1
+// Flags: --concurrent-sparkplug-max-threads=0
+// Flags: --interrupt-budget-factor-for-feedback-allocation=4
+// Flags: --lazy-feedback-allocation --no-always-turbofan
+
+// Batches are split into one job per function and compiled by as many
+// workers as there are jobs. Code of finished jobs is installed while other
+// jobs of the same batch are still compiling.
+const kFunctions = 64;
+const functions = [];
+for (let i = 0; i < kFunctions; ++i) {
+  functions.push(new Function('a', 'b',
+      `return (a + b + ${i}) * 42 / a % b;`));
+  %NeverOptimizeFunction(functions[i]);
+}
+
+function expected(i, a, b) {
+  return (a + b + i) * 42 / a % b;
+}
+
+for (let round = 0; round < 20; ++round) {
+  for (let i = 0; i < kFunctions; ++i) {
+    assertEquals(expected(i, round + 1, 4711),
+                 functions[i](round + 1, 4711));
+  }
+}
+
+// The batch that the last functions were added to is compiled once another
+// function pushes it over the threshold.
+function flush(a, b) {
+  return (a + b + 11) * 42 / a % b;
+}
+%NeverOptimizeFunction(flush);
+for (let i = 0; i < 20; ++i) flush(i + 1, 4711);
+
+%WaitForBaselineBatchCompilation();
+for (let i = 0; i < kFunctions; ++i) {
+  // Call the function so that it picks up the installed code.
+  assertEquals(expected(i, 1, 4711), functions[i](1, 4711));
+  assertTrue(isBaseline(functions[i]), `function ${i}`);
+}
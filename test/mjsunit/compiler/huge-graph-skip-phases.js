@@ -0,0 +1,28 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo-huge-graph-node-limit=1
+
+// With a node limit of 1, every graph is considered huge and TurboFan skips
+// loop peeling, escape analysis, store-store elimination and node splitting.
+// test/message/turbofan-huge-graph-skip-phases.js checks which phases are
+// skipped.
+
+function sumPoints(n) {
+  let sum = 0;
+  for (let i = 0; i < n; i++) {
+    const point = {x: i, y: 2 * i};
+    point.x = point.x + 1;
+    sum += point.x + point.y;
+  }
+  return sum;
+}
+
+%PrepareFunctionForOptimization(sumPoints);
+assertEquals(22, sumPoints(4));
+assertEquals(22, sumPoints(4));
+%OptimizeFunctionOnNextCall(sumPoints);
+assertEquals(22, sumPoints(4));
+assertEquals(145, sumPoints(10));
+assertOptimized(sumPoints);
@@ -0,0 +1,47 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --no-sparkplug --no-turbofan
+
+// Test bytecodes handle a following JumpIfTrue or JumpIfFalse inline. Check
+// both outcomes of the jump, and loops whose budget interrupts are triggered
+// by the inlined jumps.
+
+function compare(a, b) {
+  let result = '';
+  if (a < b) result += 'lt';
+  if (a > b) result += 'gt';
+  if (a <= b) result += 'le';
+  if (a >= b) result += 'ge';
+  if (a == b) result += 'eq';
+  if (a === b) result += 'seq';
+  if (a == null) result += 'null';
+  if (a === undefined) result += 'undef';
+  if (typeof a === 'string') result += 'str';
+  if (a instanceof Object) result += 'obj';
+  if ('x' in Object(a)) result += 'in';
+  return result;
+}
+
+assertEquals('ltle', compare(1, 2));
+assertEquals('gtge', compare(2, 1));
+assertEquals('legeeqseq', compare(1, 1));
+assertEquals('legeeq', compare(1, '1'));
+assertEquals('nullundef', compare(undefined, 1));
+assertEquals('legeeqseqnull', compare(null, null));
+assertEquals('ltlestr', compare('a', 'b'));
+assertEquals('objin', compare({x: 1}, NaN));
+
+function countBelow(n, limit) {
+  let count = 0;
+  for (let i = 0; i < n; i++) {
+    if (i < limit) count++;
+    if (!(i >= limit)) count++;
+  }
+  return count;
+}
+
+for (let i = 0; i < 10; i++) {
+  assertEquals(2000, countBelow(100000, 1000));
+}
@@ -0,0 +1,43 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --parallel-compile-tasks-for-streaming --streaming-compile
+
+// A bundle-like script: its eager top-level functions are compiled by
+// parallel tasks while the rest of the script is parsed.
+var modules = {};
+
+(function(exports) {
+  var counter = 0;
+  exports.next = function() { return ++counter; };
+})(modules.counter = {});
+
+var result = (function(a, ...rest) {
+  return a + rest.length;
+})(1, 2, 3);
+assertEquals(3, result);
+
+function lazy_outer() {
+  return modules.counter.next();
+}
+
+var eager_outer = (function() { return lazy_outer() + 40; });
+
+(function() {
+  assertEquals(1, lazy_outer());
+  assertEquals(42, eager_outer());
+})();
+
+var gen = (function*() {
+  yield 1;
+  yield 2;
+})();
+assertEquals(1, gen.next().value);
+assertEquals(2, gen.next().value);
+
+// Not called, so compiled by the parallel task only.
+(function() {
+  class Foo {};
+  return new Foo();
+});
@@ -0,0 +1,80 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --enable-experimental-regexp-engine-on-excessive-backtracks
+
+// Global replacements with a string that doesn't refer to captures run code
+// that doesn't record them, and only find the captures of the last match for
+// the legacy RegExp statics.  A replacement function needs the captures of
+// every match, so it serves as the reference.
+
+function Statics() {
+  return [RegExp.lastMatch, RegExp.leftContext, RegExp.rightContext,
+          RegExp.$1, RegExp.$2, RegExp.$3, RegExp.$4];
+}
+
+function Check(source, flags, subject, replacement) {
+  const message = `/${source}/${flags} on ${JSON.stringify(subject)}`;
+  /(q)(q)(q)(q)/.exec("qqqq");
+  const expected =
+      subject.replace(new RegExp(source, flags), () => replacement);
+  const expected_statics = Statics();
+  /(q)(q)(q)(q)/.exec("qqqq");
+  assertEquals(expected,
+               subject.replace(new RegExp(source, flags), replacement),
+               message);
+  assertEquals(expected_statics, Statics(), message);
+}
+
+const kPatterns = [
+  "(\\d)+",
+  "(\\d)(\\d)?",
+  "(a)|(b)",
+  "(x)?",
+  "(?<=(a))(a)",
+  "(?=(b))b",
+  "((a)|b)+",
+  "(?:(a)|b)*?c",
+  "\\b(\\w)",
+  "(a*)*c",
+  "(?<x>a)(?!(b))",
+  // Back references need the captures.
+  "(a)\\1",
+  // Without capture groups the full code only records the match.
+  "\\d+",
+  "a|b",
+  "x?",
+  "a",
+];
+
+const kSubjects = [
+  "",
+  "a1b22c",
+  "aab,ab bbc",
+  "ab".repeat(300),
+  "ab".repeat(300) + "c",
+  "aa1".repeat(100),
+];
+
+for (const source of kPatterns) {
+  for (const flags of ["g", "gi", "gy", "gu"]) {
+    for (const subject of kSubjects) {
+      Check(source, flags, subject, "");
+      Check(source, flags, subject, "-");
+    }
+  }
+}
+
+// Zero-length matches advance by code points with /u.
+Check("(x)?", "gu", "\u{1F600}a\u{1F600}", "-");
+assertEquals("-\u{1F600}-a-", "\u{1F600}a".replace(/(x)?/gu, "-"));
+// Two-byte subjects.
+Check("ሴ(a)|(b)", "g", "ሴabሴa".repeat(50), "-");
+
+// Too much backtracking falls back to the experimental engine, which records
+// all captures.
+const subject = "x" + "a".repeat(25) + " x";
+assertEquals("y" + "a".repeat(25) + " y", subject.replace(/(a+)+b|(x)/g, "y"));
+assertEquals(["x", subject.slice(0, -1), "", "", "x"],
+             Statics().slice(0, 5));
@@ -0,0 +1,79 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --enable-experimental-regexp-engine
+// Flags: --experimental-regexp-engine-dfa-cache-kb=1
+
+// The experimental engine looks for matches with a lazily built DFA before it
+// computes the captures.  The DFA cache is tiny here, so it is flushed while
+// matching, and searches fall back to running the NFA.  The results must be
+// the same as those of the backtracking engine in either case.
+
+let seed = 17;
+function Random(n) {
+  seed = (seed * 16807) % 2147483647;
+  return seed % n;
+}
+
+function RandomString(alphabet, length) {
+  let result = "";
+  for (let i = 0; i < length; ++i) {
+    result += alphabet[Random(alphabet.length)];
+  }
+  return result;
+}
+
+function Describe(result) {
+  if (result === null) return null;
+  return [...result, result.index];
+}
+
+function Check(source, flags, subject) {
+  const linear = new RegExp(source, flags + "l");
+  assertEquals("EXPERIMENTAL", %RegexpTypeTag(linear));
+  const backtracking = new RegExp(source, flags);
+  const message = `/${source}/${flags} on ${JSON.stringify(subject)}`;
+  assertEquals(Describe(backtracking.exec(subject)),
+               Describe(linear.exec(subject)), message);
+  assertEquals(subject.replace(new RegExp(source, flags + "g"), "<$&>"),
+               subject.replace(new RegExp(source, flags + "gl"), "<$&>"),
+               message);
+}
+
+const kPatterns = [
+  "",
+  "$",
+  "x*",
+  "a|ab|abc",
+  "(?:ab|a)(c?)",
+  "(a+)+c",
+  "[^,]*,",
+  "\\bab\\w*",
+  "\\Bb+",
+  "^\\d+$",
+  "^a|c$",
+  "[\\s\\S]*?end",
+  "end.*?(\\d)",
+  // The DFA of this regexp has exponentially many states.
+  "(a|b)*a(a|b){8}",
+];
+
+for (const source of kPatterns) {
+  for (const flags of ["", "m", "s", "y"]) {
+    Check(source, flags, "");
+    Check(source, flags, "ab,abc end1\n22\nbbba,ca");
+    for (let i = 0; i < 10; ++i) {
+      Check(source, flags, RandomString("ab,c \n1end", 1 + Random(300)));
+    }
+  }
+}
+
+// A long subject without a match.  This would take quadratic time with the
+// backtracking engine.
+const long_subject = RandomString("ab", 100000) + "ab";
+assertNull(/(a|b)*a(a|b){8}x/l.exec(long_subject));
+assertEquals(["ab"], long_subject.match(/b{30}|ab$/l));
+// Two byte subjects.
+Check("aሴ+b", "", "xaሴሴbሴ");
+Check("[က- ]{3}", "g", RandomString("aሴ⍅", 1000));
@@ -0,0 +1,101 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --regexp-prefilter --regexp-tier-up --regexp-tier-up-ticks=3
+
+// Irregexp searches for a literal that every match contains before it runs
+// the regexp. Compare the results with those of the same regexp wrapped in a
+// disjunction, which has no such literal. Each regexp is run often enough to
+// cover both the interpreter and the generated code.
+
+function withoutPrefilter(re) {
+  return new RegExp("(?:" + re.source + ")|[^\\s\\S]", re.flags);
+}
+
+function assertSameExec(re, subject, lastIndex) {
+  const reference = withoutPrefilter(re);
+  for (let i = 0; i < 5; i++) {
+    re.lastIndex = lastIndex;
+    reference.lastIndex = lastIndex;
+    assertEquals(reference.exec(subject), re.exec(subject),
+                 `${re} on ${subject} at ${lastIndex}`);
+    assertEquals(reference.lastIndex, re.lastIndex);
+  }
+}
+
+function assertSameEverywhere(re, subject) {
+  for (let i = 0; i <= subject.length + 1; i++) {
+    assertSameExec(re, subject, i);
+  }
+  const reference = withoutPrefilter(re);
+  if (re.global) {
+    assertEquals(subject.match(reference), subject.match(re));
+    assertEquals(subject.replace(reference, "<$&>"),
+                 subject.replace(re, "<$&>"));
+  }
+}
+
+const lines = [
+  "2022-06-10T12:00:00Z INFO request user=alice status=200",
+  "2022-06-10T12:00:01Z ERROR request user=bob status=503",
+  "ERROR without a user",
+  "user=carol ERROR in the wrong order",
+  "",
+];
+const log = lines.join("\n");
+const twoByteLog = log + " \u2603 ERROR x user=\u00e9\u00e8 user=dave";
+
+// Literal prefix.
+for (const subject of [...lines, log, twoByteLog]) {
+  assertSameEverywhere(/ERROR.*user=(\w+)/, subject);
+  assertSameEverywhere(/ERROR.*user=(\w+)/g, subject);
+  assertSameEverywhere(/ERROR.*user=(\w+)/gm, subject);
+}
+
+// Literal at a fixed distance from the start of the match.
+for (const subject of [log, twoByteLog]) {
+  assertSameEverywhere(/\d\d:\d\dZ (ERROR|INFO)/g, subject);
+  assertSameEverywhere(/(\d{4})-\d\d-\d\dT/g, subject);
+  assertSameEverywhere(/.{3}user=/g, subject);
+  assertSameEverywhere(/\buser=\w/g, subject);
+  assertSameEverywhere(/(?<=\d)Z ERROR/g, subject);
+  assertSameEverywhere(/(?<!ERROR )request/g, subject);
+  assertSameEverywhere(/^\d+-06-10T12:00:01Z/gm, subject);
+}
+
+// Literal at a varying distance from the start of the match.
+for (const subject of [log, twoByteLog]) {
+  assertSameEverywhere(/\w+ (?:request|without) (us)er/g, subject);
+  assertSameEverywhere(/(?:a|bb)status=(\d+)$/gm, subject);
+  assertSameEverywhere(/(\w)+(?:\s+\w+)?status=/g, subject);
+  assertSameEverywhere(/(\w+)\1 user=/g, subject);
+}
+
+// Literals in quantifiers and groups.
+assertSameEverywhere(/(?:ab){2,3}c/g, "ababc abababc abc ababababc");
+assertSameEverywhere(/x(?:ab)+c/g, "xabc xababc xc xab");
+assertSameEverywhere(/((ab)c)d?/g, "abcd abc ab");
+assertSameEverywhere(/(?:ab)?cd/g, "abcd cd acd");
+
+// Unicode regexps, including subjects with surrogate pairs.
+const surrogates = "\u{1F600}ab\u{1F600}cd ab.cd \u{1F600}\u{1F600}abxcd";
+assertSameEverywhere(/ab.cd/gu, surrogates);
+assertSameEverywhere(/\u{1F600}ab/gu, surrogates);
+assertSameEverywhere(/[^a]ab/gu, surrogates);
+assertSameEverywhere(/.ab/g, surrogates);
+
+// Flags that disable the prefilter.
+assertSameEverywhere(/error.*user=/gi, log);
+assertSameEverywhere(/ERROR/y, log);
+assertSameEverywhere(/^ERROR/g, log);
+assertSameEverywhere(/status=503$/g, log);
+
+// Non-latin1 literals.
+assertSameEverywhere(/\u2603 ER+OR/g, twoByteLog);
+assertSameEverywhere(/\u00e9\u00e8 user/g, twoByteLog);
+
+// Runtime paths.
+assertEquals(["ERROR", "ERROR", "ERROR"], log.match(/ERROR(?= )/g));
+assertEquals(1, log.search(/0\d{2}-06/));
+assertEquals("bob", log.split(/ERROR.*user=(\w+)/)[1]);
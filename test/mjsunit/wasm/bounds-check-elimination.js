@@ -0,0 +1,148 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --no-liftoff --wasm-enforce-bounds-checks
+
+d8.file.execute('test/mjsunit/wasm/wasm-module-builder.js');
+
+// TurboFan omits bounds checks which are implied by an earlier check of the
+// same index. Test that all remaining out-of-bounds accesses still trap.
+
+(function testLargerOffsetAfterSmallerOffset() {
+  print(arguments.callee.name);
+  const builder = new WasmModuleBuilder();
+  builder.addMemory(1, 1, false);
+  builder.addFunction('main', kSig_i_i)
+      .addBody([
+        kExprLocalGet, 0, kExprI32LoadMem, 0, 0,
+        kExprLocalGet, 0, kExprI32LoadMem, 0, 4,
+        kExprI32Add
+      ])
+      .exportFunc();
+  const instance = builder.instantiate();
+  assertEquals(0, instance.exports.main(kPageSize - 8));
+  assertTraps(kTrapMemOutOfBounds, () => instance.exports.main(kPageSize - 4));
+})();
+
+(function testAccessAtEndOfMemory() {
+  print(arguments.callee.name);
+  const builder = new WasmModuleBuilder();
+  builder.addMemory(1, 1, false);
+  builder.addFunction('main', kSig_i_i)
+      .addBody([
+        kExprLocalGet, 0, kExprI32LoadMem, 0, 4,
+        kExprLocalGet, 0, kExprI32LoadMem, 0, 0,
+        kExprI32Add,
+        // The same index with a larger access size is not implied.
+        kExprLocalGet, 0, kExprI64LoadMem, 0, 1,
+        kExprI32ConvertI64,
+        kExprI32Add
+      ])
+      .exportFunc();
+  const instance = builder.instantiate();
+  assertEquals(0, instance.exports.main(kPageSize - 9));
+  assertTraps(kTrapMemOutOfBounds, () => instance.exports.main(kPageSize - 8));
+  assertTraps(kTrapMemOutOfBounds, () => instance.exports.main(-1));
+})();
+
+(function testCheckOnOnlyOneBranch() {
+  print(arguments.callee.name);
+  const builder = new WasmModuleBuilder();
+  builder.addMemory(1, 1, false);
+  builder.addFunction('main', kSig_i_ii)
+      .addBody([
+        kExprLocalGet, 1,
+        kExprIf, kWasmVoid,
+          kExprLocalGet, 0, kExprI32Const, 1, kExprI32StoreMem, 0, 0,
+        kExprEnd,
+        kExprLocalGet, 0, kExprI32LoadMem, 0, 0
+      ])
+      .exportFunc();
+  const instance = builder.instantiate();
+  assertEquals(1, instance.exports.main(kPageSize - 4, 1));
+  assertTraps(kTrapMemOutOfBounds, () => instance.exports.main(kPageSize, 0));
+})();
+
+(function testMemoryGrow() {
+  print(arguments.callee.name);
+  const builder = new WasmModuleBuilder();
+  builder.addMemory(1, 2, true);
+  // Accesses the same index before and after growing the memory by the given
+  // number of pages.
+  builder.addFunction('main', kSig_i_ii)
+      .addBody([
+        kExprLocalGet, 0, kExprI32LoadMem, 0, 0,
+        kExprLocalGet, 1, kExprMemoryGrow, kMemoryZero, kExprDrop,
+        kExprLocalGet, 0, kExprI32LoadMem, 0, 4,
+        kExprI32Add
+      ])
+      .exportFunc();
+  const instance = builder.instantiate();
+  assertTraps(kTrapMemOutOfBounds,
+              () => instance.exports.main(kPageSize - 4, 0));
+  assertEquals(0, instance.exports.main(kPageSize - 4, 1));
+  assertEquals(2 * kPageSize, instance.exports.memory.buffer.byteLength);
+})();
+
+(function testLoop() {
+  print(arguments.callee.name);
+  const builder = new WasmModuleBuilder();
+  builder.addMemory(1, 1, false);
+  // Stores to {index} and {index + 4} in a loop, where {index} advances by
+  // four bytes in each iteration.
+  builder.addFunction('main', kSig_i_ii)
+      .addBody([
+        kExprLoop, kWasmVoid,
+          kExprLocalGet, 0, kExprI32Const, 1, kExprI32StoreMem, 0, 0,
+          kExprLocalGet, 0, kExprI32Const, 2, kExprI32StoreMem, 0, 4,
+          kExprLocalGet, 0, kExprI32Const, 4, kExprI32Add, kExprLocalSet, 0,
+          kExprLocalGet, 1, kExprI32Const, 1, kExprI32Sub,
+          kExprLocalTee, 1,
+          kExprBrIf, 0,
+        kExprEnd,
+        kExprLocalGet, 0, kExprI32LoadMem, 0, 0
+      ])
+      .exportFunc();
+  const instance = builder.instantiate();
+  assertEquals(2, instance.exports.main(kPageSize - 16, 2));
+  assertTraps(kTrapMemOutOfBounds,
+              () => instance.exports.main(kPageSize - 16, 4));
+})();
+
+(function testLoopKeepsCheckInEveryIteration() {
+  print(arguments.callee.name);
+  const builder = new WasmModuleBuilder();
+  builder.addMemory(1, 1, false);
+  builder.exportMemoryAs('memory');
+  // Like above, but the loop runs until the second store traps. Both stores
+  // keep their checks in every iteration, since the index changes and checks
+  // are not hoisted out of the loop. All stores before the trap have to be
+  // visible.
+  builder.addFunction('main', kSig_v_ii)
+      .addBody([
+        kExprLoop, kWasmVoid,
+          kExprLocalGet, 0, kExprI32Const, 1, kExprI32StoreMem, 0, 0,
+          kExprLocalGet, 0, kExprI32Const, 2, kExprI32StoreMem, 0, 4,
+          kExprLocalGet, 0, kExprI32Const, 4, kExprI32Add, kExprLocalSet, 0,
+          kExprLocalGet, 1, kExprI32Const, 1, kExprI32Sub,
+          kExprLocalTee, 1,
+          kExprBrIf, 0,
+        kExprEnd
+      ])
+      .exportFunc();
+  const instance = builder.instantiate();
+  const memory = new Int32Array(instance.exports.memory.buffer);
+  const last = memory.length - 1;
+  assertTraps(kTrapMemOutOfBounds,
+              () => instance.exports.main(kPageSize - 12, 10));
+  // Each iteration's first store overwrites the previous iteration's second
+  // one, up to the last word of memory.
+  assertEquals([1, 1, 1], Array.from(memory.subarray(last - 2)));
+  // The check of the larger offset is not implied by the one of the smaller
+  // offset before it.
+  memory.fill(0);
+  assertTraps(kTrapMemOutOfBounds,
+              () => instance.exports.main(kPageSize - 4, 1));
+  assertEquals(1, memory[last]);
+})();
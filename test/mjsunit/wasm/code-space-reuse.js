@@ -0,0 +1,53 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --expose-gc --stress-wasm-code-gc
+// Flags: --wasm-reuse-freed-code-space
+
+d8.file.execute('test/mjsunit/wasm/wasm-module-builder.js');
+
+// Tiering down and up repeatedly frees the code of the previous tier. New code
+// is then allocated in the freed code space; test that this happens, and that
+// all functions keep computing the right results.
+
+const num_functions = 100;
+
+const builder = new WasmModuleBuilder();
+for (let i = 0; i < num_functions; ++i) {
+  // Make the functions big enough to fill several pages.
+  const body = [kExprLocalGet, 0];
+  for (let j = 0; j < 50; ++j) {
+    body.push(...wasmI32Const(i + j), kExprI32Add);
+  }
+  builder.addFunction('f' + i, kSig_i_i).addBody(body).exportFunc();
+}
+const instance = builder.instantiate();
+
+function checkResults() {
+  for (let i = 0; i < num_functions; ++i) {
+    // Sum of (i + j) for j in [0, 50), plus the parameter.
+    assertEquals(7 + 50 * i + 49 * 50 / 2, instance.exports['f' + i](7));
+  }
+}
+
+function allTieredUp() {
+  for (let i = 0; i < num_functions; ++i) {
+    if (%IsLiftoffFunction(instance.exports['f' + i])) return false;
+  }
+  return true;
+}
+
+for (let cycle = 0; cycle < 5; ++cycle) {
+  %WasmTierDown();
+  checkResults();
+  gc();
+  %WasmTierUp();
+  // Busy waiting until all functions are tiered up.
+  while (!allTieredUp()) {}
+  checkResults();
+  gc();
+}
+
+// Whole pages of freed code were made available for new code again.
+assertTrue(%WasmReclaimedCodeSize(instance) > 0);
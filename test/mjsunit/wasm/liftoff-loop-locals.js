@@ -0,0 +1,100 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --liftoff-only
+
+d8.file.execute('test/mjsunit/wasm/wasm-module-builder.js');
+
+// Liftoff keeps locals and the memory start in registers across loop headers.
+// Test that the back-edges restore them correctly.
+
+(function testAliasedLocals() {
+  print(arguments.callee.name);
+  const builder = new WasmModuleBuilder();
+  // Two locals holding the same value when entering the loop; only one of
+  // them changes in the loop.
+  builder.addFunction('main', kSig_i_ii)
+      .addLocals(kWasmI32, 1)
+      .addBody([
+        kExprLocalGet, 0, kExprLocalSet, 2,     // b = a
+        kExprLoop, kWasmVoid,
+          kExprLocalGet, 0, kExprI32Const, 1, kExprI32Add,
+          kExprLocalSet, 0,                     // a = a + 1
+          kExprLocalGet, 1, kExprI32Const, 1, kExprI32Sub,
+          kExprLocalTee, 1,                     // n = n - 1
+          kExprBrIf, 0,
+        kExprEnd,
+        kExprLocalGet, 0, kExprI32Const, ...wasmSignedLeb(1000), kExprI32Mul,
+        kExprLocalGet, 2, kExprI32Add
+      ])
+      .exportFunc();
+  const instance = builder.instantiate();
+  assertEquals(17 * 1000 + 7, instance.exports.main(7, 10));
+  assertEquals(4 * 1000 + 3, instance.exports.main(3, 1));
+})();
+
+(function testManyLocals() {
+  print(arguments.callee.name);
+  const builder = new WasmModuleBuilder();
+  // More live locals than registers; some of them get spilled at the loop
+  // header.
+  const kNumLocals = 20;
+  const body = [];
+  for (let i = 0; i < kNumLocals; ++i) {
+    body.push(kExprI32Const, i, kExprLocalSet, i + 1);
+  }
+  body.push(kExprLoop, kWasmVoid);
+  for (let i = 0; i < kNumLocals; ++i) {
+    body.push(kExprLocalGet, i + 1, kExprI32Const, 1, kExprI32Add,
+              kExprLocalSet, i + 1);
+  }
+  body.push(kExprLocalGet, 0, kExprI32Const, 1, kExprI32Sub,
+            kExprLocalTee, 0, kExprBrIf, 0, kExprEnd);
+  body.push(kExprI32Const, 0);
+  for (let i = 0; i < kNumLocals; ++i) {
+    body.push(kExprLocalGet, i + 1, kExprI32Add);
+  }
+  builder.addFunction('main', kSig_i_i)
+      .addLocals(kWasmI32, kNumLocals)
+      .addBody(body)
+      .exportFunc();
+  const instance = builder.instantiate();
+  const n = 5;
+  // Sum of (i + n) for i in [0, kNumLocals).
+  assertEquals(kNumLocals * (kNumLocals - 1) / 2 + kNumLocals * n,
+               instance.exports.main(n));
+})();
+
+(function testCallAndMemoryGrowInLoop() {
+  print(arguments.callee.name);
+  const builder = new WasmModuleBuilder();
+  builder.addMemory(1, 10, false);
+  const imp = builder.addImport('m', 'f', kSig_v_v);
+  // Each iteration calls out, grows the memory by a page, stores the
+  // iteration count at the start of the new page and loads it again.
+  builder.addFunction('main', kSig_i_i)
+      .addLocals(kWasmI32, 2)
+      .addBody([
+        kExprLoop, kWasmVoid,
+          kExprCallFunction, imp,
+          kExprI32Const, 1, kExprMemoryGrow, kMemoryZero,
+          kExprI32Const, ...wasmSignedLeb(kPageSize), kExprI32Mul,
+          kExprLocalTee, 2,                     // address of the new page
+          kExprLocalGet, 0,
+          kExprI32StoreMem, 0, 0,
+          kExprLocalGet, 1,
+          kExprLocalGet, 2, kExprI32LoadMem, 0, 0,
+          kExprI32Add, kExprLocalSet, 1,        // sum += load(address)
+          kExprLocalGet, 0, kExprI32Const, 1, kExprI32Sub,
+          kExprLocalTee, 0,
+          kExprBrIf, 0,
+        kExprEnd,
+        kExprLocalGet, 1
+      ])
+      .exportFunc();
+  let calls = 0;
+  const instance = builder.instantiate({m: {f: () => ++calls}});
+  assertEquals(5 + 4 + 3 + 2 + 1, instance.exports.main(5));
+  assertEquals(5, calls);
+})();
@@ -0,0 +1,49 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --wasm-dynamic-tiering --liftoff
+// Flags: --no-wasm-lazy-compilation --no-wasm-native-module-cache-enabled
+// Make the test faster:
+// Flags: --wasm-tiering-budget=1000
+
+// This test busy-waits for tier-up to be complete, hence it does not work in
+// predictable mode where we only have a single thread.
+// Flags: --no-predictable
+
+d8.file.execute('test/mjsunit/wasm/wasm-module-builder.js');
+
+const builder = new WasmModuleBuilder();
+builder.addFunction('f0', kSig_i_v).addBody(wasmI32Const(0)).exportFunc();
+builder.addFunction('f1', kSig_i_v).addBody(wasmI32Const(1)).exportFunc();
+const wire_bytes = builder.toBuffer();
+
+function firstRun() {
+  const module = new WebAssembly.Module(wire_bytes);
+  const instance = new WebAssembly.Instance(module);
+  // Without feedback, everything starts in Liftoff.
+  assertTrue(%IsLiftoffFunction(instance.exports.f1));
+  // Execute {f1} until it gets tiered up.
+  while (%IsLiftoffFunction(instance.exports.f1)) {
+    instance.exports.f1();
+  }
+  instance.exports.f0();
+  return %WasmSerializeTieringFeedback(module);
+}
+
+const feedback = firstRun();
+assertTrue(feedback.byteLength > 0);
+assertFalse(%WasmImportTieringFeedback(new ArrayBuffer(4)));
+assertTrue(%WasmImportTieringFeedback(feedback));
+
+(function secondRun() {
+  // The native module cache is disabled, so this compiles the module again.
+  const module = new WebAssembly.Module(wire_bytes);
+  const instance = new WebAssembly.Instance(module);
+  // {f1} gets compiled with TurboFan in the background without being called
+  // even once.
+  while (!%IsTurboFanFunction(instance.exports.f1)) {
+  }
+  assertTrue(%IsLiftoffFunction(instance.exports.f0));
+  assertEquals(1, instance.exports.f1());
+})();
@@ -10,6 +10,10 @@
 #include "include/v8-platform.h"
 #include "include/v8-primitive.h"
 #include "include/v8-script.h"
+#include "src/api/api-inl.h"
+#include "src/flags/flags.h"
+#include "src/objects/js-function-inl.h"
+#include "src/objects/shared-function-info-inl.h"
 #include "test/unittests/test-utils.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -238,4 +242,104 @@ TEST_F(DeserializeTest, OffThreadDeserializeRejectsDifferentSource) {
   }
 }
 
+class MergeThread : public base::Thread {
+ public:
+  explicit MergeThread(ScriptCompiler::ConsumeCodeCacheTask* task)
+      : Thread(base::Thread::Options("MergeThread")), task_(task) {}
+
+  void Run() override { task_->MergeWithExistingScript(); }
+
+ private:
+  ScriptCompiler::ConsumeCodeCacheTask* task_;
+};
+
+// Check that off-thread deserialization merges into a Script which is still
+// alive in the isolate, and that its existing functions get the cached
+// bytecode.
+TEST_F(DeserializeTest, OffThreadDeserializeMergesWithExistingScript) {
+  bool old_flag =
+      i::FLAG_merge_background_deserialized_script_with_compilation_cache;
+  i::FLAG_merge_background_deserialized_script_with_compilation_cache = true;
+
+  const char* kSource =
+      "function f() { return g() + 1; } function g() { return 41; }";
+  std::unique_ptr<v8::ScriptCompiler::CachedData> cached_data;
+
+  {
+    IsolateAndContextScope scope(this);
+
+    ScriptOrigin origin(isolate(), NewString("merge.js"));
+    ScriptCompiler::Source source(NewString(kSource), origin);
+    Local<Script> script =
+        ScriptCompiler::Compile(context(), &source).ToLocalChecked();
+
+    CHECK(!script->Run(context()).IsEmpty());
+    CHECK_EQ(RunGlobalFunc("f"), Integer::New(isolate(), 42));
+
+    cached_data.reset(
+        ScriptCompiler::CreateCodeCache(script->GetUnboundScript()));
+  }
+
+  {
+    IsolateAndContextScope scope(this);
+    i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate());
+    ScriptOrigin origin(isolate(), NewString("merge.js"));
+
+    // Load the script without running f, and flush the top-level bytecode,
+    // such that the compilation cache only has the Script.
+    i::Handle<i::Script> old_script;
+    {
+      ScriptCompiler::Source source(NewString(kSource), origin);
+      Local<Script> script =
+          ScriptCompiler::Compile(context(), &source).ToLocalChecked();
+      CHECK(!script->Run(context()).IsEmpty());
+      i::Handle<i::SharedFunctionInfo> toplevel =
+          Utils::OpenHandle(*script->GetUnboundScript());
+      old_script = i::handle(i::Script::cast(toplevel->script()), i_isolate);
+      i::SharedFunctionInfo::DiscardCompiled(i_isolate, toplevel);
+    }
+    Local<Value> f =
+        context()->Global()->Get(context(), NewString("f")).ToLocalChecked();
+    i::Handle<i::SharedFunctionInfo> f_shared(
+        i::Handle<i::JSFunction>::cast(Utils::OpenHandle(*f))->shared(),
+        i_isolate);
+    CHECK(!f_shared->is_compiled());
+
+    DeserializeThread deserialize_thread(
+        ScriptCompiler::StartConsumingCodeCache(
+            isolate(), std::make_unique<ScriptCompiler::CachedData>(
+                           cached_data->data, cached_data->length,
+                           ScriptCompiler::CachedData::BufferNotOwned)));
+    CHECK(deserialize_thread.Start());
+    deserialize_thread.Join();
+
+    std::unique_ptr<ScriptCompiler::ConsumeCodeCacheTask> task =
+        deserialize_thread.TakeTask();
+    task->SourceTextAvailable(isolate(), NewString(kSource), origin);
+    CHECK(task->ShouldMergeWithExistingScript());
+    MergeThread merge_thread(task.get());
+    CHECK(merge_thread.Start());
+    merge_thread.Join();
+
+    ScriptCompiler::Source source(NewString(kSource), origin,
+                                  cached_data.release(), task.release());
+    Local<Script> script =
+        ScriptCompiler::Compile(context(), &source,
+                                ScriptCompiler::kConsumeCodeCache)
+            .ToLocalChecked();
+
+    CHECK(!source.GetCachedData()->rejected);
+    CHECK_EQ(*old_script,
+             Utils::OpenHandle(*script->GetUnboundScript())->script());
+    // The closure created before the merge runs the cached bytecode.
+    CHECK(f_shared->is_compiled());
+    CHECK_EQ(RunGlobalFunc("f"), Integer::New(isolate(), 42));
+    CHECK(!script->Run(context()).IsEmpty());
+    CHECK_EQ(RunGlobalFunc("f"), Integer::New(isolate(), 42));
+  }
+
+  i::FLAG_merge_background_deserialized_script_with_compilation_cache =
+      old_flag;
+}
+
 }  // namespace v8
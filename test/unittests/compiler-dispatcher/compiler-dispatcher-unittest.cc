@@ -585,6 +585,50 @@ TEST_F(LazyCompileDispatcherTest, FinishNowWithWorkerTask) {
   dispatcher.AbortAll();
 }
 
+TEST_F(LazyCompileDispatcherTest, FinalizeFinishedJobs) {
+  MockPlatform platform;
+  LazyCompileDispatcher dispatcher(i_isolate(), &platform, FLAG_stack_size);
+
+  Handle<SharedFunctionInfo> shared =
+      test::CreateSharedFunctionInfo(i_isolate(), nullptr);
+  ASSERT_FALSE(shared->is_compiled());
+  Handle<SharedFunctionInfo> other_shared =
+      test::CreateSharedFunctionInfo(i_isolate(), nullptr);
+  ASSERT_FALSE(other_shared->is_compiled());
+  Handle<Script> script(Script::cast(shared->script()), i_isolate());
+
+  EnqueueUnoptimizedCompileJob(&dispatcher, i_isolate(), shared);
+  EnqueueUnoptimizedCompileJob(&dispatcher, i_isolate(), other_shared);
+
+  // Jobs which did not run on a background thread yet are left alone.
+  dispatcher.FinalizeFinishedJobs(script);
+  ASSERT_TRUE(dispatcher.IsEnqueued(shared));
+  ASSERT_FALSE(shared->is_compiled());
+  ASSERT_EQ(dispatcher.pending_background_jobs_.size(), 2u);
+
+  platform.RunJobTasksAndBlock(V8::GetCurrentPlatform());
+  ASSERT_EQ(dispatcher.finalizable_jobs_.size(), 2u);
+  ASSERT_TRUE(platform.IdleTaskPending());
+
+  // Finished jobs of the script are finalized without waiting for idle time,
+  // the ones of other scripts are not.
+  dispatcher.FinalizeFinishedJobs(script);
+  ASSERT_FALSE(dispatcher.IsEnqueued(shared));
+  ASSERT_TRUE(shared->is_compiled());
+  ASSERT_TRUE(dispatcher.IsEnqueued(other_shared));
+  ASSERT_FALSE(other_shared->is_compiled());
+  ASSERT_EQ(dispatcher.finalizable_jobs_.size(), 1u);
+  DEBUG_ASSERT_EQ(dispatcher.all_jobs_.size(), 1u);
+
+  platform.RunIdleTask(1000.0, 0.0);
+  ASSERT_TRUE(other_shared->is_compiled());
+  ASSERT_EQ(dispatcher.finalizable_jobs_.size(), 0u);
+  DEBUG_ASSERT_EQ(dispatcher.all_jobs_.size(), 0u);
+
+  ASSERT_FALSE(platform.IdleTaskPending());
+  dispatcher.AbortAll();
+}
+
 TEST_F(LazyCompileDispatcherTest, IdleTaskMultipleJobs) {
   MockPlatform platform;
   LazyCompileDispatcher dispatcher(i_isolate(), &platform, FLAG_stack_size);
@@ -785,6 +829,45 @@ TEST_F(LazyCompileDispatcherTest, CompileLazy2FinishesDispatcherJob) {
   ASSERT_FALSE(dispatcher->IsEnqueued(shared_2));
 }
 
+TEST_F(LazyCompileDispatcherTest, HotFunctionHints) {
+  // Use the real dispatcher, which is also used for compiling on the main
+  // thread.
+  LazyCompileDispatcher* dispatcher = i_isolate()->lazy_compile_dispatcher();
+
+  const char raw_script[] =
+      "function outer() { return function inner() { return 42; }; }\n"
+      "function cold() { return 0; }\n"
+      "outer;";
+  test::ScriptResource* resource =
+      new test::ScriptResource(raw_script, strlen(raw_script));
+  Handle<JSFunction> outer = RunJS<JSFunction>(resource);
+  Handle<SharedFunctionInfo> outer_shared(outer->shared(), i_isolate());
+  ASSERT_FALSE(outer_shared->is_compiled());
+  Handle<Script> script(Script::cast(outer_shared->script()), i_isolate());
+
+  const char* inner_source = strstr(raw_script, "function inner");
+  int inner_position = static_cast<int>(inner_source - raw_script);
+  dispatcher->AddHotFunctionHints(script, {0, inner_position});
+  ASSERT_TRUE(dispatcher->IsEnqueued(outer_shared));
+
+  // The hint for the inner function was dropped, since the inner function was
+  // not known yet. Hinting it again once it is known enqueues it.
+  Handle<JSFunction> inner = RunJS<JSFunction>("outer();");
+  Handle<SharedFunctionInfo> inner_shared(inner->shared(), i_isolate());
+  ASSERT_TRUE(outer_shared->is_compiled());
+  ASSERT_FALSE(dispatcher->IsEnqueued(inner_shared));
+  dispatcher->AddHotFunctionHints(script, {inner_position, inner_position});
+  ASSERT_TRUE(dispatcher->IsEnqueued(inner_shared));
+
+  // Functions without a hint are left alone.
+  Handle<JSFunction> cold = RunJS<JSFunction>("cold;");
+  ASSERT_FALSE(dispatcher->IsEnqueued(handle(cold->shared(), i_isolate())));
+
+  RunJS("outer()();");
+  ASSERT_TRUE(inner_shared->is_compiled());
+  ASSERT_FALSE(dispatcher->IsEnqueued(inner_shared));
+}
+
 TEST_F(LazyCompileDispatcherTest, CompileMultipleOnBackgroundThread) {
   MockPlatform platform;
   LazyCompileDispatcher dispatcher(i_isolate(), &platform, FLAG_stack_size);
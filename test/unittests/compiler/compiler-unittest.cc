@@ -8,6 +8,7 @@
 #include <wchar.h>
 
 #include <memory>
+#include <vector>
 
 #include "include/v8-function.h"
 #include "include/v8-local-handle.h"
@@ -927,5 +928,43 @@ TEST_F(CompilerTest, ProfilerEnabledDuringBackgroundCompile) {
   cpu_profiler->StopProfiling(profile);
 }
 
+// Tests that the modules of a streaming batch can be compiled once the batch
+// is joined.
+TEST_F(CompilerTest, StreamingModuleBatch) {
+  v8::HandleScope scope(isolate());
+  const char* sources[] = {
+      "import {b} from 'b'; export const a = b + 1;",
+      "import {c} from 'c'; export const b = c + 1;",
+      "export const c = 1;",
+  };
+
+  std::vector<std::unique_ptr<v8::ScriptCompiler::StreamedSource>>
+      streamed_sources;
+  std::vector<v8::ScriptCompiler::StreamedSource*> batch_sources;
+  for (const char* source : sources) {
+    streamed_sources.push_back(
+        std::make_unique<v8::ScriptCompiler::StreamedSource>(
+            std::make_unique<DummySourceStream>(source),
+            v8::ScriptCompiler::StreamedSource::UTF8));
+    batch_sources.push_back(streamed_sources.back().get());
+  }
+  std::unique_ptr<v8::ScriptCompiler::ModuleStreamingBatch> batch(
+      v8::ScriptCompiler::StartStreamingModules(isolate(), batch_sources));
+  ASSERT_NE(nullptr, batch);
+  batch->Join();
+
+  for (size_t i = 0; i < arraysize(sources); ++i) {
+    v8::ScriptOrigin origin(isolate(), NewString("module.mjs"), 0, 0, false,
+                            -1, v8::Local<v8::Value>(), false, false, true);
+    v8::Local<v8::Module> module =
+        v8::ScriptCompiler::CompileModule(context(), streamed_sources[i].get(),
+                                          NewString(sources[i]), origin)
+            .ToLocalChecked();
+    EXPECT_EQ(v8::Module::kUninstantiated, module->GetStatus());
+    EXPECT_EQ(i + 1 < arraysize(sources) ? 1 : 0,
+              module->GetModuleRequests()->Length());
+  }
+}
+
 }  // namespace internal
 }  // namespace v8
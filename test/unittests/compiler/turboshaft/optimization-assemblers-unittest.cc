@@ -0,0 +1,124 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/turboshaft/assembler.h"
+#include "src/compiler/turboshaft/graph.h"
+#include "src/compiler/turboshaft/load-elimination-assembler.h"
+#include "src/compiler/turboshaft/machine-optimization-assembler.h"
+#include "src/compiler/turboshaft/operations.h"
+#include "src/compiler/turboshaft/value-numbering-assembler.h"
+#include "test/unittests/test-utils.h"
+
+namespace v8::internal::compiler::turboshaft {
+
+using OptimizingAssembler = MachineOptimizationAssembler<
+    ValueNumberingAssembler<LoadEliminationAssembler<Assembler>>>;
+
+class TurboshaftOptimizationAssemblersTest : public TestWithZone {
+ public:
+  TurboshaftOptimizationAssemblersTest()
+      : graph_(zone()), assembler_(&graph_, zone()) {
+    Block* start = assembler_.NewBlock(Block::Kind::kMerge);
+    CHECK(assembler_.Bind(start));
+    p0_ = assembler_.Parameter(0);
+    p1_ = assembler_.Parameter(1);
+  }
+
+ protected:
+  OptimizingAssembler& assembler() { return assembler_; }
+  const Graph& graph() const { return graph_; }
+  OpIndex p0() const { return p0_; }
+  OpIndex p1() const { return p1_; }
+
+  bool IsWord32Constant(OpIndex index, uint32_t value) {
+    const ConstantOp* constant = graph().Get(index).TryCast<ConstantOp>();
+    return constant != nullptr &&
+           constant->kind == ConstantOp::Kind::kWord32 &&
+           constant->word32() == value;
+  }
+
+  OpIndex LoadInt32(OpIndex base, int32_t offset) {
+    return assembler().Load(base, LoadOp::Kind::kRawAligned,
+                            MachineType::Int32(), offset);
+  }
+
+  void StoreWord32(OpIndex base, OpIndex value, int32_t offset) {
+    assembler().Store(base, value, StoreOp::Kind::kRawAligned,
+                      MachineRepresentation::kWord32,
+                      WriteBarrierKind::kNoWriteBarrier, offset);
+  }
+
+ private:
+  Graph graph_;
+  OptimizingAssembler assembler_;
+  OpIndex p0_;
+  OpIndex p1_;
+};
+
+TEST_F(TurboshaftOptimizationAssemblersTest, ValueNumbering) {
+  constexpr MachineRepresentation kWord32 = MachineRepresentation::kWord32;
+  OpIndex a = assembler().Mul(p0(), p1(), kWord32);
+  OpIndex next = graph().next_operation_index();
+  OpIndex b = assembler().Mul(p0(), p1(), kWord32);
+  EXPECT_EQ(a, b);
+  // The duplicate was removed from the graph again.
+  EXPECT_EQ(next, graph().next_operation_index());
+  // Options and inputs are part of the operation identity.
+  EXPECT_NE(a, assembler().Mul(p0(), p1(), MachineRepresentation::kWord64));
+  EXPECT_NE(a, assembler().Mul(p1(), a, kWord32));
+  EXPECT_EQ(assembler().Word32Constant(42), assembler().Word32Constant(42));
+}
+
+TEST_F(TurboshaftOptimizationAssemblersTest, ConstantFolding) {
+  constexpr MachineRepresentation kWord32 = MachineRepresentation::kWord32;
+  OpIndex k2 = assembler().Word32Constant(2);
+  OpIndex k3 = assembler().Word32Constant(3);
+  EXPECT_TRUE(IsWord32Constant(assembler().Add(k2, k3, kWord32), 5));
+  EXPECT_TRUE(IsWord32Constant(assembler().Sub(k2, k3, kWord32), 0xFFFFFFFF));
+  EXPECT_TRUE(IsWord32Constant(assembler().ShiftLeft(k3, k2, kWord32), 12));
+  EXPECT_TRUE(IsWord32Constant(
+      assembler().SignedDiv(k3, assembler().Word32Constant(0), kWord32), 0));
+  EXPECT_TRUE(IsWord32Constant(assembler().Equal(k2, k3, kWord32), 0));
+  EXPECT_TRUE(IsWord32Constant(
+      assembler().Comparison(k2, k3, ComparisonOp::Kind::kSignedLessThan,
+                             kWord32),
+      1));
+}
+
+TEST_F(TurboshaftOptimizationAssemblersTest, AlgebraicSimplification) {
+  constexpr MachineRepresentation kWord32 = MachineRepresentation::kWord32;
+  OpIndex k0 = assembler().Word32Constant(0);
+  OpIndex k1 = assembler().Word32Constant(1);
+  EXPECT_EQ(p0(), assembler().Add(p0(), k0, kWord32));
+  EXPECT_EQ(p0(), assembler().Add(k0, p0(), kWord32));
+  EXPECT_EQ(p0(), assembler().Mul(k1, p0(), kWord32));
+  EXPECT_EQ(k0, assembler().Mul(p0(), k0, kWord32));
+  EXPECT_EQ(p0(), assembler().ShiftLeft(p0(), k0, kWord32));
+  EXPECT_TRUE(IsWord32Constant(assembler().Sub(p0(), p0(), kWord32), 0));
+  EXPECT_TRUE(IsWord32Constant(assembler().Equal(p1(), p1(), kWord32), 1));
+}
+
+TEST_F(TurboshaftOptimizationAssemblersTest, RedundantLoadIsEliminated) {
+  OpIndex load = LoadInt32(p0(), 8);
+  EXPECT_EQ(load, LoadInt32(p0(), 8));
+  EXPECT_NE(load, LoadInt32(p0(), 12));
+}
+
+TEST_F(TurboshaftOptimizationAssemblersTest, StoredValueIsForwarded) {
+  OpIndex value = assembler().Word32Constant(17);
+  StoreWord32(p0(), value, 16);
+  EXPECT_EQ(value, LoadInt32(p0(), 16));
+}
+
+TEST_F(TurboshaftOptimizationAssemblersTest, AliasingStoreKillsLoad) {
+  OpIndex load = LoadInt32(p0(), 8);
+  // A store to a disjoint range of the same object keeps the loaded value.
+  StoreWord32(p0(), p1(), 12);
+  EXPECT_EQ(load, LoadInt32(p0(), 8));
+  // A store through a different base might alias.
+  StoreWord32(p1(), p1(), 8);
+  EXPECT_NE(load, LoadInt32(p0(), 8));
+}
+
+}  // namespace v8::internal::compiler::turboshaft
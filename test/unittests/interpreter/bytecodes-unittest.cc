@@ -322,6 +322,27 @@ TEST(Bytecodes, IsJumpIfToBoolean) {
 #undef OR_IS_BYTECODE
 #undef IN_BYTECODE_LIST
 
+TEST(Bytecodes, IsJumpIfBooleanLookahead) {
+  // The inlined jump reads the accumulator written by the test bytecode.
+#define TEST_BYTECODE(Name, ...)                                            \
+  if (Bytecodes::IsJumpIfBooleanLookahead(Bytecode::k##Name,                \
+                                          OperandScale::kSingle)) {         \
+    EXPECT_TRUE(Bytecodes::WritesAccumulator(Bytecode::k##Name));           \
+    EXPECT_FALSE(Bytecodes::IsJump(Bytecode::k##Name));                     \
+    EXPECT_FALSE(Bytecodes::IsStarLookahead(Bytecode::k##Name,              \
+                                            OperandScale::kSingle));        \
+  }                                                                         \
+  EXPECT_FALSE(Bytecodes::IsJumpIfBooleanLookahead(Bytecode::k##Name,       \
+                                                   OperandScale::kDouble));
+
+  BYTECODE_LIST(TEST_BYTECODE)
+#undef TEST_BYTECODE
+  EXPECT_TRUE(Bytecodes::IsJumpIfBooleanLookahead(Bytecode::kTestLessThan,
+                                                  OperandScale::kSingle));
+  EXPECT_FALSE(Bytecodes::IsJumpIfBooleanLookahead(Bytecode::kAdd,
+                                                   OperandScale::kSingle));
+}
+
 TEST(OperandScale, PrefixesRequired) {
   CHECK(!Bytecodes::OperandScaleRequiresPrefixBytecode(OperandScale::kSingle));
   CHECK(Bytecodes::OperandScaleRequiresPrefixBytecode(OperandScale::kDouble));
@@ -412,6 +412,47 @@ TEST_F(ScannerStreamsTest, Utf8SingleByteChunks) {
   }
 }
 
+TEST_F(ScannerStreamsTest, Utf8LongAsciiRuns) {
+  // Long ascii runs, longer than the stream's buffer, interrupted by two-
+  // and four-byte sequences. Seeking into the middle of the runs has to skip
+  // the right number of bytes.
+  std::vector<uint8_t> bytes;
+  std::vector<uint16_t> expected;
+  for (int run = 0; run < 8; run++) {
+    for (int i = 0; i < 700 + run * 111; i++) {
+      uint8_t c = static_cast<uint8_t>('a' + (i + run) % 26);
+      bytes.push_back(c);
+      expected.push_back(c);
+    }
+    if (run % 2 == 0) {
+      bytes.insert(bytes.end(), {0xc3, 0xa4});  // U+00E4
+      expected.push_back(0xe4);
+    } else {
+      bytes.insert(bytes.end(), {0xf0, 0x9f, 0x98, 0x80});  // U+1F600
+      expected.insert(expected.end(), {0xd83d, 0xde00});
+    }
+  }
+
+  for (bool extra_chunky : {false, true}) {
+    ChunkSource chunk_source(bytes.data(), 1, bytes.size(), extra_chunky);
+    std::unique_ptr<i::Utf16CharacterStream> stream(i::ScannerStream::For(
+        &chunk_source, v8::ScriptCompiler::StreamedSource::UTF8));
+    for (size_t i = 0; i < expected.size(); i++) {
+      CHECK_EQ(expected[i], stream->Advance());
+    }
+    CHECK_EQ(i::Utf16CharacterStream::kEndOfInput, stream->Advance());
+
+    for (size_t pos : {size_t{1}, size_t{511}, size_t{700}, size_t{701},
+                       size_t{1600}, expected.size() / 2,
+                       expected.size() - 3}) {
+      stream->Seek(pos);
+      for (size_t i = pos; i < std::min(pos + 600, expected.size()); i++) {
+        CHECK_EQ(expected[i], stream->Advance());
+      }
+    }
+  }
+}
+
 #define CHECK_EQU(v1, v2) CHECK_EQ(static_cast<int>(v1), static_cast<int>(v2))
 
 void TestCharacterStream(const char* reference, i::Utf16CharacterStream* stream,
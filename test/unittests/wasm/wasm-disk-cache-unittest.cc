@@ -0,0 +1,201 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/wasm/wasm-disk-cache.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/base/platform/platform.h"
+#include "src/common/globals.h"
+#include "test/unittests/test-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+#if V8_OS_POSIX
+#include <dirent.h>
+#include <stdlib.h>
+#include <unistd.h>
+#endif  // V8_OS_POSIX
+
+namespace v8 {
+namespace internal {
+namespace wasm {
+
+class WasmDiskCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+#if V8_OS_POSIX
+    std::string pattern = ::testing::TempDir() + "wasm-disk-cache-XXXXXX";
+    std::vector<char> buffer(pattern.begin(), pattern.end());
+    buffer.push_back('\0');
+    ASSERT_NE(nullptr, mkdtemp(buffer.data()));
+    directory_ = buffer.data();
+#else
+    GTEST_SKIP() << "Needs a POSIX temporary directory";
+#endif  // V8_OS_POSIX
+  }
+
+  void TearDown() override {
+#if V8_OS_POSIX
+    if (directory_.empty()) return;
+    DIR* dir = opendir(directory_.c_str());
+    if (dir == nullptr) return;
+    while (dirent* entry = readdir(dir)) {
+      std::string name = entry->d_name;
+      if (name == "." || name == "..") continue;
+      base::OS::Remove((directory_ + "/" + name).c_str());
+    }
+    closedir(dir);
+    rmdir(directory_.c_str());
+#endif  // V8_OS_POSIX
+  }
+
+  std::unique_ptr<WasmDiskCache> NewCache(size_t max_size) {
+    return std::make_unique<WasmDiskCache>(directory_, max_size);
+  }
+
+  static std::vector<uint8_t> Bytes(size_t size, uint8_t value) {
+    return std::vector<uint8_t>(size, value);
+  }
+
+  static bool Put(WasmDiskCache* cache, const std::string& key,
+                  const std::vector<uint8_t>& wire_bytes,
+                  const std::vector<uint8_t>& module,
+                  WasmFeatures features = WasmFeatures::None()) {
+    return cache->Put(key, features, base::VectorOf(wire_bytes),
+                      base::VectorOf(module));
+  }
+
+  static bool Get(WasmDiskCache* cache, const std::string& key,
+                  const std::vector<uint8_t>& wire_bytes,
+                  std::vector<uint8_t>* module,
+                  WasmFeatures features = WasmFeatures::None()) {
+    return cache->Get(key, features, base::VectorOf(wire_bytes), module);
+  }
+
+ private:
+  std::string directory_;
+};
+
+TEST_F(WasmDiskCacheTest, PutAndGet) {
+  std::unique_ptr<WasmDiskCache> cache = NewCache(MB);
+  std::vector<uint8_t> wire_bytes = Bytes(16, 1);
+  std::vector<uint8_t> module = Bytes(100, 2);
+  std::vector<uint8_t> result;
+  EXPECT_FALSE(Get(cache.get(), "a", wire_bytes, &result));
+  EXPECT_TRUE(Put(cache.get(), "a", wire_bytes, module));
+  EXPECT_EQ(1u, cache->entry_count());
+  ASSERT_TRUE(Get(cache.get(), "a", wire_bytes, &result));
+  EXPECT_EQ(module, result);
+}
+
+TEST_F(WasmDiskCacheTest, WireBytesMismatchIsAMiss) {
+  std::unique_ptr<WasmDiskCache> cache = NewCache(MB);
+  std::vector<uint8_t> wire_bytes = Bytes(16, 1);
+  std::vector<uint8_t> other_wire_bytes = Bytes(16, 3);
+  std::vector<uint8_t> module = Bytes(100, 2);
+  ASSERT_TRUE(Put(cache.get(), "a", wire_bytes, module));
+  std::vector<uint8_t> result;
+  EXPECT_FALSE(Get(cache.get(), "a", other_wire_bytes, &result));
+  // The colliding entry was dropped.
+  EXPECT_EQ(0u, cache->entry_count());
+  EXPECT_EQ(0u, cache->size());
+  EXPECT_FALSE(Get(cache.get(), "a", wire_bytes, &result));
+}
+
+TEST_F(WasmDiskCacheTest, FeaturesMismatchIsAMiss) {
+  std::unique_ptr<WasmDiskCache> cache = NewCache(MB);
+  std::vector<uint8_t> wire_bytes = Bytes(16, 1);
+  std::vector<uint8_t> module = Bytes(100, 2);
+  WasmFeatures gc({WasmFeature::kFeature_gc});
+  ASSERT_TRUE(Put(cache.get(), "a", wire_bytes, module, gc));
+  std::vector<uint8_t> result;
+  EXPECT_FALSE(Get(cache.get(), "a", wire_bytes, &result));
+}
+
+TEST_F(WasmDiskCacheTest, LeastRecentlyUsedEntryIsEvicted) {
+  std::vector<uint8_t> wire_bytes = Bytes(8, 1);
+  std::vector<uint8_t> module = Bytes(1000, 2);
+  // Room for two entries, but not for three.
+  std::unique_ptr<WasmDiskCache> cache = NewCache(2500);
+  ASSERT_TRUE(Put(cache.get(), "a", wire_bytes, module));
+  ASSERT_TRUE(Put(cache.get(), "b", wire_bytes, module));
+  std::vector<uint8_t> result;
+  // Use "a", so that "b" becomes the least recently used entry.
+  ASSERT_TRUE(Get(cache.get(), "a", wire_bytes, &result));
+  ASSERT_TRUE(Put(cache.get(), "c", wire_bytes, module));
+  EXPECT_EQ(2u, cache->entry_count());
+  EXPECT_LE(cache->size(), size_t{2500});
+  EXPECT_TRUE(Get(cache.get(), "a", wire_bytes, &result));
+  EXPECT_FALSE(Get(cache.get(), "b", wire_bytes, &result));
+  EXPECT_TRUE(Get(cache.get(), "c", wire_bytes, &result));
+}
+
+TEST_F(WasmDiskCacheTest, OversizedEntryIsRejected) {
+  std::unique_ptr<WasmDiskCache> cache = NewCache(100);
+  std::vector<uint8_t> wire_bytes = Bytes(8, 1);
+  std::vector<uint8_t> module = Bytes(1000, 2);
+  EXPECT_FALSE(Put(cache.get(), "a", wire_bytes, module));
+  EXPECT_EQ(0u, cache->entry_count());
+}
+
+TEST_F(WasmDiskCacheTest, IndexIsPersisted) {
+  std::vector<uint8_t> wire_bytes = Bytes(8, 1);
+  std::vector<uint8_t> module = Bytes(1000, 2);
+  size_t size;
+  {
+    std::unique_ptr<WasmDiskCache> cache = NewCache(MB);
+    ASSERT_TRUE(Put(cache.get(), "a", wire_bytes, module));
+    ASSERT_TRUE(Put(cache.get(), "b", wire_bytes, module));
+    size = cache->size();
+  }
+  // A new cache on the same directory (e.g. in the next process) picks up
+  // the existing entries.
+  std::unique_ptr<WasmDiskCache> cache = NewCache(MB);
+  EXPECT_EQ(2u, cache->entry_count());
+  EXPECT_EQ(size, cache->size());
+  std::vector<uint8_t> result;
+  ASSERT_TRUE(Get(cache.get(), "b", wire_bytes, &result));
+  EXPECT_EQ(module, result);
+}
+
+TEST_F(WasmDiskCacheTest, LookupsArePersistedOnFlush) {
+  std::vector<uint8_t> wire_bytes = Bytes(8, 1);
+  std::vector<uint8_t> module = Bytes(1000, 2);
+  {
+    std::unique_ptr<WasmDiskCache> cache = NewCache(MB);
+    ASSERT_TRUE(Put(cache.get(), "a", wire_bytes, module));
+    ASSERT_TRUE(Put(cache.get(), "b", wire_bytes, module));
+    // Lookups only update the index file when it is flushed, here by the
+    // destructor.
+    std::vector<uint8_t> result;
+    ASSERT_TRUE(Get(cache.get(), "a", wire_bytes, &result));
+  }
+  // Room for two entries, but not for three. "b" is the least recently used
+  // entry and gets evicted.
+  std::unique_ptr<WasmDiskCache> cache = NewCache(2500);
+  ASSERT_TRUE(Put(cache.get(), "c", wire_bytes, module));
+  std::vector<uint8_t> result;
+  EXPECT_TRUE(Get(cache.get(), "a", wire_bytes, &result));
+  EXPECT_FALSE(Get(cache.get(), "b", wire_bytes, &result));
+}
+
+TEST_F(WasmDiskCacheTest, KeyDependsOnWireBytesAndFeatures) {
+  std::vector<uint8_t> a = Bytes(8, 1);
+  std::vector<uint8_t> b = Bytes(8, 2);
+  WasmFeatures none = WasmFeatures::None();
+  WasmFeatures gc({WasmFeature::kFeature_gc});
+  EXPECT_EQ(WasmDiskCache::KeyFor(none, base::VectorOf(a)),
+            WasmDiskCache::KeyFor(none, base::VectorOf(a)));
+  EXPECT_NE(WasmDiskCache::KeyFor(none, base::VectorOf(a)),
+            WasmDiskCache::KeyFor(none, base::VectorOf(b)));
+  EXPECT_NE(WasmDiskCache::KeyFor(none, base::VectorOf(a)),
+            WasmDiskCache::KeyFor(gc, base::VectorOf(a)));
+  EXPECT_EQ(16u, WasmDiskCache::KeyFor(none, base::VectorOf(a)).size());
+}
+
+}  // namespace wasm
+}  // namespace internal
+}  // namespace v8
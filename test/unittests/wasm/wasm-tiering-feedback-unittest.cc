@@ -0,0 +1,342 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/wasm/wasm-tiering-feedback.h"
+
+#include <cstring>
+#include <functional>
+#include <set>
+#include <vector>
+
+#include "src/flags/flags.h"
+#include "src/utils/version.h"
+#include "src/wasm/wasm-engine.h"
+#include "src/wasm/wasm-module.h"
+#include "src/wasm/wasm-opcodes.h"
+#include "test/unittests/test-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+namespace wasm {
+
+class WasmTieringFeedbackTest : public ::testing::Test {
+ protected:
+  // Builds serialized feedback in the format produced by
+  // {WasmTieringFeedback::Export}.
+  class Builder {
+   public:
+    explicit Builder(base::Vector<const uint8_t> wire_bytes) {
+      Write(uint32_t{0x43465457});
+      Write(Version::Hash());
+      Write(FlagList::Hash());
+      size_t module_hash = NativeModuleCache::WireBytesHash(wire_bytes);
+      Write(static_cast<uint64_t>(module_hash));
+      Write(static_cast<uint32_t>(wire_bytes.size()));
+    }
+
+    template <typename T>
+    Builder& Write(T value) {
+      size_t offset = bytes_.size();
+      bytes_.resize(offset + sizeof(T));
+      memcpy(bytes_.data() + offset, &value, sizeof(T));
+      return *this;
+    }
+
+    base::Vector<const uint8_t> bytes() const {
+      return base::VectorOf(bytes_);
+    }
+
+   private:
+    std::vector<uint8_t> bytes_;
+  };
+
+  void AddImportedFunction(WasmModule* module) {
+    DCHECK_EQ(0, module->num_declared_functions);
+    WasmFunction function{};
+    function.func_index = module->num_imported_functions++;
+    function.imported = true;
+    module->functions.push_back(function);
+  }
+
+  // Adds a function without locals and with the given {code} to {module},
+  // and its body to {wire_bytes_}.
+  void AddFunction(WasmModule* module, std::initializer_list<uint8_t> code) {
+    uint32_t offset = static_cast<uint32_t>(wire_bytes_.size());
+    wire_bytes_.push_back(0);  // No local declarations.
+    wire_bytes_.insert(wire_bytes_.end(), code);
+    wire_bytes_.push_back(kExprEnd);
+    WasmFunction function{};
+    function.func_index = static_cast<uint32_t>(module->functions.size());
+    function.code = {offset,
+                     static_cast<uint32_t>(wire_bytes_.size()) - offset};
+    function.declared = true;
+    module->functions.push_back(function);
+    ++module->num_declared_functions;
+  }
+
+  std::vector<uint8_t> wire_bytes_ = std::vector<uint8_t>(32, 7);
+};
+
+TEST_F(WasmTieringFeedbackTest, Parse) {
+  Builder builder(base::VectorOf(wire_bytes_));
+  // Two hot functions: function 2 with a monomorphic and an unknown call
+  // site, function 3 with a polymorphic call site.
+  builder.Write(uint32_t{2});
+  builder.Write(uint32_t{2}).Write(uint32_t{2});
+  builder.Write(uint32_t{1}).Write(uint32_t{3}).Write(int32_t{100});
+  builder.Write(uint32_t{0});
+  builder.Write(uint32_t{2});
+  builder.Write(uint32_t{3}).Write(FunctionTypeFeedback::kNonDirectCall);
+  builder.Write(uint32_t{3}).Write(uint32_t{1});
+  builder.Write(uint32_t{2});
+  builder.Write(uint32_t{2}).Write(int32_t{10});
+  builder.Write(uint32_t{3}).Write(int32_t{20});
+  builder.Write(uint32_t{0});
+
+  std::unique_ptr<WasmTieringFeedback> feedback =
+      WasmTieringFeedback::Parse(builder.bytes());
+  ASSERT_NE(nullptr, feedback);
+  EXPECT_TRUE(feedback->Matches(base::VectorOf(wire_bytes_)));
+  const auto& functions = feedback->hot_functions();
+  ASSERT_EQ(2u, functions.size());
+  EXPECT_EQ(2u, functions[0].function_index);
+  ASSERT_EQ(2u, functions[0].call_sites.size());
+  ASSERT_EQ(1u, functions[0].call_sites[0].size());
+  EXPECT_EQ(3u, functions[0].call_sites[0][0].function_index);
+  EXPECT_EQ(100, functions[0].call_sites[0][0].call_count);
+  EXPECT_TRUE(functions[0].call_sites[1].empty());
+  EXPECT_EQ(std::vector<uint32_t>({3, FunctionTypeFeedback::kNonDirectCall}),
+            functions[0].call_targets);
+  EXPECT_EQ(3u, functions[1].function_index);
+  ASSERT_EQ(1u, functions[1].call_sites.size());
+  EXPECT_EQ(2u, functions[1].call_sites[0].size());
+  EXPECT_TRUE(functions[1].call_targets.empty());
+}
+
+TEST_F(WasmTieringFeedbackTest, OtherWireBytesDoNotMatch) {
+  Builder builder(base::VectorOf(wire_bytes_));
+  builder.Write(uint32_t{0});
+  std::unique_ptr<WasmTieringFeedback> feedback =
+      WasmTieringFeedback::Parse(builder.bytes());
+  ASSERT_NE(nullptr, feedback);
+  std::vector<uint8_t> other_wire_bytes(32, 8);
+  EXPECT_FALSE(feedback->Matches(base::VectorOf(other_wire_bytes)));
+  wire_bytes_.push_back(0);
+  EXPECT_FALSE(feedback->Matches(base::VectorOf(wire_bytes_)));
+}
+
+TEST_F(WasmTieringFeedbackTest, RejectInvalidData) {
+  // Truncated header.
+  Builder builder(base::VectorOf(wire_bytes_));
+  EXPECT_EQ(nullptr, WasmTieringFeedback::Parse(builder.bytes()));
+
+  // More functions than the data can hold.
+  builder.Write(uint32_t{1000});
+  builder.Write(uint32_t{2}).Write(uint32_t{0});
+  EXPECT_EQ(nullptr, WasmTieringFeedback::Parse(builder.bytes()));
+
+  // Trailing garbage.
+  Builder trailing(base::VectorOf(wire_bytes_));
+  trailing.Write(uint32_t{0}).Write(uint8_t{0});
+  EXPECT_EQ(nullptr, WasmTieringFeedback::Parse(trailing.bytes()));
+
+  // Too many cases for one call site.
+  Builder megamorphic(base::VectorOf(wire_bytes_));
+  megamorphic.Write(uint32_t{1});
+  megamorphic.Write(uint32_t{0}).Write(uint32_t{1});
+  uint32_t num_cases = kMaxPolymorphism + 1;
+  megamorphic.Write(num_cases);
+  for (uint32_t i = 0; i < num_cases; ++i) {
+    megamorphic.Write(i).Write(int32_t{1});
+  }
+  EXPECT_EQ(nullptr, WasmTieringFeedback::Parse(megamorphic.bytes()));
+
+  // Wrong magic number.
+  std::vector<uint8_t> bytes(builder.bytes().begin(), builder.bytes().end());
+  bytes[0] ^= 1;
+  EXPECT_EQ(nullptr, WasmTieringFeedback::Parse(base::VectorOf(bytes)));
+}
+
+TEST_F(WasmTieringFeedbackTest, ApplyTo) {
+  WasmModule module;
+  AddImportedFunction(&module);
+  // Function 1 calls the imported function 0 and function 2.
+  AddFunction(&module, {kExprCallFunction, 0, kExprCallFunction, 2});
+  // Function 2 has a call_ref site.
+  AddFunction(&module, {kExprLocalGet, 0, kExprCallRef});
+  // Function 3 has a call_ref site.
+  AddFunction(&module, {kExprLocalGet, 0, kExprCallRef});
+
+  Builder builder(base::VectorOf(wire_bytes_));
+  builder.Write(uint32_t{4});
+  builder.Write(uint32_t{1}).Write(uint32_t{2});
+  builder.Write(uint32_t{1}).Write(uint32_t{0}).Write(int32_t{5});
+  builder.Write(uint32_t{1}).Write(uint32_t{2}).Write(int32_t{6});
+  builder.Write(uint32_t{2}).Write(uint32_t{0}).Write(uint32_t{2});
+  // Function 2 has a polymorphic call site.
+  builder.Write(uint32_t{2}).Write(uint32_t{1});
+  builder.Write(uint32_t{2});
+  builder.Write(uint32_t{1}).Write(int32_t{10});
+  builder.Write(uint32_t{2}).Write(int32_t{20});
+  builder.Write(uint32_t{1}).Write(FunctionTypeFeedback::kNonDirectCall);
+  // Function 3 has feedback for a direct call, which it does not have. The
+  // function is still hot, but its feedback is dropped.
+  builder.Write(uint32_t{3}).Write(uint32_t{1});
+  builder.Write(uint32_t{1}).Write(uint32_t{1}).Write(int32_t{5});
+  builder.Write(uint32_t{1}).Write(uint32_t{1});
+  // Function 7 does not exist.
+  builder.Write(uint32_t{7}).Write(uint32_t{0}).Write(uint32_t{0});
+  std::unique_ptr<WasmTieringFeedback> feedback =
+      WasmTieringFeedback::Parse(builder.bytes());
+  ASSERT_NE(nullptr, feedback);
+
+  feedback->ApplyTo(&module, base::VectorOf(wire_bytes_));
+
+  TypeFeedbackStorage& type_feedback = module.type_feedback;
+  EXPECT_EQ(std::set<uint32_t>({1, 2, 3}), type_feedback.known_hot_functions);
+  ASSERT_EQ(2u, type_feedback.feedback_for_function.size());
+  const std::vector<CallSiteFeedback>& function_1 =
+      type_feedback.feedback_for_function[1].feedback_vector;
+  ASSERT_EQ(2u, function_1.size());
+  ASSERT_EQ(1, function_1[0].num_cases());
+  EXPECT_EQ(0, function_1[0].function_index(0));
+  EXPECT_EQ(5, function_1[0].call_count(0));
+  ASSERT_EQ(1, function_1[1].num_cases());
+  EXPECT_EQ(2, function_1[1].function_index(0));
+  EXPECT_EQ(6, function_1[1].call_count(0));
+  EXPECT_EQ(std::vector<uint32_t>({0, 2}),
+            type_feedback.feedback_for_function[1].call_targets);
+  const std::vector<CallSiteFeedback>& function_2 =
+      type_feedback.feedback_for_function[2].feedback_vector;
+  ASSERT_EQ(1u, function_2.size());
+  ASSERT_EQ(2, function_2[0].num_cases());
+  EXPECT_EQ(1, function_2[0].function_index(0));
+  EXPECT_EQ(10, function_2[0].call_count(0));
+  EXPECT_EQ(2, function_2[0].function_index(1));
+  EXPECT_EQ(20, function_2[0].call_count(1));
+  EXPECT_EQ(std::vector<uint32_t>({FunctionTypeFeedback::kNonDirectCall}),
+            type_feedback.feedback_for_function[2].call_targets);
+}
+
+TEST_F(WasmTieringFeedbackTest, DropMismatchingFeedback) {
+  WasmModule module;
+  AddImportedFunction(&module);
+  AddFunction(&module, {kExprCallFunction, 0, kExprCallFunction, 1});
+
+  auto apply = [&](std::function<void(Builder&)> write_function) {
+    Builder builder(base::VectorOf(wire_bytes_));
+    builder.Write(uint32_t{1});
+    write_function(builder);
+    std::unique_ptr<WasmTieringFeedback> feedback =
+        WasmTieringFeedback::Parse(builder.bytes());
+    CHECK_NOT_NULL(feedback);
+    module.type_feedback.feedback_for_function.clear();
+    module.type_feedback.known_hot_functions.clear();
+    feedback->ApplyTo(&module, base::VectorOf(wire_bytes_));
+    EXPECT_EQ(std::set<uint32_t>({1}),
+              module.type_feedback.known_hot_functions);
+    EXPECT_TRUE(module.type_feedback.feedback_for_function.empty());
+  };
+  // Too few call sites.
+  apply([](Builder& builder) {
+    builder.Write(uint32_t{1}).Write(uint32_t{1});
+    builder.Write(uint32_t{1}).Write(uint32_t{0}).Write(int32_t{5});
+    builder.Write(uint32_t{1}).Write(uint32_t{0});
+  });
+  // A direct call without feedback.
+  apply([](Builder& builder) {
+    builder.Write(uint32_t{1}).Write(uint32_t{2});
+    builder.Write(uint32_t{0});
+    builder.Write(uint32_t{1}).Write(uint32_t{1}).Write(int32_t{5});
+    builder.Write(uint32_t{2}).Write(uint32_t{0}).Write(uint32_t{1});
+  });
+  // A direct call with feedback for another target.
+  apply([](Builder& builder) {
+    builder.Write(uint32_t{1}).Write(uint32_t{2});
+    builder.Write(uint32_t{1}).Write(uint32_t{1}).Write(int32_t{5});
+    builder.Write(uint32_t{1}).Write(uint32_t{1}).Write(int32_t{5});
+    builder.Write(uint32_t{2}).Write(uint32_t{0}).Write(uint32_t{1});
+  });
+  // Call targets that do not match the body.
+  apply([](Builder& builder) {
+    builder.Write(uint32_t{1}).Write(uint32_t{2});
+    builder.Write(uint32_t{1}).Write(uint32_t{1}).Write(int32_t{5});
+    builder.Write(uint32_t{1}).Write(uint32_t{1}).Write(int32_t{5});
+    builder.Write(uint32_t{2}).Write(uint32_t{1}).Write(uint32_t{1});
+  });
+}
+
+TEST_F(WasmTieringFeedbackTest, ExportAndApply) {
+  WasmModule module;
+  AddImportedFunction(&module);
+  // Function 1 calls the imported function 0 directly, and functions 2 and 3
+  // through a call_ref.
+  AddFunction(&module, {kExprCallFunction, 0, kExprLocalGet, 0, kExprCallRef});
+  // Function 2 calls function 3.
+  AddFunction(&module, {kExprCallFunction, 3});
+  AddFunction(&module, {});
+  {
+    TypeFeedbackStorage& type_feedback = module.type_feedback;
+    // Function 1 triggered tier-up. Its direct call to the import collected
+    // a call count, like any direct call.
+    FunctionTypeFeedback& function_1 = type_feedback.feedback_for_function[1];
+    function_1.tierup_priority = 2;
+    CallSiteFeedback::PolymorphicCase* polymorphic =
+        new CallSiteFeedback::PolymorphicCase[2];
+    polymorphic[0] = {3, 40};
+    polymorphic[1] = {2, 15};
+    function_1.feedback_vector.emplace_back(0, 12);
+    function_1.feedback_vector.emplace_back(polymorphic, 2);
+    function_1.call_targets = {0, FunctionTypeFeedback::kNonDirectCall};
+    // Function 2 is monomorphic, but did not get hot.
+    FunctionTypeFeedback& function_2 = type_feedback.feedback_for_function[2];
+    function_2.feedback_vector.emplace_back(3, 7);
+    function_2.call_targets = {3};
+  }
+  base::OwnedVector<uint8_t> data =
+      WasmTieringFeedback::Export(&module, base::VectorOf(wire_bytes_));
+  ASSERT_FALSE(data.empty());
+  std::unique_ptr<WasmTieringFeedback> feedback =
+      WasmTieringFeedback::Parse(data.as_vector());
+  ASSERT_NE(nullptr, feedback);
+  EXPECT_TRUE(feedback->Matches(base::VectorOf(wire_bytes_)));
+
+  // Apply the feedback to the module of the next run.
+  WasmModule next_module;
+  next_module.num_imported_functions = module.num_imported_functions;
+  next_module.num_declared_functions = module.num_declared_functions;
+  next_module.functions = module.functions;
+  feedback->ApplyTo(&next_module, base::VectorOf(wire_bytes_));
+
+  TypeFeedbackStorage& type_feedback = next_module.type_feedback;
+  EXPECT_EQ(std::set<uint32_t>({1}), type_feedback.known_hot_functions);
+  ASSERT_EQ(1u, type_feedback.feedback_for_function.size());
+  const FunctionTypeFeedback& function_1 =
+      type_feedback.feedback_for_function[1];
+  ASSERT_EQ(2u, function_1.feedback_vector.size());
+  ASSERT_EQ(1, function_1.feedback_vector[0].num_cases());
+  EXPECT_EQ(0, function_1.feedback_vector[0].function_index(0));
+  EXPECT_EQ(12, function_1.feedback_vector[0].call_count(0));
+  ASSERT_EQ(2, function_1.feedback_vector[1].num_cases());
+  EXPECT_EQ(3, function_1.feedback_vector[1].function_index(0));
+  EXPECT_EQ(40, function_1.feedback_vector[1].call_count(0));
+  EXPECT_EQ(2, function_1.feedback_vector[1].function_index(1));
+  EXPECT_EQ(15, function_1.feedback_vector[1].call_count(1));
+  EXPECT_EQ(std::vector<uint32_t>({0, FunctionTypeFeedback::kNonDirectCall}),
+            function_1.call_targets);
+}
+
+TEST_F(WasmTieringFeedbackTest, ExportWithoutHotFunctionsIsEmpty) {
+  WasmModule module;
+  module.num_declared_functions = 1;
+  module.type_feedback.feedback_for_function[0].call_targets = {0};
+  EXPECT_TRUE(
+      WasmTieringFeedback::Export(&module, base::VectorOf(wire_bytes_))
+          .empty());
+}
+
+}  // namespace wasm
+}  // namespace internal
+}  // namespace v8
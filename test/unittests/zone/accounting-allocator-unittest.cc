@@ -0,0 +1,133 @@
+// Copyright 2022 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/zone/accounting-allocator.h"
+
+#include <vector>
+
+#include "src/zone/zone-segment.h"
+#include "src/zone/zone.h"
+#include "test/common/flag-utils.h"
+#include "test/unittests/test-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+// This struct is just a type tag for Zone::Allocate<T>(size_t) call.
+struct AccountingAllocatorTestTag {};
+
+class AccountingAllocatorTest : public TestWithPlatform {
+ protected:
+  static constexpr bool kNoCompression = false;
+};
+
+TEST_F(AccountingAllocatorTest, SegmentIsReused) {
+  FlagScope<bool> pool(&FLAG_zone_segment_pool, true);
+  AccountingAllocator allocator;
+  Segment* segment = allocator.AllocateSegment(8 * KB, kNoCompression);
+  ASSERT_NE(nullptr, segment);
+  EXPECT_EQ(0u, allocator.segment_pool_hits());
+  EXPECT_EQ(1u, allocator.segment_pool_misses());
+  allocator.ReturnSegment(segment, kNoCompression);
+  EXPECT_EQ(size_t{8 * KB}, allocator.GetPooledMemoryUsage());
+  EXPECT_EQ(0u, allocator.GetCurrentMemoryUsage());
+
+  Segment* reused = allocator.AllocateSegment(8 * KB, kNoCompression);
+  EXPECT_EQ(segment, reused);
+  EXPECT_EQ(size_t{8 * KB}, reused->total_size());
+  EXPECT_EQ(nullptr, reused->next());
+  EXPECT_EQ(1u, allocator.segment_pool_hits());
+  EXPECT_EQ(0u, allocator.GetPooledMemoryUsage());
+  EXPECT_EQ(size_t{8 * KB}, allocator.GetCurrentMemoryUsage());
+  allocator.ReturnSegment(reused, kNoCompression);
+}
+
+TEST_F(AccountingAllocatorTest, SizesAreRoundedToSizeClass) {
+  FlagScope<bool> pool(&FLAG_zone_segment_pool, true);
+  AccountingAllocator allocator;
+  Segment* segment = allocator.AllocateSegment(10 * KB, kNoCompression);
+  ASSERT_NE(nullptr, segment);
+  EXPECT_EQ(size_t{16 * KB}, segment->total_size());
+  allocator.ReturnSegment(segment, kNoCompression);
+  // A pooled segment serves any request of its size class.
+  Segment* reused = allocator.AllocateSegment(12 * KB, kNoCompression);
+  EXPECT_EQ(segment, reused);
+  allocator.ReturnSegment(reused, kNoCompression);
+}
+
+TEST_F(AccountingAllocatorTest, UncommonSizesAreNotPooled) {
+  FlagScope<bool> pool(&FLAG_zone_segment_pool, true);
+  AccountingAllocator allocator;
+  for (size_t size : {size_t{100}, size_t{64 * KB}}) {
+    Segment* segment = allocator.AllocateSegment(size, kNoCompression);
+    ASSERT_NE(nullptr, segment);
+    EXPECT_EQ(size, segment->total_size());
+    allocator.ReturnSegment(segment, kNoCompression);
+    EXPECT_EQ(0u, allocator.GetPooledMemoryUsage());
+  }
+  EXPECT_EQ(0u, allocator.segment_pool_hits());
+  EXPECT_EQ(0u, allocator.segment_pool_misses());
+}
+
+TEST_F(AccountingAllocatorTest, PoolSizeIsBounded) {
+  FlagScope<bool> pool(&FLAG_zone_segment_pool, true);
+  FlagScope<size_t> pool_size(&FLAG_zone_segment_pool_max_size_kb, 64);
+  AccountingAllocator allocator;
+  std::vector<Segment*> segments;
+  for (int i = 0; i < 4; ++i) {
+    segments.push_back(allocator.AllocateSegment(32 * KB, kNoCompression));
+  }
+  for (Segment* segment : segments) {
+    allocator.ReturnSegment(segment, kNoCompression);
+  }
+  EXPECT_EQ(size_t{64 * KB}, allocator.GetPooledMemoryUsage());
+  EXPECT_EQ(0u, allocator.GetCurrentMemoryUsage());
+}
+
+TEST_F(AccountingAllocatorTest, TrimReleasesPooledSegments) {
+  FlagScope<bool> pool(&FLAG_zone_segment_pool, true);
+  AccountingAllocator allocator;
+  Segment* small = allocator.AllocateSegment(8 * KB, kNoCompression);
+  Segment* large = allocator.AllocateSegment(32 * KB, kNoCompression);
+  allocator.ReturnSegment(small, kNoCompression);
+  allocator.ReturnSegment(large, kNoCompression);
+  EXPECT_EQ(size_t{40 * KB}, allocator.GetPooledMemoryUsage());
+  allocator.TrimSegmentPool();
+  EXPECT_EQ(0u, allocator.GetPooledMemoryUsage());
+  Segment* fresh = allocator.AllocateSegment(8 * KB, kNoCompression);
+  EXPECT_EQ(0u, allocator.segment_pool_hits());
+  allocator.ReturnSegment(fresh, kNoCompression);
+}
+
+TEST_F(AccountingAllocatorTest, DisabledPool) {
+  FlagScope<bool> pool(&FLAG_zone_segment_pool, false);
+  AccountingAllocator allocator;
+  Segment* segment = allocator.AllocateSegment(10 * KB, kNoCompression);
+  EXPECT_EQ(size_t{10 * KB}, segment->total_size());
+  allocator.ReturnSegment(segment, kNoCompression);
+  EXPECT_EQ(0u, allocator.GetPooledMemoryUsage());
+}
+
+// Mimics short-lived compilation jobs that each create a fresh zone: after
+// the first job, all segments are served from the pool.
+TEST_F(AccountingAllocatorTest, ZoneChurnIsServedFromPool) {
+  FlagScope<bool> pool(&FLAG_zone_segment_pool, true);
+  AccountingAllocator allocator;
+  static constexpr int kJobs = 100;
+  for (int i = 0; i < kJobs; ++i) {
+    Zone zone(&allocator, ZONE_NAME);
+    for (int j = 0; j < 64; ++j) {
+      zone.Allocate<AccountingAllocatorTestTag>(1024);
+    }
+  }
+  size_t allocations =
+      allocator.segment_pool_hits() + allocator.segment_pool_misses();
+  EXPECT_LT(0u, allocations);
+  EXPECT_EQ(allocations / kJobs, allocator.segment_pool_misses());
+  EXPECT_EQ(0u, allocator.GetCurrentMemoryUsage());
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,101 @@
+#! /usr/bin/env python3
+#
+# Copyright 2022 the V8 project authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+"""Summarizes bytecode dispatch counters dumped by d8.
+
+Build with v8_enable_ignition_dispatch_counting = true and run
+
+  d8 --trace-ignition-dispatches-output-file=v8.ignition_dispatches_table.json
+
+to produce the input. The report lists the most frequent pairs of
+consecutively dispatched bytecodes, which are the candidates for handling the
+second bytecode by lookahead in the handler of the first one (see
+InterpreterAssembler::StarDispatchLookahead).
+"""
+
+import argparse
+import heapq
+import json
+import sys
+
+__DESCRIPTION = __doc__.splitlines()[0]
+
+__HELP_EPILOGUE = """
+examples:
+  # Print the 20 most frequent dispatch pairs.
+  $ %(prog)s -n 20
+
+  # Print the most frequent successors of Ldar.
+  $ %(prog)s -f Ldar
+"""
+
+
+def flatten(counters):
+  for source, destinations in counters.items():
+    for destination, count in destinations.items():
+      yield source, destination, count
+
+
+def print_top_pairs(counters, top_count):
+  pairs = list(flatten(counters))
+  total = sum(count for _, _, count in pairs) or 1
+  for source, destination, count in heapq.nlargest(
+      top_count, pairs, key=lambda pair: pair[2]):
+    print("{:>12d} {:>6.2f}%  {} -> {}".format(count, 100.0 * count / total,
+                                               source, destination))
+
+
+def print_successors(counters, source, top_count):
+  destinations = counters.get(source)
+  if destinations is None:
+    print("Unknown bytecode " + source, file=sys.stderr)
+    sys.exit(1)
+  total = sum(destinations.values()) or 1
+  for destination, count in heapq.nlargest(
+      top_count, destinations.items(), key=lambda item: item[1]):
+    print("{:>12d} {:>6.2f}%  {}".format(count, 100.0 * count / total,
+                                         destination))
+
+
+def parse_command_line():
+  parser = argparse.ArgumentParser(
+      description=__DESCRIPTION,
+      epilog=__HELP_EPILOGUE,
+      formatter_class=argparse.RawDescriptionHelpFormatter)
+  parser.add_argument(
+      "-n",
+      "--top-count",
+      metavar="N",
+      type=int,
+      default=10,
+      help="print the N most frequent entries (default: 10)")
+  parser.add_argument(
+      "-f",
+      "--from",
+      metavar="<bytecode>",
+      dest="source",
+      help="print the most frequent successors of <bytecode>")
+  parser.add_argument(
+      "input_filename",
+      metavar="<input filename>",
+      default="v8.ignition_dispatches_table.json",
+      nargs="?",
+      help="file containing the dispatch table")
+  return parser.parse_args()
+
+
+def main():
+  program_options = parse_command_line()
+  with open(program_options.input_filename) as stream:
+    counters = json.load(stream)
+  if program_options.source:
+    print_successors(counters, program_options.source,
+                     program_options.top_count)
+  else:
+    print_top_pairs(counters, program_options.top_count)
+
+
+if __name__ == "__main__":
+  main()